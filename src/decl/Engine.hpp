@@ -27,7 +27,8 @@ public:
 
     static Engine* Get();
 
-    void Initialize(int ThreadCount = -1, bool Headless = false);
+    // unset fields of `Threads` are read from the configuration
+    void Initialize(ThreadManager::PoolConfiguration Threads, bool Headless = false);
 
     // Initializes main engine loop
     void Start();
@@ -109,9 +110,11 @@ public:
 
 private:
     void m_InitializeVideo();
-    void m_Render(double DeltaTime, const std::vector<EcParticleEmitter*>&);
+    void m_Render(double DeltaTime, const glm::mat4& CameraTransform, const std::vector<EcParticleEmitter*>&);
 
     ObjectRef m_Workspace;
+    // kept around so its storage is re-used between frames
+    Scene m_ShadowScene;
 
     int m_DrawnFramesInSecond = -1;
     bool m_IsRunning = false;
@@ -7,6 +7,7 @@
 #include <unordered_map>
 #include <unordered_set>
 #include <cassert>
+#include <cstddef>
 #include <cstdint>
 #include <string>
 #include <vector>
@@ -43,13 +44,25 @@ namespace Memory
 	void* ReAlloc(void*, uint32_t Size, Category MemCat = Category::Default);
 	// can only safely de-alloc pointers returned by `::Alloc`
 	void Free(void*);
-	// returns the pointer to the actual `malloc` block
+	// returns the pointer to the actual `malloc` block, or the pointer itself if
+	// it came from one of the small-allocation pools
 	void* GetPointerInfo(void*, uint32_t* Size = nullptr, uint8_t* Category = nullptr);
 
+	// bump-allocates from the frame arena. The memory is only valid until the end of the
+	// current frame (`::FrameFinish`), and must never be passed to `::Free`. Thread-safe, but
+	// must not be used for anything which can outlive the frame (e.g. async asset loads)
+	void* FrameAlloc(size_t Size, Category MemCat = Category::Default);
+
+	// also resets the frame arena
 	void FrameFinish();
 
+	// both are as of the last `::FrameFinish`
 	inline std::array<std::atomic_size_t, static_cast<size_t>(Category::count)> Counters;
 	inline std::array<std::atomic_size_t, static_cast<size_t>(Category::count)> Activity;
+	// bytes handed out by the frame arena during the last frame
+	inline std::array<std::atomic_size_t, static_cast<size_t>(Category::count)> FrameActivity;
+	// size of the memory backing the frame arena
+	inline std::atomic_size_t FrameArenaCapacity = 0;
 
 	static inline const char* CategoryNames[] = {
 		"Default",
@@ -106,3 +119,49 @@ bool operator !=(const Memory::Allocator<T, C>&, const Memory::Allocator<U, C>&)
 {
 	return false;
 }
+
+namespace Memory
+{
+	// stl-conforming allocator over the frame arena, de-allocation is a no-op
+	// as everything is released at once by `::FrameFinish`
+	template <class T, Category C = Category::Default>
+	struct FrameAllocator
+	{
+		using value_type = T;
+
+		static_assert(alignof(T) <= alignof(std::max_align_t));
+
+		FrameAllocator() noexcept = default;
+
+		template <class U>
+		FrameAllocator(const FrameAllocator<U, C>&) noexcept
+		{
+		}
+
+		T* allocate(size_t n)
+		{
+			return (T*)FrameAlloc(sizeof(T) * n, C);
+		}
+		void deallocate(T*, size_t)
+		{
+		}
+
+		template <class U>
+		struct rebind
+		{
+			using other = FrameAllocator<U, C>;
+		};
+	};
+};
+
+template <class T, class U, Memory::Category C>
+bool operator ==(const Memory::FrameAllocator<T, C>&, const Memory::FrameAllocator<U, C>&) noexcept
+{
+	return true;
+}
+
+template <class T, class U, Memory::Category C>
+bool operator !=(const Memory::FrameAllocator<T, C>&, const Memory::FrameAllocator<U, C>&) noexcept
+{
+	return false;
+}
@@ -224,6 +224,8 @@ namespace Reflection
         // Throws errors if the type does not match
         std::string AsString() const;
         std::string_view AsStringView() const;
+        // the bytes of a `Buffer`, which are stored the same way as a string's
+        std::string_view AsBufferView() const;
         bool AsBoolean() const;
         double AsDouble() const;
         int64_t AsInteger() const;
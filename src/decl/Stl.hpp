@@ -1,7 +1,10 @@
+#pragma once
+
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
 #include <string>
+#include <new>
 
 #include "Memory.hpp"
 
@@ -19,6 +22,108 @@ namespace hx
     using vector = std::vector<T>;
 #endif
 
+    // only valid until the end of the frame it was created in, see `Memory::FrameAlloc`
+#if !defined(_MSC_VER) || defined(NDEBUG)
+    template <class T, Memory::Category C>
+    using frame_vector = std::vector<T, Memory::FrameAllocator<T, C>>;
+#else
+    // MSVC debug iterators hang a heap-allocated proxy off of the container,
+    // which would dangle after the arena is reset
+    template <class T, Memory::Category>
+    using frame_vector = std::vector<T>;
+#endif
+
+    // Stores elements in fixed-size pages which are never moved, so pointers to elements stay
+    // valid as it grows. Indexing is a shift and a mask into the page table. Only grows,
+    // elements are re-used by the owner rather than removed
+    template <class T, Memory::Category C, size_t PageSize = 1024>
+    class stable_vector
+    {
+        static_assert((PageSize & (PageSize - 1)) == 0, "`PageSize` must be a power of 2");
+
+    public:
+        template <class V, class E>
+        class basic_iterator
+        {
+        public:
+            basic_iterator(V* Vector, size_t Index)
+                : m_Vector(Vector), m_Index(Index)
+            {
+            }
+
+            E& operator * () const { return (*m_Vector)[m_Index]; }
+            E* operator -> () const { return &(*m_Vector)[m_Index]; }
+            basic_iterator& operator ++ () { m_Index++; return *this; }
+            bool operator == (const basic_iterator& Other) const { return m_Index == Other.m_Index; }
+            bool operator != (const basic_iterator& Other) const { return m_Index != Other.m_Index; }
+
+        private:
+            V* m_Vector;
+            size_t m_Index;
+        };
+
+        using iterator = basic_iterator<stable_vector, T>;
+        using const_iterator = basic_iterator<const stable_vector, const T>;
+
+        stable_vector() = default;
+        stable_vector(const stable_vector&) = delete;
+        stable_vector& operator = (const stable_vector&) = delete;
+
+        ~stable_vector()
+        {
+            clear();
+        }
+
+        T& operator [] (size_t Index)
+        {
+            assert(Index < m_Size);
+            return m_Pages[Index / PageSize][Index % PageSize];
+        }
+
+        const T& operator [] (size_t Index) const
+        {
+            assert(Index < m_Size);
+            return m_Pages[Index / PageSize][Index % PageSize];
+        }
+
+        size_t size() const
+        {
+            return m_Size;
+        }
+
+        T& emplace_back()
+        {
+            if (m_Size == m_Pages.size() * PageSize)
+                m_Pages.push_back((T*)Memory::Alloc(static_cast<uint32_t>(sizeof(T) * PageSize), C));
+
+            T* element = new (&m_Pages[m_Size / PageSize][m_Size % PageSize]) T();
+            m_Size++;
+
+            return *element;
+        }
+
+        void clear()
+        {
+            for (size_t i = 0; i < m_Size; i++)
+                (*this)[i].~T();
+
+            for (T* page : m_Pages)
+                Memory::Free(page);
+
+            m_Pages.clear();
+            m_Size = 0;
+        }
+
+        iterator begin() { return iterator(this, 0); }
+        iterator end() { return iterator(this, m_Size); }
+        const_iterator begin() const { return const_iterator(this, 0); }
+        const_iterator end() const { return const_iterator(this, m_Size); }
+
+    private:
+        vector<T*, C> m_Pages;
+        size_t m_Size = 0;
+    };
+
     template <class K, class V, Memory::Category C>
     using unordered_map = std::unordered_map<K, V, std::hash<K>, std::equal_to<K>, std::allocator<std::pair<const K, V>>>;
 
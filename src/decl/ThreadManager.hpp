@@ -4,17 +4,64 @@
 #include <functional>
 #include <string>
 #include <thread>
+#include <atomic>
+#include <memory>
+#include <optional>
 #include <queue>
+#include <deque>
 #include <mutex>
 
 class ThreadManager
 {
+private:
+	struct Task;
+	struct WorkerState;
+
 public:
+	enum class TaskPriority : uint8_t
+	{
+		High,
+		Normal,
+		Low,
+
+		count
+	};
+
+	// A set of tasks which can be waited on together, and which other tasks
+	// can be made to run after. Must outlive every task dispatched into it
+	class TaskGroup
+	{
+	public:
+		~TaskGroup();
+
+		bool IsDone() const;
+
+	private:
+		friend class ThreadManager;
+
+		std::atomic<uint32_t> m_Pending = 0;
+		// also guards the final decrement of `m_Pending`, so that
+		// the group can be destroyed as soon as `::Wait` returns
+		std::mutex m_ContinuationsMutex;
+		std::vector<Task*> m_Continuations;
+	};
+
+	struct PoolConfiguration
+	{
+		// -1 picks a count based on the CPU topology
+		int ComputeThreads = -1;
+		int IoThreads = -1;
+		// pin each compute worker to its own physical core
+		std::optional<bool> PinComputeThreads;
+	};
+
+	// both out-of-line, `WorkerState` is only complete in the implementation
+	ThreadManager();
 	void Shutdown();
 	// USE SHUTDOWN!!
 	~ThreadManager();
 
-	void Initialize(int NumThreads = -1);
+	void Initialize(const PoolConfiguration& Configuration);
 
 	// queue a task
 	// "Critical" means "we can't skip this if we're shutting down"
@@ -23,27 +70,86 @@ public:
 	// window waits on everything to finish so that the app does not
 	// appear like a suspicious background process if it gets frozen
 	// somewhere in teardown
-	void Dispatch(const std::string_view& Name, std::function<void()>, bool IsCritical);
+	// Tasks dispatched from a worker go onto that worker's own deque (and can
+	// be stolen by idle workers), `Priority` only orders tasks submitted from
+	// outside the pool. If `After` is given, the task is held back until every
+	// task in `After` has finished
+	void Dispatch(
+		const std::string_view& Name,
+		std::function<void()>,
+		bool IsCritical,
+		TaskPriority Priority = TaskPriority::Normal,
+		TaskGroup* Group = nullptr,
+		TaskGroup* After = nullptr
+	);
+
+	// queue a task onto the I/O pool, for work which spends most of its time blocked
+	// (file reads, network requests) and would otherwise hold up compute workers
+	void DispatchIo(const std::string_view& Name, std::function<void()>, bool IsCritical);
+
+	// blocks until every task in the group has finished, running tasks of the
+	// group on the calling thread in the meantime instead of sleeping
+	void Wait(TaskGroup&);
+
+	// splits [Begin, End) into chunks of at most `Grain` and runs `Body(ChunkBegin, ChunkEnd)`
+	// over them in parallel, returns once all chunks are done. The calling thread runs
+	// the first chunk itself
+	void ParallelFor(
+		const std::string_view& Name,
+		size_t Begin,
+		size_t End,
+		size_t Grain,
+		const std::function<void(size_t, size_t)>& Body,
+		TaskPriority Priority = TaskPriority::High
+	);
 
 	static ThreadManager* Get();
 
+	// number of compute workers
 	int Concurrency = 1;
+	int IoConcurrency = 1;
 
 private:
 	struct Task
 	{
 		std::function<void()> Function;
 		std::string_view Name;
+		TaskGroup* Group = nullptr;
+		TaskPriority Priority = TaskPriority::Normal;
 		bool IsCritical = true;
 	};
 
+	void m_WorkerMain(size_t WorkerIndex, std::optional<uint32_t> PinToCpu);
+	void m_IoWorkerMain(size_t WorkerIndex);
+	void m_Submit(Task*);
+	void m_RunTask(Task*);
+	void m_CompleteOne(TaskGroup&);
+	Task* m_FindTask(size_t WorkerIndex);
+	Task* m_FindGroupTask(TaskGroup&);
+	void m_WakeWorkers(bool All);
+
 	void m_StopThreads();
 
 	std::vector<std::jthread> m_Workers;
+	std::vector<std::unique_ptr<WorkerState>> m_WorkerStates;
+	// not modified once the workers have started, Tracy holds onto the pointers
+	std::vector<std::string> m_WorkerNames;
+	std::vector<std::string> m_IoWorkerNames;
+
+	// tasks submitted from outside the pool, one queue per priority
+	std::deque<Task*> m_Injected[(size_t)TaskPriority::count];
+	std::mutex m_InjectedMutex;
+	std::atomic<uint32_t> m_InjectedCount = 0;
+
+	// bumped every time work is submitted, idle workers wait on it
+	std::atomic<uint32_t> m_WorkEpoch = 0;
+	std::atomic<uint32_t> m_NumSleeping = 0;
 
-	std::queue<Task> m_Tasks;
-	std::mutex m_TasksMutex;
-	std::condition_variable m_TasksCv;
+	std::atomic<bool> m_Stop = false;
 
-	bool m_Stop = false;
+	std::vector<std::jthread> m_IoWorkers;
+	std::queue<Task*> m_IoTasks;
+	std::mutex m_IoTasksMutex;
+	std::condition_variable m_IoTasksCv;
+	bool m_IoStop = false;
 };
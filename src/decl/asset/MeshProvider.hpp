@@ -5,8 +5,11 @@
 
 #include <functional>
 #include <future>
+#include <memory>
+#include <mutex>
 
 #include "asset/Mesh.hpp"
+#include "geometry/TriangleBvh.hpp"
 #include "render/GpuBuffers.hpp"
 
 class MeshProvider
@@ -58,6 +61,13 @@ public:
 
 	Mesh& GetMeshResource(uint32_t);
 	GpuMesh& GetGpuMesh(uint32_t);
+	// built the first time it's asked for, and kept until the mesh is replaced, though whoever
+	// still holds it keeps it alive. `nullptr` if the mesh has no triangles (yet). Unlike
+	// everything else here, safe to call from any thread
+	std::shared_ptr<const TriangleBvh> GetTriangleBvh(uint32_t);
+	// calls `Reader` with the mesh while it can't be replaced, so that it's safe from any thread.
+	// `Reader` must not call back into the `MeshProvider`
+	void ReadMesh(uint32_t, const std::function<void(const Mesh&)>& Reader);
 
 	void UnloadMesh(const std::string&);
 
@@ -70,6 +80,22 @@ private:
 	std::vector<Mesh> m_Meshes;
 	std::unordered_map<std::string, uint32_t> m_StringToMeshId;
 
+	struct TriangleBvhSlot
+	{
+		std::once_flag Built;
+		// a copy of the mesh's triangles from when the slot was made, until they're built into `Bvh`
+		Mesh Triangles;
+		std::shared_ptr<const TriangleBvh> Bvh;
+	};
+
+	// `::GetTriangleBvh`, by mesh ID. Slots are shared so that whoever's building or waiting on
+	// one can carry on if the mesh is replaced meanwhile
+	std::unordered_map<uint32_t, std::shared_ptr<TriangleBvhSlot>> m_TriangleBvhs;
+	// held by `::GetTriangleBvh` and `::ReadMesh` off the main thread, and by the main thread
+	// whenever `m_Meshes` grows, a mesh's data is replaced, or `m_TriangleBvhs` changes. Never
+	// while a BVH is being built
+	std::mutex m_MeshesMutex;
+
 	struct MeshLoadRequest
 	{
 		std::promise<Mesh>* Promise;
@@ -10,7 +10,8 @@
 class ModelLoader
 {
 public:
-	ModelLoader(const std::string& AssetPath, uint32_t Parent);
+	// `GenerateHulls` decomposes each mesh into convex hulls for its `RigidBody`'s `Hulls` collision
+	ModelLoader(const std::string& AssetPath, uint32_t Parent, bool GenerateHulls = false);
 	ObjectHandle Model;
 
 private:
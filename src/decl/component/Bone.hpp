@@ -4,12 +4,16 @@
 
 #include "datatype/ComponentBase.hpp"
 
+struct EcMesh;
+
 struct EcBone : public Component<EntityComponent::Bone>
 {
 	void SetTransform(const glm::mat4&);
+	// `nullptr` if the Mesh component was deleted, even if another one has its slot now
+	EcMesh* GetTargetMesh();
 
 	glm::mat4 Transform = glm::mat4(1.f);
-	uint32_t TargetMesh = UINT32_MAX;
+	ReflectorRef TargetMesh;
 	uint8_t SkeletalBoneId = UINT8_MAX;
 
 	bool Valid = true;
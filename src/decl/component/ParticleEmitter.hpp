@@ -40,6 +40,8 @@ struct EcParticleEmitter : public Component<EntityComponent::ParticleEmitter>
 	std::vector<Particle> m_Particles;
 
 	double m_TimeSinceLastSpawn = 0.0;
+	// taken in `::Update`, `::Render` may run while a physics tick is moving the Object
+	glm::mat4 m_Transform = glm::mat4(1.f);
 	bool Emitting = true;
 	bool ParticlesAreAttached = false;
 	bool LinearlySmoothened = true;
@@ -2,12 +2,15 @@
 #pragma once
 
 #include "geometry/Physics.hpp"
+#include "component/Workspace.hpp"
 #include "datatype/ComponentBase.hpp"
 
 struct EcPhysicsService : Component<EntityComponent::PhysicsService>
 {
     glm::vec3 Gravity = { 0.f, -50.f, 0.f };
     double Timescale = 1.0;
+    double FixedTickRate = 0.0;
+    EnBroadphase Broadphase = EnBroadphase::Grid;
 
     bool Simulating = true;
     bool DebugCollisionAabbs = false;
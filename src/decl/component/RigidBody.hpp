@@ -1,20 +1,36 @@
 // RigidBody.hpp, 22/01/2026
 #pragma once
 
+#include <memory>
+
 #include "component/Transform.hpp"
+#include "geometry/ConvexHull.hpp"
 
 enum class EnCollisionType : uint8_t
 {
     Cube,          // Cube
     Sphere,        // Sphere
     Hulls,         // Hulls file
-    MeshComponent  // Use the mesh from the attached `Mesh` component directly (usually a bad idea)
+    MeshComponent, // Use the mesh from the attached `Mesh` component directly (usually a bad idea)
+    MeshTriangles  // The exact triangles of the `Mesh` component's mesh, for static concave colliders
 };
 
+class TriangleBvh;
+
 struct EcRigidBody : public Component<EntityComponent::RigidBody>
 {
     void RecomputeAabb();
+    // `::RecomputeAabb` for many bodies at once, through the batched kernel
+    static void s_RecomputeAabbs(EcRigidBody* const* Bodies, size_t Count);
     void SetHullsFile(const std::string&);
+    // the hull of the `Mesh` component's mesh, for `EnCollisionType::MeshComponent`,
+    // rebuilt if the mesh has changed. Not thread-safe
+    const ConvexHull& GetMeshComponentHull();
+    // the triangles of the `Mesh` component's mesh, for `EnCollisionType::MeshTriangles`.
+    // `nullptr` while the mesh hasn't loaded. Thread-safe
+    std::shared_ptr<const TriangleBvh> GetMeshTriangles() const;
+    // anything which changes how it moves from outside of the simulation should call this
+    void Wake();
 
     glm::vec3 LinearVelocity = {};
     glm::vec3 AngularVelocity = {};
@@ -25,6 +41,14 @@ struct EcRigidBody : public Component<EntityComponent::RigidBody>
 	float Friction = 50.f;
     float Restitution = 0.2f;
     float GravityFactor = 1.f;
+    // it can fall asleep once it's been slower than both of these for a while
+    float LinearSleepThreshold = 0.5f;
+    float AngularSleepThreshold = 0.2f;
+    // seconds it's been below the sleep thresholds for
+    float SleepTimer = 0.f;
+    // how much of the current step's motion is still to be integrated, less than 1 once
+    // a `Continuous` sweep has moved it up to what it hit
+    float RemainingStep = 1.f;
 
     struct
 	{
@@ -32,30 +56,52 @@ struct EcRigidBody : public Component<EntityComponent::RigidBody>
 		glm::vec3 Size = { 1.f, 1.f, 1.f };
 	} CollisionAabb;
 
-    std::vector<glm::vec3> SpatialHashPoints;
+    // `BroadphaseProxy` while it isn't in one, the same for both kinds
+    static constexpr uint32_t NullBroadphaseProxy = UINT32_MAX;
+    // in the broadphase of `PrevWorkspace`, a `SpatialGrid` or `AabbTree` proxy
+    uint32_t BroadphaseProxy = NullBroadphaseProxy;
 	ObjectRef PrevWorkspace;
-    EcTransform* CurTransform; // Only used during the Physics phase
 
     std::string HullsFile;
     struct Hull
     {
         glm::mat4 Transform = glm::mat4(1.f);
         uint32_t MeshId = UINT32_MAX;
+        // built from `MeshId` when the hull is loaded
+        ConvexHull Convex;
     };
     std::vector<Hull> Hulls;
+    // `::GetMeshComponentHull`
+    Hull MeshComponentHull;
+
+    std::vector<Reflection::EventConnection> OnCollisionBeganCallbacks;
+    std::vector<Reflection::EventConnection> OnCollisionEndedCallbacks;
 
     EnCollisionType CollisionType = EnCollisionType::Cube;
+    // 0 to 31, queries such as `EcWorkspace::Shapecast` can be told to only look at some groups
+    uint8_t CollisionGroup = 0;
 
     bool PhysicsDynamics = false;
 	bool PhysicsCollisions = true;
     bool PhysicsRotations = false;
+    // swept through its motion when it's moving fast, so it doesn't tunnel through thin things
+    bool Continuous = false;
+    // skipped by the simulation until something touches it, or `::Wake` is called
+    bool Sleeping = false;
 
     bool Valid = true;
+
+private:
+    // size limit, spatial hash and mass, once `CollisionAabb` has been updated. Wakes any
+    // sleeping bodies around where it was and is if it was moved from outside of the simulation
+    void m_CommitAabb(const glm::vec3& PrevPosition, const glm::vec3& PrevSize);
 };
 
 class RigidBodyComponentManager : public ComponentManager<EcRigidBody>
 {
 public:
 	uint32_t CreateComponent(GameObject* Object) override;
+    void DeleteComponent(uint32_t) override;
     const Reflection::StaticPropertyMap& GetProperties() override;
+    const Reflection::StaticEventMap& GetEvents() override;
 };
@@ -11,8 +11,15 @@ struct EcTransform : public Component<EntityComponent::Transform>
     void SetLocalTransform(const glm::mat4&);
     void SetLocalSize(const glm::vec3&);
 
+    // Updates our world transform from our parent's right away, but only marks the ones
+    // below us as needing to catch up, which happens in `::s_FlushDirty`
     void RecomputeTransformTree();
 
+    // Brings the world transforms (and Rigid Body AABBs) below everything which moved since the
+    // last flush up-to-date. Independent subtrees are done in parallel. Once per frame and
+    // physics step, and whenever a stale world transform is about to be read
+    static void s_FlushDirty();
+
     // world-space
     glm::mat4 Transform = { 1.f };
 
@@ -20,6 +27,8 @@ struct EcTransform : public Component<EntityComponent::Transform>
     glm::mat4 LocalTransform = { 1.f };
 
     std::vector<Reflection::EventConnection> OnScriptMovedCallbacks;
+    // our own `Transform` is right, but our descendants' need propagating
+    bool DescendantsDirty = false;
     bool Valid = true;
 };
 
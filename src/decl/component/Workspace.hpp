@@ -1,47 +1,35 @@
 #pragma once
 
 #include <glm/vec3.hpp>
+#include <span>
 
 #include "datatype/ComponentBase.hpp"
 #include "datatype/GameObject.hpp"
+#include "geometry/SpatialGrid.hpp"
+#include "geometry/AabbTree.hpp"
 
-#define SPATIAL_HASH_GRID_SIZE 32.f
+namespace Gjk
+{
+	struct Shape;
+}
+
+// which structure a Workspace keeps its bodies in, see `Physics.Broadphase`
+enum class EnBroadphase : uint8_t
+{
+	Grid, // `SpatialGrid`
+	Tree  // `AabbTree`
+};
 
 struct SpatialCastResult
 {
 	GameObject* Object = nullptr;
 	glm::vec3 Position;
 	glm::vec3 Normal;
+	// how far along the cast it happened, from 0 to 1
+	float Time = 0.f;
 	bool Occurred = false;
 };
 
-namespace std
-{
-	template <>
-	struct hash<glm::vec3>
-	{
-		size_t operator()(const glm::vec3& v) const noexcept
-		{
-			return 0ull
-				^ std::hash<float>()(v.x)
-				^ std::hash<float>()(v.y)
-				^ std::hash<float>()(v.z);
-		}
-	};
-
-	template <>
-	struct hash<glm::ivec3>
-	{
-		size_t operator()(const glm::ivec3& v) const noexcept
-		{
-			return 0
-				^ std::hash<int>()(v.x)
-				^ std::hash<int>()(v.y)
-				^ std::hash<int>()(v.z);
-		}
-	};
-};
-
 struct EcWorkspace : public Component<EntityComponent::Workspace>
 {
 	void UpdateSoundListener() const;
@@ -52,9 +40,55 @@ struct EcWorkspace : public Component<EntityComponent::Workspace>
 	glm::vec3 ScreenPointToVector(glm::vec2 ScreenPosition, float Length) const;
 
 	SpatialCastResult Raycast(const glm::vec3& Origin, const glm::vec3& Vector, const std::vector<GameObject*>& FilterList, bool FilterIsIgnoreList = true) const;
+	// `::Raycast` for each ray, `Results[i]` being the same as `Raycast(Origins[i], Vectors[i], ...)`.
+	// Transforms are only flushed once, and with the Tree broadphase, rays are traced through it
+	// in packets of `SimdMath::RayPacket::Width`. `Parallel` splits the rays across the workers
+	void RaycastBatch(
+		std::span<const glm::vec3> Origins,
+		std::span<const glm::vec3> Vectors,
+		std::span<SpatialCastResult> Results,
+		const std::vector<GameObject*>& FilterList,
+		bool FilterIsIgnoreList = true,
+		bool Parallel = false
+	) const;
 	std::vector<GameObject*> GetObjectsInAabb(const glm::vec3& Position, const glm::vec3& Size, const std::vector<GameObject*>& IgnoreList) const;
 
-	std::unordered_map<glm::ivec3, std::vector<uint32_t>> SpatialHash;
+	// `Shape` swept along `Vector`, against the collision shapes of the bodies whose `CollisionGroup` bit is
+	// set in `CollisionGroups`. Bodies the shape starts off overlapping are ignored, `::Overlap` finds those
+	SpatialCastResult Shapecast(
+		const Gjk::Shape& Shape,
+		const glm::vec3& Vector,
+		const std::vector<GameObject*>& FilterList,
+		bool FilterIsIgnoreList = true,
+		uint32_t CollisionGroups = UINT32_MAX
+	) const;
+	// bodies whose collision shapes overlap `Shape`, in order of ObjectId
+	std::vector<GameObject*> Overlap(
+		const Gjk::Shape& Shape,
+		const std::vector<GameObject*>& FilterList,
+		bool FilterIsIgnoreList = true,
+		uint32_t CollisionGroups = UINT32_MAX
+	) const;
+
+	// moves every body over to the given structure
+	void SetBroadphase(EnBroadphase);
+
+	// `Visit(ObjectId)` for each body whose bounds may overlap the box, return `true` to stop.
+	// The grid can visit a body more than once
+	template <class F>
+	bool VisitBroadphase(const glm::vec3& Min, const glm::vec3& Max, F&& Visit) const
+	{
+		if (Broadphase == EnBroadphase::Tree)
+			return Tree.QueryAabb(Min, Max, Visit);
+
+		return Grid.VisitBox(SpatialGrid::CellOf(Min), SpatialGrid::CellOf(Max), Visit);
+	}
+
+	// Physics broadphase, holds every `RigidBody` with `PhysicsCollisions` in the Workspace.
+	// Only the one chosen by `Broadphase` is used
+	SpatialGrid Grid;
+	AabbTree Tree;
+	EnBroadphase Broadphase = EnBroadphase::Grid;
 
 	uint32_t m_SceneCameraId = PHX_GAMEOBJECT_NULL_ID;
 	bool Valid = true;
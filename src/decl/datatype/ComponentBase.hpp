@@ -19,6 +19,10 @@ public:
     virtual void BindService(uint32_t) = 0;
     virtual void UnbindService() = 0;
     virtual void Shutdown() = 0;
+    // give back memory from deleted components where possible, without moving live ones
+    virtual void Compact() = 0;
+    // slots in the array, live or free, for checking that freed ones get reused
+    virtual size_t GetNumSlots() = 0;
     virtual ~IComponentManager(); // just default, but moved to a .cpp file to anchor vtable
 
     virtual const Reflection::StaticPropertyMap& GetProperties() = 0;
@@ -71,37 +75,49 @@ class ComponentManager : public IComponentManager
 public:
     static ComponentManager* Get()
     {
-        return (ComponentManager*)GetComponentManagerByComponentType(T::Type);
+        assert(s_Instance);
+        return s_Instance;
     }
 
     virtual uint32_t CreateComponent(GameObject* Object) override
     {
-        uint32_t id = UINT32_MAX; //NextFreeId;
+        uint32_t id = NextFreeId;
         ObjectRef ref = Object;
 
         if (id == UINT32_MAX)
         {
             id = static_cast<uint32_t>(Components.size());
-
-            T& component = Components.emplace_back();
-            component.Object = ref;
-            component.Valid = true;
-            assert(component.Valid);
+            Components.emplace_back();
         }
         else
         {
             T& component = Components[id];
+            assert(!component.Valid);
+
             NextFreeId = component.NextFreeId;
             component = T();
         }
 
+        T& component = Components[id];
+        component.Object = ref;
+        component.Valid = true;
+
+        // never 0, that's what `ReflectorRef`s which don't care about it use
+        if (++LastGeneration == 0)
+            LastGeneration = 1;
+        component.Generation = LastGeneration;
+
         Reflection::SignalRestrictedEvent(ref.TargetId, ComponentCreatedCallbacks, { Reflection::GenericValue(ref) }, "ComponentCreatedSignal");
         return id;
     }
 
     virtual BaseComponent* GetComponent(uint32_t Id) override
     {
-        T& component = Components.at(Id);
+        // may have been trimmed by `::Compact`
+        if (Id >= Components.size())
+            return nullptr;
+
+        T& component = Components[Id];
         return component.Valid ? (BaseComponent*)&component : nullptr;
     }
 
@@ -150,6 +166,40 @@ public:
     virtual void Shutdown() override
     {
         Components.clear();
+        NextFreeId = UINT32_MAX;
+    }
+
+    // Trims deleted components off the end of `Components` and rebuilds the free list
+    // lowest-ID-first, so new components fill the earliest holes and the live ones
+    // stay packed towards the front. Components are never moved, as their IDs are held
+    // onto by `GameObject`s and scripts, and pointers to them by the engine. The capacity
+    // is kept for the same reason, shrinking it would reallocate the live ones
+    virtual void Compact() override
+    {
+        size_t liveEnd = Components.size();
+
+        while (liveEnd > 0 && !Components[liveEnd - 1].Valid)
+            liveEnd--;
+
+        Components.erase(Components.begin() + liveEnd, Components.end());
+
+        NextFreeId = UINT32_MAX;
+
+        for (size_t i = liveEnd; i > 0; i--)
+        {
+            T& component = Components[i - 1];
+
+            if (!component.Valid)
+            {
+                component.NextFreeId = NextFreeId;
+                NextFreeId = static_cast<uint32_t>(i - 1);
+            }
+        }
+    }
+
+    virtual size_t GetNumSlots() override
+    {
+        return Components.size();
     }
 
     virtual const Reflection::StaticPropertyMap& GetProperties() override
@@ -184,20 +234,28 @@ public:
     ComponentManager()
     {
         RegisterComponentManager(T::Type, this);
+        s_Instance = this;
     }
 
+    // typed, so `GameObject::FindComponent<T>` can index `Components` directly
+    static inline ComponentManager* s_Instance = nullptr;
+
     std::vector<T> Components;
     uint32_t NextFreeId = UINT32_MAX;
+    // handed out to components as they're created, so a `ReflectorRef` to
+    // a deleted component can't be mistaken for whatever re-uses its slot
+    uint32_t LastGeneration = 0;
 };
 
 struct BaseComponent
 {
     ObjectRef Object;
     uint32_t NextFreeId = UINT32_MAX;
+    uint32_t Generation = 0;
 };
 
 template <EntityComponent T>
 struct Component : BaseComponent
 {
-    static inline EntityComponent Type = T;
+    static constexpr EntityComponent Type = T;
 };
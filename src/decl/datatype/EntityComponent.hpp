@@ -106,10 +106,13 @@ struct ReflectorRef
 
 	uint32_t Id = UINT32_MAX;
 	EntityComponent Type = EntityComponent::None;
+	// of the component, `::Referred` returns `nullptr` if it doesn't match the one
+	// currently in the slot. 0 skips the check
+	uint32_t Generation = 0;
 
 	bool operator == (const ReflectorRef& Other) const
 	{
-		return Type == Other.Type && Id == Other.Id;
+		return Type == Other.Type && Id == Other.Id && Generation == Other.Generation;
 	}
 
 	bool operator != (const ReflectorRef& Other) const
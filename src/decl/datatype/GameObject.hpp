@@ -8,6 +8,9 @@
 #include <string_view>
 #include <functional>
 #include <vector>
+#include <type_traits>
+#include <memory>
+#include <mutex>
 #include <nljson.hpp>
 
 #include "Reflection.hpp"
@@ -17,18 +20,33 @@
 #include "datatype/EntityComponent.hpp"
 #include "datatype/ComponentBase.hpp"
 
+static_assert(static_cast<size_t>(EntityComponent::count) <= 64, "`GameObject::ComponentMask` is 64 bits");
+
+// The combined API of a set of component types, shared by every object which has exactly
+// those components. Built once by `GameObjectManager::GetComponentApis`, and never changed after
+struct ComponentApiTable
+{
+	Reflection::Api Api;
+	// which component each member of `Api` comes from
+	std::unordered_map<std::string_view, EntityComponent> MemberToComponent;
+};
+
 class GameObject
 {
 public:
 	template <class T>
 	T* FindComponent() const
 	{
-		EntityComponent type = T::Type;
-		for (const ReflectorRef& ref : Components)
-			if (ref.Type == type)
-				return static_cast<T*>(GetComponentManagerByComponentType(type)->GetComponent(ref.Id));
+		constexpr size_t type = static_cast<size_t>(T::Type);
+
+		if ((ComponentMask & (1ull << type)) == 0)
+			return nullptr;
 
-		return nullptr;
+		return &ComponentManager<T>::s_Instance->Components[Components[ComponentSlots[type]].Id];
+	}
+	bool HasComponent(EntityComponent Type) const
+	{
+		return (ComponentMask & (1ull << static_cast<size_t>(Type))) != 0;
 	}
 	uint32_t AddComponent(EntityComponent Type);
 	void RemoveComponent(EntityComponent Type);
@@ -61,10 +79,36 @@ public:
 	// hard refs to it 24/12/2024
 	void Destroy();
 
-	// preferable to use this instead of `::GetChildren`/`::GetDescendants`
+	// what a `::VisitDescendants` visitor wants to happen next
+	enum class VisitResult : uint8_t
+	{
+		Continue,
+		// don't go into the children of the object that was just visited
+		SkipChildren,
+		// end the walk entirely
+		Stop
+	};
+
+	// Calls `Visitor(GameObject&)` for everything below this object, parents before children
+	// (depth-first, pre-order). No recursion, and the explicit stack is shared by every walk on
+	// the thread, so nothing gets allocated once it has warmed up. The visitor may return a
+	// `VisitResult`, or nothing to always continue. Objects re-parented by the visitor before
+	// being reached are skipped, as with `::ForEachChild`. Returns `true` if it was stopped
+	template <class F>
+	bool VisitDescendants(F&& Visitor)
+	{
+		return m_Visit<false>(Visitor);
+	}
+	// same as `::VisitDescendants`, but visits all children before any grandchildren
+	template <class F>
+	bool VisitDescendantsBreadthFirst(F&& Visitor)
+	{
+		return m_Visit<true>(Visitor);
+	}
+
+	// preferable to use this instead of `::GetChildren`
 	// because it does not require any memory allocations
 	void ForEachChild(const std::function<bool(const ObjectHandle&)>&);
-	bool ForEachDescendant(const std::function<bool(const ObjectHandle&)>&);
 	std::vector<ObjectHandle> GetChildren() const;
 	std::vector<ObjectHandle> GetDescendants() const;
 
@@ -91,23 +135,36 @@ public:
 	static Reflection::GenericValue s_ToGenericValue(GameObject*);
 	Reflection::GenericValue ToGenericValue();
 
-	std::string Name = "GameObject";
+	// rarely touched, so it's kept out of the object until something needs it
+	struct ColdData
+	{
+		std::vector<uint16_t> Tags;
+		std::vector<Reflection::EventConnection> OnTagAddedCallbacks;
+		std::vector<Reflection::EventConnection> OnTagRemovedCallbacks;
+		std::vector<Reflection::EventConnection> OnTreeEnabledChangedCallbacks;
+		std::vector<Reflection::EventConnection> OnWorkspaceChangedCallbacks;
+
+		// counted under `Memory::Category::GameObject`
+		static void* operator new(size_t);
+		static void operator delete(void*);
+	};
 
+	// allocates it if we don't have it yet
+	ColdData& GetColdData();
+	// `nullptr` if nothing has needed it yet
+	ColdData* FindColdData() const
+	{
+		return m_ColdData.get();
+	}
+	const std::vector<uint16_t>& GetTags() const;
+
+	// Hot, what tree walks and queries look at. Keep these together at the front
 	uint32_t ObjectId = PHX_GAMEOBJECT_NULL_ID;
 	uint32_t Parent = PHX_GAMEOBJECT_NULL_ID;
 	uint32_t OwningDataModel = PHX_GAMEOBJECT_NULL_ID;
 	uint32_t OwningWorkspace = PHX_GAMEOBJECT_NULL_ID;
-	uint32_t NextFreeId = UINT32_MAX;
-
-	std::vector<uint32_t> Children;
-	std::vector<ReflectorRef> Components;
-	Reflection::Api ComponentApis;
-	std::unordered_map<std::string_view, ReflectorRef> MemberToComponentMap;
-	std::vector<uint16_t> Tags;
-	std::vector<Reflection::EventConnection> OnTagAddedCallbacks;
-	std::vector<Reflection::EventConnection> OnTagRemovedCallbacks;
-	std::vector<Reflection::EventConnection> OnTreeEnabledChangedCallbacks;
-	std::vector<Reflection::EventConnection> OnWorkspaceChangedCallbacks;
+	// bit `N` is set if there is a component of type `N`
+	uint64_t ComponentMask = 0;
 
 	uint16_t HardRefCount = 0;
 	// How much of HardRefCount is from Luau
@@ -118,11 +175,41 @@ public:
 	bool IsDestructionPending = false;
 	bool Valid = true;
 
+private:
+	bool m_Enabled = true;
+
+public:
+	std::vector<uint32_t> Children;
+	// in the order they were added
+	std::vector<ReflectorRef> Components;
+	// where in `Components` the component of each type in `ComponentMask` is
+	std::array<uint8_t, static_cast<size_t>(EntityComponent::count)> ComponentSlots{};
+	// shared with other objects that have the same components, `nullptr` if we have none
+	const ComponentApiTable* ComponentApis = nullptr;
+
+	// Cold
+	uint32_t NextFreeId = UINT32_MAX;
+	std::string Name = "GameObject";
+
 	static nlohmann::json DumpApiToJson();
 	static const Reflection::StaticApi s_Api;
 
 private:
-	bool m_Enabled = true;
+	struct VisitEntry
+	{
+		uint32_t Object;
+		uint32_t Parent;
+	};
+
+	template <bool BreadthFirst, class F>
+	bool m_Visit(F& Visitor);
+
+	// the stack (or queue) of objects yet to be visited, for every walk on the thread.
+	// Walks started from within a visitor work from the end of it, and put it back the
+	// way they found it before returning
+	static inline thread_local std::vector<VisitEntry> s_VisitScratch;
+
+	std::unique_ptr<ColdData> m_ColdData;
 };
 
 class GameObjectManager
@@ -148,7 +235,48 @@ public:
 	GameObject* FindById(uint32_t);
 	GameObject* FromGenericValue(const Reflection::GenericValue&);
 
-	hx::vector<GameObject, MEMCAT(GameObject)> WorldArray;
+	// the API table for objects with the components in `ComponentMask`, built on first use
+	const ComponentApiTable* GetComponentApis(uint64_t ComponentMask);
+
+	struct QueryFilter
+	{
+		// only objects in this Workspace, `PHX_GAMEOBJECT_NULL_ID` for any
+		uint32_t Workspace = PHX_GAMEOBJECT_NULL_ID;
+		// skip objects which are disabled, or have a disabled ancestor
+		bool EnabledOnly = true;
+	};
+
+	// Calls `Callback(GameObject&, First&, Rest&...)` for every object which has all of the
+	// given components, by walking the component array of `First` rather than the object tree.
+	// Put the rarest component first, as that decides how much gets visited. Components must
+	// not be created or deleted until the query returns
+	template <class First, class... Rest, class F>
+	void Query(const QueryFilter& Filter, F&& Callback)
+	{
+		std::vector<First>& components = ComponentManager<First>::Get()->Components;
+
+		for (size_t i = 0; i < components.size(); i++)
+			m_QueryVisit<First, Rest...>(components[i], Filter, Callback);
+	}
+
+	// Same as `::Query`, but the component array is split into chunks of `Grain` which are
+	// run in parallel on the thread pool. `Callback` must be safe to call concurrently for
+	// different objects
+	template <class First, class... Rest, class F>
+	void QueryParallel(const std::string_view& Name, const QueryFilter& Filter, size_t Grain, F&& Callback)
+	{
+		std::vector<First>& components = ComponentManager<First>::Get()->Components;
+
+		m_ParallelChunks(Name, components.size(), Grain, [&](size_t Begin, size_t End)
+		{
+			for (size_t i = Begin; i < End; i++)
+				m_QueryVisit<First, Rest...>(components[i], Filter, Callback);
+		});
+	}
+
+	// paged, so objects never move once created, and can be created from
+	// anywhere (including `::ForEachChild` callbacks) without invalidating pointers
+	hx::stable_vector<GameObject, MEMCAT(GameObject)> WorldArray;
 	std::array<IComponentManager*, (size_t)EntityComponent::count> ComponentManagers{};
 	uint32_t DataModel = PHX_GAMEOBJECT_NULL_ID;
 	uint32_t NextFreeId = UINT32_MAX;
@@ -176,4 +304,112 @@ public:
 
 	// Returns a reference to a Collection, creating one if it does not exist
 	Collection& GetCollection(const std::string&);
+
+private:
+	template <class First, class... Rest, class F>
+	void m_QueryVisit(First& Component, const QueryFilter& Filter, F& Callback)
+	{
+		constexpr uint64_t mask = ((1ull << static_cast<size_t>(Rest::Type)) | ... | 0ull);
+
+		if (!Component.Valid)
+			return;
+
+		// components are deleted along with their object, so this is always live
+		GameObject& object = WorldArray[Component.Object.TargetId];
+		assert(object.Valid);
+
+		if ((object.ComponentMask & mask) != mask)
+			return;
+		if (Filter.EnabledOnly && !object.TreeEnabled)
+			return;
+		if (Filter.Workspace != PHX_GAMEOBJECT_NULL_ID && object.OwningWorkspace != Filter.Workspace)
+			return;
+
+		Callback(object, Component, *object.FindComponent<Rest>()...);
+	}
+
+	// `ThreadManager::ParallelFor`, kept out of the header
+	void m_ParallelChunks(const std::string_view& Name, size_t Count, size_t Grain, const std::function<void(size_t, size_t)>& Body);
+
+	std::unordered_map<uint64_t, std::unique_ptr<ComponentApiTable>> m_ComponentApiTables;
+	std::mutex m_ComponentApiTablesMutex;
 };
+
+template <bool BreadthFirst, class F>
+bool GameObject::m_Visit(F& Visitor)
+{
+	std::vector<VisitEntry>& pending = s_VisitScratch;
+	const size_t base = pending.size();
+
+	// also if the visitor throws
+	struct RestoreScratch
+	{
+		std::vector<VisitEntry>& Scratch;
+		size_t Size;
+
+		~RestoreScratch()
+		{
+			Scratch.resize(Size);
+		}
+	} restore{ pending, base };
+
+	// breadth-first takes from the front of our region, depth-first from the back
+	size_t head = base;
+
+	const auto pushChildren = [&pending](const GameObject& Object)
+	{
+		// reversed for depth-first, so that the first child comes off of the stack first
+		if constexpr (BreadthFirst)
+		{
+			for (uint32_t child : Object.Children)
+				pending.push_back({ child, Object.ObjectId });
+		}
+		else
+		{
+			for (size_t i = Object.Children.size(); i > 0; i--)
+				pending.push_back({ Object.Children[i - 1], Object.ObjectId });
+		}
+	};
+
+	pushChildren(*this);
+
+	GameObjectManager* objectManager = GameObjectManager::Get();
+	bool stopped = false;
+
+	while (BreadthFirst ? head < pending.size() : pending.size() > base)
+	{
+		VisitEntry entry;
+
+		if constexpr (BreadthFirst)
+			entry = pending[head++];
+		else
+		{
+			entry = pending.back();
+			pending.pop_back();
+		}
+
+		// not `::FindById`, the visitor might have destroyed it
+		GameObject* object = &objectManager->WorldArray[entry.Object];
+
+		if (!object->Valid || object->Parent != entry.Parent)
+			continue; // visitor destroyed or re-parented it
+
+		VisitResult result = VisitResult::Continue;
+
+		if constexpr (std::is_void_v<std::invoke_result_t<F&, GameObject&>>)
+			Visitor(*object);
+		else
+			result = Visitor(*object);
+
+		if (result == VisitResult::Stop)
+		{
+			stopped = true;
+			break;
+		}
+
+		if (result != VisitResult::SkipChildren)
+			pushChildren(*object);
+	}
+
+	return stopped;
+}
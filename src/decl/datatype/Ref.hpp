@@ -6,8 +6,8 @@ class GameObject;
 
 // `GameObject*` directly has the least overhead. `ObjectRef`, a little more,
 // and `ObjectHandle`, more than that.
-// Use `GameObject*` when you know the World Array won't get re-allocated
-// for the scope of your variable.
+// Use `GameObject*` when you know the Object won't be destroyed for the scope
+// of your variable (the World Array never moves Objects, as of 17/10/2026).
 // Use `ObjectRef` when you know nothing will try to delete your Object.
 // Use `ObjectHandle` when you can't trust anybody.
 // 20/09/2025
@@ -0,0 +1,192 @@
+// AabbTree.hpp, 17/10/2026
+// Incrementally-updated bounding volume hierarchy, for broadphases where a uniform grid fits badly
+// (objects much larger than a cell, or many tiny objects packed into one)
+#pragma once
+
+#include <glm/vec3.hpp>
+#include <glm/common.hpp>
+#include <cassert>
+#include <cstdint>
+
+#include "geometry/SimdMath.hpp"
+#include "Stl.hpp"
+
+class AabbTree
+{
+public:
+    static constexpr uint32_t NullNode = UINT32_MAX;
+    // Leaves are stored this much bigger on every side than what they were given, so
+    // that a body which only moves a little doesn't have to be re-inserted
+    static constexpr float FatMargin = 2.f;
+
+    // returns the proxy, which is the index of its leaf
+    uint32_t CreateProxy(const glm::vec3& Min, const glm::vec3& Max, uint32_t ObjectId);
+    void DestroyProxy(uint32_t Proxy);
+    // whether `Proxy` still belongs to `ObjectId`, in case the tree was cleared since
+    bool OwnsProxy(uint32_t Proxy, uint32_t ObjectId) const;
+
+    // only re-inserts the leaf if the new bounds have left its fat AABB,
+    // returns whether that happened
+    bool MoveProxy(uint32_t Proxy, const glm::vec3& Min, const glm::vec3& Max);
+
+    // frees everything, invalidating all proxies
+    void Clear();
+
+    int GetHeight() const;
+
+    // `Visit(ObjectId)` for each leaf whose fat AABB overlaps the box, return `true` to stop.
+    // Returns whether it was stopped. The tree must not be modified during it
+    template <class F>
+    bool QueryAabb(const glm::vec3& Min, const glm::vec3& Max, F&& Visit) const
+    {
+        return m_Traverse(
+            [&Min, &Max](const Node& N)
+            {
+                return s_Overlaps(N.Min, N.Max, Min, Max);
+            },
+            Visit
+        );
+    }
+
+    // `Visit(ObjectId)` for each leaf whose fat AABB the segment `[Origin, Origin + Vector]` passes
+    // through, in no particular order
+    template <class F>
+    bool Raycast(const glm::vec3& Origin, const glm::vec3& Vector, F&& Visit) const
+    {
+        // not `1 / 0 = inf`, that would make `0 * inf = NaN` when the ray starts on a slab plane
+        const glm::vec3 invVector = glm::vec3(
+            Vector.x != 0.f ? 1.f / Vector.x : 1e30f,
+            Vector.y != 0.f ? 1.f / Vector.y : 1e30f,
+            Vector.z != 0.f ? 1.f / Vector.z : 1e30f
+        );
+
+        return m_Traverse(
+            [&Origin, &invVector](const Node& N)
+            {
+                glm::vec3 t1 = (N.Min - Origin) * invVector;
+                glm::vec3 t2 = (N.Max - Origin) * invVector;
+                glm::vec3 tNear = glm::min(t1, t2);
+                glm::vec3 tFar = glm::max(t1, t2);
+
+                float enter = glm::max(glm::max(tNear.x, tNear.y), glm::max(tNear.z, 0.f));
+                float exit = glm::min(glm::min(tFar.x, tFar.y), glm::min(tFar.z, 1.f));
+
+                return !(enter > exit);
+            },
+            Visit
+        );
+    }
+
+    // `Visit(ObjectId, LaneMask)` for each leaf whose fat AABB at least one of the packet's rays passes
+    // through, with a bit set for each of them. `Visit` may lower `Packet.MaxT` once a lane has found
+    // something, to skip the parts of the tree which are further along it
+    template <class F>
+    bool RaycastPacket(const SimdMath::RayPacket& Packet, F&& Visit) const
+    {
+        // `m_Traverse` visits a leaf straight after testing it
+        int leafMask = 0;
+
+        return m_Traverse(
+            [&Packet, &leafMask](const Node& N)
+            {
+                leafMask = SimdMath::RayPacketAabb(Packet, N.Min, N.Max);
+                return leafMask != 0;
+            },
+            [&Visit, &leafMask](uint32_t ObjectId)
+            {
+                return Visit(ObjectId, leafMask);
+            }
+        );
+    }
+
+    // `Visit(Min, Max, IsLeaf)` for every node, for debug visualization
+    template <class F>
+    void ForEachNode(F&& Visit) const
+    {
+        m_Traverse(
+            [&Visit](const Node& N)
+            {
+                Visit(N.Min, N.Max, N.IsLeaf());
+                return true;
+            },
+            [](uint32_t)
+            {
+                return false;
+            }
+        );
+    }
+
+private:
+    struct Node
+    {
+        glm::vec3 Min = {};
+        glm::vec3 Max = {};
+
+        uint32_t Parent = NullNode; // next free node, when not in use
+        uint32_t Child1 = NullNode;
+        uint32_t Child2 = NullNode;
+        uint32_t ObjectId = UINT32_MAX; // leaves only
+
+        // 0 for leaves, -1 when not in use
+        int Height = -1;
+
+        bool IsLeaf() const { return Child1 == NullNode; }
+    };
+
+    static bool s_Overlaps(const glm::vec3& AMin, const glm::vec3& AMax, const glm::vec3& BMin, const glm::vec3& BMax)
+    {
+        return AMin.x <= BMax.x && AMax.x >= BMin.x
+            && AMin.y <= BMax.y && AMax.y >= BMin.y
+            && AMin.z <= BMax.z && AMax.z >= BMin.z;
+    }
+
+    // enough for any tree `::m_Balance` can produce from 32-bit node indices
+    static constexpr size_t MaxStackDepth = 128;
+
+    template <class Test, class F>
+    bool m_Traverse(Test&& ShouldDescend, F&& Visit) const
+    {
+        if (m_Root == NullNode)
+            return false;
+
+        uint32_t stack[MaxStackDepth];
+        size_t top = 0;
+        stack[top++] = m_Root;
+
+        while (top > 0)
+        {
+            const Node& node = m_Nodes[stack[--top]];
+
+            if (!ShouldDescend(node))
+                continue;
+
+            if (node.IsLeaf())
+            {
+                if (Visit(node.ObjectId))
+                    return true;
+            }
+            else
+            {
+                assert(top + 2 <= MaxStackDepth);
+                stack[top++] = node.Child1;
+                stack[top++] = node.Child2;
+            }
+        }
+
+        return false;
+    }
+
+    uint32_t m_AllocateNode();
+    void m_FreeNode(uint32_t);
+    void m_InsertLeaf(uint32_t Leaf);
+    void m_RemoveLeaf(uint32_t Leaf);
+    // AVL-style rotation of `Node` if its children's heights differ by more than 1,
+    // returns whichever node is now in its place
+    uint32_t m_Balance(uint32_t Node);
+    // recomputes bounds and heights from `Node` up to the root, re-balancing on the way
+    void m_Refit(uint32_t Node);
+
+    hx::vector<Node, MEMCAT(Physics)> m_Nodes;
+    uint32_t m_Root = NullNode;
+    uint32_t m_FreeList = NullNode;
+};
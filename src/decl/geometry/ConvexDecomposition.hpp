@@ -0,0 +1,33 @@
+// ConvexDecomposition.hpp, 17/10/2026
+// Approximating a concave mesh with a handful of convex hulls, for `EnCollisionType::Hulls`
+#pragma once
+
+#include <glm/vec3.hpp>
+#include <cstdint>
+#include <vector>
+
+#include "asset/Mesh.hpp"
+
+namespace ConvexDecomposition
+{
+    struct Settings
+    {
+        // voxels along the longest side of the mesh
+        uint32_t Resolution = 48;
+        uint32_t MaxHulls = 16;
+        // pieces stop being cut once their hull is bigger than their voxels by less than
+        // this fraction of the volume of the whole mesh's hull
+        float MaxConcavity = 0.01f;
+        // hulls with more vertices than this are simplified down to it
+        uint32_t MaxHullVertices = 32;
+    };
+
+    // V-HACD-style. The mesh is voxelized, filling in its inside if it's closed, and then cut
+    // along whichever axis-aligned plane leaves the pieces the most convex, until they're convex
+    // enough or there are `MaxHulls` of them. Returns the hull of each piece, in the mesh's space
+    std::vector<Mesh> Decompose(const Mesh&, const Settings& = {});
+
+    // Quickhull, with the triangles wound counter-clockwise when seen from outside.
+    // Empty if the points all lie on one plane
+    Mesh BuildHull(const std::vector<glm::vec3>& Points);
+}
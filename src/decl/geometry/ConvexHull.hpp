@@ -0,0 +1,34 @@
+// ConvexHull.hpp, 17/10/2026
+// The unique vertices of a collision mesh, laid out for support-point queries
+#pragma once
+
+#include <glm/vec3.hpp>
+#include <cstdint>
+
+#include "Stl.hpp"
+
+struct Mesh;
+
+struct ConvexHull
+{
+    // only the vertices the mesh's triangles use, each position once. `HillClimb` should only be
+    // set if the mesh really is convex, climbing gets stuck in the dents otherwise
+    static ConvexHull s_FromMesh(const Mesh&, bool HillClimb);
+
+    // index of the vertex furthest along `Direction`, in the hull's own space. Must not be empty
+    uint32_t FindSupport(const glm::vec3& Direction) const;
+
+    glm::vec3 GetVertex(uint32_t Index) const { return { X[Index], Y[Index], Z[Index] }; }
+    size_t GetNumVertices() const { return X.size(); }
+    bool IsEmpty() const { return X.empty(); }
+
+    // separate arrays, so that `SimdMath::MaxDot` can do 4 vertices at once
+    hx::vector<float, MEMCAT(Physics)> X;
+    hx::vector<float, MEMCAT(Physics)> Y;
+    hx::vector<float, MEMCAT(Physics)> Z;
+
+    // vertex `i` shares an edge with `Neighbours[NeighbourStart[i]]` up to `Neighbours[NeighbourStart[i + 1]]`.
+    // Both are empty if the hull isn't hill-climbed
+    hx::vector<uint32_t, MEMCAT(Physics)> NeighbourStart;
+    hx::vector<uint32_t, MEMCAT(Physics)> Neighbours;
+};
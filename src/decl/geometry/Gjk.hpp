@@ -2,12 +2,52 @@
 
 #pragma once
 
+#include <memory>
 #include <glm/vec3.hpp>
 
 #include "component/RigidBody.hpp"
 
+class TriangleBvh;
+
 namespace Gjk
 {
+	// A body's collider with everything the support functions need already looked up,
+	// so that it doesn't touch the body's GameObject and can be used from any thread
+	struct Shape
+	{
+		// `nullptr` for the shapes of queries, which aren't bodies
+		const EcRigidBody* Body = nullptr;
+		// without any scale, that's in `Scale`
+		glm::mat4 Transform = glm::mat4(1.f);
+		glm::vec3 Scale = glm::vec3(1.f);
+		// `EcRigidBody::GetMeshComponentHull`, for `EnCollisionType::MeshComponent`. Also what
+		// `EnCollisionType::MeshTriangles` falls back to when it's used as one convex shape
+		const ConvexHull* MeshHull = nullptr;
+		// `EcRigidBody::GetMeshTriangles`, for static `EnCollisionType::MeshTriangles` bodies. `IntersectionLib`
+		// goes through them one at a time, as shapes from `::MakeTriangle`. Kept alive by the shape
+		std::shared_ptr<const TriangleBvh> Triangles;
+		// the 3 corners, in world space, of a shape from `::MakeTriangle`
+		const glm::vec3* Triangle = nullptr;
+		// `Hulls` needs `Body`
+		EnCollisionType CollisionType = EnCollisionType::Cube;
+	};
+
+	// not thread-safe, it can rebuild `EcRigidBody::MeshComponentHull`
+	Shape MakeShape(EcRigidBody*);
+
+	Shape MakeSphere(const glm::vec3& Center, float Radius);
+	// `Transform` only places and rotates it, any scale it has is ignored
+	Shape MakeBox(const glm::mat4& Transform, const glm::vec3& Size);
+	// `Hull` is put through `Transform`, and must outlive the shape
+	Shape MakeConvex(const ConvexHull& Hull, const glm::mat4& Transform);
+	// `Corners` are in world space, and must outlive the shape
+	Shape MakeTriangle(const glm::vec3* Corners);
+	// what's between a `TriangleBvh`'s space and world space, for a shape with `Triangles`
+	glm::mat4 GetTrianglesToWorld(const Shape&);
+
+	// world-space bounds, from the furthest points along each axis
+	void FindBounds(const Shape&, glm::vec3* Min, glm::vec3* Max);
+
     struct SupportPoint
 	{
 		glm::vec3 P;  // Minkowski (A - B)
@@ -54,10 +94,10 @@ namespace Gjk
         bool HasIntersection = false;
     };
 
-    SupportPoint Support(const EcRigidBody* A, const EcRigidBody* B, const glm::vec3& Direction);
-	SupportPoint Support(const EcRigidBody* A, const glm::vec3& Point, const glm::vec3& Direction);
+    SupportPoint Support(const Shape& A, const Shape& B, const glm::vec3& Direction);
+	SupportPoint Support(const Shape& A, const glm::vec3& Point, const glm::vec3& Direction);
     bool SameDirection(const glm::vec3& A, const glm::vec3& B);
-    Result FindIntersection(const EcRigidBody* A, const EcRigidBody* B);
+    Result FindIntersection(const Shape& A, const Shape& B);
 
 	struct RaycastResult
 	{
@@ -68,5 +108,15 @@ namespace Gjk
 		bool HasIntersection = false;
 	};
 
-	RaycastResult FindRayIntersection(const EcRigidBody* A, const glm::vec3& Origin, const glm::vec3& Direction, float Distance);
+	RaycastResult FindRayIntersection(const Shape& A, const glm::vec3& Origin, const glm::vec3& Direction, float Distance);
+
+	struct DistanceResult
+	{
+		glm::vec3 PointA = {}; // closest point on A to B
+		glm::vec3 PointB = {}; // closest point on B to A
+		float Distance = 0.f;
+		bool Overlapping = false; // the points and distance are meaningless if so
+	};
+
+	DistanceResult FindDistance(const Shape& A, const Shape& B);
 };
@@ -56,6 +56,19 @@ namespace IntersectionLib
         const glm::vec3& Delta
     );
 
-    CollisionPoints Gjk(const EcRigidBody* A, const EcRigidBody* B);
-    CollisionPoints GjkRay(const EcRigidBody* A, const glm::vec3& Origin, const glm::vec3& Direction, float Distance, Gjk::RaycastResult* RayResult);
+    // when `B`, moving by `Delta`, first comes within `Separation` of `A`, by conservative advancement over
+    // `Gjk::FindDistance`. `Hit.Normal` points from A to B. Doesn't report shapes which start off overlapping.
+    // `A` can have `Triangles`, `B` is always treated as convex
+    SweptIntersection SweptGjk(
+        const Gjk::Shape& A,
+        const Gjk::Shape& B,
+        const glm::vec3& Delta,
+        float Separation
+    );
+
+    // shapes with `Triangles` go through them one at a time, and report the deepest
+    CollisionPoints Gjk(const Gjk::Shape& A, const Gjk::Shape& B);
+    // whether they touch at all, without working out how deep
+    bool Overlaps(const Gjk::Shape& A, const Gjk::Shape& B);
+    CollisionPoints GjkRay(const Gjk::Shape& A, const glm::vec3& Origin, const glm::vec3& Direction, float Distance, Gjk::RaycastResult* RayResult);
 }
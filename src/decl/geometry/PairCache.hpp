@@ -0,0 +1,54 @@
+// PairCache.hpp, 17/10/2026
+// Overlapping pairs found by the broadphase, kept from one physics step to the next
+#pragma once
+
+#include <cstdint>
+
+#include "geometry/IntersectionLib.hpp"
+#include "Stl.hpp"
+
+class PairCache
+{
+public:
+    struct Key
+    {
+        uint32_t A; // the lower ObjectId
+        uint32_t B;
+    };
+
+    struct Pair
+    {
+        uint32_t A; // the lower ObjectId
+        uint32_t B;
+        // narrowphase result from the most recent step, kept around so it can be
+        // used to warm-start the next one
+        IntersectionLib::CollisionPoints Contact;
+        // consecutive steps the pair has been touching for, 0 if it isn't
+        uint32_t TouchingSteps = 0;
+        // what the solver ended up applying along `Contact.Normal` and across it
+        float NormalImpulse = 0.f;
+        glm::vec3 TangentImpulse = {};
+    };
+
+    // Candidates can be added in any order, in either order of `A` and `B`, and any number
+    // of times, e.g. once for each cell they share or once from each side
+    void BeginUpdate();
+    void AddCandidate(uint32_t A, uint32_t B);
+    // sorts and deduplicates the candidates, and replaces `::Pairs` with them. Pairs which
+    // were already there keep their `Contact` and impulses, the rest are listed in `::Added`
+    // and `::Removed`
+    void EndUpdate();
+
+    void Clear();
+
+    // sorted by `A`, then `B`
+    hx::vector<Pair, MEMCAT(Physics)> Pairs;
+    // changes made by the last `::EndUpdate`. Removed pairs are as they were at the end of
+    // the step before, so whether they were still touching can be told
+    hx::vector<Key, MEMCAT(Physics)> Added;
+    hx::vector<Pair, MEMCAT(Physics)> Removed;
+
+private:
+    hx::vector<uint64_t, MEMCAT(Physics)> m_Candidates;
+    hx::vector<Pair, MEMCAT(Physics)> m_Next;
+};
@@ -1,6 +1,9 @@
 #pragma once
 
 #include "component/Mesh.hpp"
+#include "component/Workspace.hpp"
+#include "geometry/PairCache.hpp"
+#include "ThreadManager.hpp"
 #include "Memory.hpp"
 
 class Physics
@@ -12,19 +15,83 @@ public:
 
 	struct World
 	{
+		// the Workspace being simulated, bodies outside of it are left alone
+		uint32_t Workspace = PHX_GAMEOBJECT_NULL_ID;
 		std::vector<ObjectHandle> Dynamics;
 		std::vector<ObjectHandle> Statics;
+		// overlapping pairs, persistent across steps
+		PairCache Pairs;
+		// where contacts were found while `DebugContactPoints` is on, drawn and cleared by the Engine
+		hx::vector<glm::vec3, MEMCAT(Physics)> DebugContacts;
+
+		struct CollisionEvent
+		{
+			uint32_t A = PHX_GAMEOBJECT_NULL_ID;
+			uint32_t B = PHX_GAMEOBJECT_NULL_ID;
+			bool Began = false;
+		};
+		// pairs which started or stopped touching, in the order they did. Kept until
+		// `::FireCollisionEvents`, as steps may be on the tick worker
+		hx::vector<CollisionEvent, MEMCAT(Physics)> CollisionEvents;
+
+		// Fixed-tick mode only
+		struct TickedBody
+		{
+			uint32_t ObjectId = PHX_GAMEOBJECT_NULL_ID;
+			// at the end of the second-to-last and last ticks
+			glm::mat4 Previous = glm::mat4(1.f);
+			glm::mat4 Current = glm::mat4(1.f);
+		};
+
+		// the dynamic bodies as of the last two ticks, sorted by `ObjectId`. The main thread
+		// only reads `TickStates[FrontTickState]`, ticks in flight write to the other one
+		hx::vector<TickedBody, MEMCAT(Physics)> TickStates[2];
+		uint8_t FrontTickState = 0;
+		// simulation time which is due but hasn't been ticked yet
+		double TickAccumulator = 0.0;
+		// where between the last two ticks bodies should be drawn this frame
+		float TickAlpha = 1.f;
+		uint32_t PendingTicks = 0;
 	};
 
+	// fills `World.Dynamics` and `World.Statics` with the enabled bodies in `World.Workspace`
+	static void GatherBodies(World& World);
+	// signals `OnCollisionBegan` and `OnCollisionEnded` for the `World.CollisionEvents` since the last
+	// call, on both bodies of each. Runs Scripts, so must be on the main thread and outside of ticks
+	static void FireCollisionEvents(World& World);
+
 	void Step(World& World, double DeltaTime);
 
+	// Fixed-tick mode, used when `FixedTickRate` is above 0. Each frame, `::AdvanceTicks` works
+	// out how many ticks are due and where between the last two to draw the bodies, then after
+	// `::GatherBodies`, `::DispatchTicks` runs them on a worker thread. Until `::FinishTicks` returns,
+	// that worker owns every body in the World, along with their transforms (and those of their
+	// descendants), the Workspace's broadphase and the lazily-built mesh hulls. Parallel Scripts must
+	// be waited on before dispatching, and nothing else may read any of those until it returns, which
+	// must also be before the end of the frame
+	void AdvanceTicks(World& World, double DeltaTime);
+	void DispatchTicks(World& World);
+	void FinishTicks();
+
+	// where `ObjectId` should be drawn, between its transforms at the end of the last two ticks.
+	// `false` if it isn't a ticked body, or has been moved by something else since the last tick
+	static bool GetInterpolatedTransform(const World& World, uint32_t ObjectId, const glm::mat4& Actual, glm::mat4* Transform);
+
 	glm::vec3 Gravity = { 0.f, -50.f, 0.f };
 
 	// Handled by `EcPhysicsService`
 	double Timescale = 1.0;
+	// ticks per second, 0 steps once per frame on the main thread instead
+	double FixedTickRate = 0.0;
+	// what every Workspace keeps its bodies in, new ones included
+	EnBroadphase Broadphase = EnBroadphase::Grid;
 	bool Simulating = true;
 	bool SimulatingForcePaused = false;
 	bool DebugCollisionAabbs = false;
 	bool DebugContactPoints = false;
 	bool DebugSpatialHeat = false;
+
+private:
+	ThreadManager::TaskGroup m_TickTasks;
+	World* m_TickingWorld = nullptr;
 };
@@ -0,0 +1,53 @@
+// SimdMath.hpp, 17/10/2026
+// Batched matrix kernels, for the hot loops which would otherwise go one glm call at a time.
+// Matrices are taken as arrays of `glm::mat4`, as they're stored everywhere else, with a column
+// per SSE register. Point sets and ray packets, which would waste lanes that way, are split
+// into separate X, Y and Z arrays instead
+#pragma once
+
+#include <cstddef>
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+
+namespace SimdMath
+{
+    // `Out[i] = A[i] * B[i]`. Elements are done in order, and each is fully written
+    // before the next is read, so `Out` may alias `A` or `B`
+    void MultiplyMat4(const glm::mat4* A, const glm::mat4* B, glm::mat4* Out, size_t Count);
+
+    // `Out[i] = Matrix * vec4(Points[i], 1)`, `Out` may alias `Points`
+    void TransformPoints(const glm::mat4& Matrix, const glm::vec3* Points, glm::vec3* Out, size_t Count);
+
+    // World-space AABBs of the `[-1, 1]` cubes transformed by each matrix (i.e. the OBBs
+    // of Physics bodies). Exact, from the absolute basis vectors rather than the 8 corners.
+    // `OutHalfSizes` matches what `EcRigidBody::CollisionAabb.Size` has always held
+    void AabbsFromObbs(const glm::mat4* Matrices, glm::vec3* OutCenters, glm::vec3* OutHalfSizes, size_t Count);
+
+    // index of the point furthest along `Direction`, i.e. with the greatest dot product, the
+    // first one if several tie. Coordinates are in separate arrays, `Count` must not be 0
+    size_t MaxDot(const float* X, const float* Y, const float* Z, size_t Count, const glm::vec3& Direction);
+
+    // up to 4 segments `[Origin, Origin + Vector]`, one per lane, for testing against boxes together
+    struct RayPacket
+    {
+        static constexpr int Width = 4;
+
+        alignas(16) float OriginX[Width];
+        alignas(16) float OriginY[Width];
+        alignas(16) float OriginZ[Width];
+        // `1 / Vector`, with `1e30` instead of infinity for zero components
+        alignas(16) float InvVectorX[Width];
+        alignas(16) float InvVectorY[Width];
+        alignas(16) float InvVectorZ[Width];
+        // how far along its `Vector` each lane is tested, negative for unused lanes
+        alignas(16) float MaxT[Width];
+
+        // unused lanes can be left out, `Lane` must be below `Width`
+        void SetLane(int Lane, const glm::vec3& Origin, const glm::vec3& Vector, float LaneMaxT = 1.f);
+        void DisableLane(int Lane);
+    };
+
+    // bit `i` is set if lane `i` passes through the box within `[0, MaxT[i]]`. The same
+    // test as `AabbTree::Raycast` for each lane, when `MaxT` is 1
+    int RayPacketAabb(const RayPacket& Packet, const glm::vec3& Min, const glm::vec3& Max);
+}
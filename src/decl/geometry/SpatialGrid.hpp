@@ -0,0 +1,167 @@
+// SpatialGrid.hpp, 17/10/2026
+// Uniform grid of cells, each listing the objects which overlap it
+#pragma once
+
+#include <glm/vec3.hpp>
+#include <algorithm>
+#include <cstdint>
+
+#include "Stl.hpp"
+
+#define SPATIAL_HASH_GRID_SIZE 32.f
+
+class SpatialGrid
+{
+public:
+    static constexpr uint32_t NullProxy = UINT32_MAX;
+    // objects a cell holds before it needs a heap allocation
+    static constexpr uint32_t InlineCapacity = 4;
+
+    // cell containing the position, cell `C` is centered on `C * SPATIAL_HASH_GRID_SIZE`.
+    // Clamped well within `int`, so that far-off positions can't overflow it
+    static glm::ivec3 CellOf(const glm::vec3& Position);
+
+    // A proxy is one object's membership of the grid. It remembers its slot in every
+    // cell it is in, so that it can be taken out again without searching the cells
+    uint32_t CreateProxy(uint32_t ObjectId);
+    void DestroyProxy(uint32_t Proxy);
+    // whether `Proxy` still belongs to `ObjectId`, in case the grid was cleared since
+    bool OwnsProxy(uint32_t Proxy, uint32_t ObjectId) const;
+
+    // puts the proxy in every cell of `[CellMin, CellMax]`, and out of whichever it was in before
+    void SetCells(uint32_t Proxy, const glm::ivec3& CellMin, const glm::ivec3& CellMax);
+    void ClearCells(uint32_t Proxy);
+
+    // frees everything, invalidating all proxies
+    void Clear();
+
+    size_t GetNumCells() const;
+
+    // `Visit(ObjectId)` for each object in the cell, return `true` to stop.
+    // Returns whether it was stopped. The grid must not be modified during it
+    template <class F>
+    bool VisitCell(const glm::ivec3& Cell, F&& Visit) const
+    {
+        uint32_t index = m_FindCell(Cell);
+        if (index == EmptySlot)
+            return false;
+
+        const CellData& cell = m_Cells[index];
+
+        for (uint32_t i = 0; i < cell.Size; i++)
+            if (Visit(cell.At(i).ObjectId))
+                return true;
+
+        return false;
+    }
+
+    // `::VisitCell` over each cell in `[CellMin, CellMax]`. An object in multiple of them is
+    // visited once for each
+    template <class F>
+    bool VisitBox(const glm::ivec3& CellMin, const glm::ivec3& CellMax, F&& Visit) const
+    {
+        // doubles, as a huge box can have more cells than fit in 64 bits
+        double numBoxCells = std::max(double(CellMax.x) - CellMin.x + 1.0, 0.0)
+            * std::max(double(CellMax.y) - CellMin.y + 1.0, 0.0)
+            * std::max(double(CellMax.z) - CellMin.z + 1.0, 0.0);
+
+        // going through the occupied cells is quicker than looking up more cells than there
+        // are, and keeps a huge box from walking through billions of empty ones
+        if (numBoxCells > (double)m_NumCells)
+        {
+            for (const TableEntry& entry : m_Table)
+            {
+                if (entry.Cell == EmptySlot
+                    || entry.Key.x < CellMin.x || entry.Key.y < CellMin.y || entry.Key.z < CellMin.z
+                    || entry.Key.x > CellMax.x || entry.Key.y > CellMax.y || entry.Key.z > CellMax.z
+                )
+                    continue;
+
+                const CellData& cell = m_Cells[entry.Cell];
+
+                for (uint32_t i = 0; i < cell.Size; i++)
+                    if (Visit(cell.At(i).ObjectId))
+                        return true;
+            }
+
+            return false;
+        }
+
+        for (int x = CellMin.x; x <= CellMax.x; x++)
+            for (int y = CellMin.y; y <= CellMax.y; y++)
+                for (int z = CellMin.z; z <= CellMax.z; z++)
+                    if (VisitCell(glm::ivec3(x, y, z), Visit))
+                        return true;
+
+        return false;
+    }
+
+    // `Visit(Cell, NumObjects)` for every non-empty cell, for debug visualization
+    template <class F>
+    void ForEachCell(F&& Visit) const
+    {
+        for (const TableEntry& entry : m_Table)
+            if (entry.Cell != EmptySlot)
+                Visit(entry.Key, m_Cells[entry.Cell].Size);
+    }
+
+private:
+    static constexpr uint32_t EmptySlot = UINT32_MAX;
+
+    struct Item
+    {
+        uint32_t ObjectId;
+        uint32_t Proxy;
+        uint32_t Ref; // index into the proxy's `::Cells`
+    };
+
+    struct CellData
+    {
+        glm::ivec3 Key = {};
+        uint32_t Size = 0;
+        Item Inline[InlineCapacity];
+        hx::vector<Item, MEMCAT(Physics)> Overflow;
+
+        Item& At(uint32_t Index) { return Index < InlineCapacity ? Inline[Index] : Overflow[Index - InlineCapacity]; }
+        const Item& At(uint32_t Index) const { return Index < InlineCapacity ? Inline[Index] : Overflow[Index - InlineCapacity]; }
+    };
+
+    struct CellRef
+    {
+        uint32_t Cell;
+        uint32_t Slot;
+    };
+
+    struct ProxyData
+    {
+        hx::vector<CellRef, MEMCAT(Physics)> Cells;
+        uint32_t ObjectId = UINT32_MAX;
+    };
+
+    // key stored inline, so probing doesn't have to touch `m_Cells`
+    struct TableEntry
+    {
+        glm::ivec3 Key;
+        uint32_t Cell = EmptySlot;
+    };
+
+    static uint64_t s_Hash(const glm::ivec3&);
+
+    uint32_t m_FindCell(const glm::ivec3&) const;
+    uint32_t m_FindOrAddCell(const glm::ivec3&);
+    void m_RemoveFromCell(uint32_t Cell, uint32_t Slot);
+    void m_EraseTableSlot(size_t Slot);
+    void m_Rehash(size_t NewCapacity);
+
+    // open-addressed with linear probing, power-of-2 sized
+    hx::vector<TableEntry, MEMCAT(Physics)> m_Table;
+    size_t m_NumCells = 0;
+
+    // indices into these stay the same when the table is rehashed, which is what lets
+    // proxies keep their `CellRef`s
+    hx::vector<CellData, MEMCAT(Physics)> m_Cells;
+    hx::vector<uint32_t, MEMCAT(Physics)> m_FreeCells;
+
+    hx::vector<ProxyData, MEMCAT(Physics)> m_Proxies;
+    hx::vector<uint32_t, MEMCAT(Physics)> m_FreeProxies;
+};
@@ -0,0 +1,116 @@
+// TriangleBvh.hpp, 17/10/2026
+// Bounding volume hierarchy over the triangles of a mesh, for exact raycasts and
+// collisions against concave meshes, which a convex hull would fill in
+#pragma once
+
+#include <glm/vec3.hpp>
+#include <glm/common.hpp>
+#include <cassert>
+#include <cstdint>
+
+#include "Stl.hpp"
+
+struct Mesh;
+
+class TriangleBvh
+{
+public:
+    // built top-down with a binned surface area heuristic, in the mesh's own space.
+    // Degenerate triangles are left out
+    static TriangleBvh s_FromMesh(const Mesh&);
+
+    struct RaycastResult
+    {
+        // of the triangle which was hit, facing back towards the ray's origin. Not normalized
+        glm::vec3 Normal = {};
+        // fraction of `Vector`
+        float Time = 0.f;
+        uint32_t Triangle = UINT32_MAX;
+        bool Occurred = false;
+    };
+
+    // the first triangle the segment `[Origin, Origin + Vector]` passes through, from either side
+    RaycastResult Raycast(const glm::vec3& Origin, const glm::vec3& Vector) const;
+
+    // `Visit(Triangle)` for each triangle whose bounds overlap the box, return `true` to stop.
+    // Returns whether it was stopped
+    template <class F>
+    bool QueryAabb(const glm::vec3& Min, const glm::vec3& Max, F&& Visit) const
+    {
+        if (m_Nodes.empty())
+            return false;
+
+        uint32_t stack[MaxStackDepth];
+        size_t top = 0;
+        stack[top++] = 0;
+
+        while (top > 0)
+        {
+            const Node& node = m_Nodes[stack[--top]];
+
+            if (!s_Overlaps(node.Min, node.Max, Min, Max))
+                continue;
+
+            if (node.Count > 0)
+            {
+                for (uint32_t tri = node.Start; tri < node.Start + node.Count; tri++)
+                {
+                    const glm::vec3* corners = GetTriangle(tri);
+                    glm::vec3 triMin = glm::min(corners[0], glm::min(corners[1], corners[2]));
+                    glm::vec3 triMax = glm::max(corners[0], glm::max(corners[1], corners[2]));
+
+                    if (s_Overlaps(triMin, triMax, Min, Max) && Visit(tri))
+                        return true;
+                }
+            }
+            else
+            {
+                assert(top + 2 <= MaxStackDepth);
+                stack[top++] = node.Start;
+                stack[top++] = (uint32_t)(&node - m_Nodes.data()) + 1;
+            }
+        }
+
+        return false;
+    }
+
+    // the 3 corners of `Triangle`. Triangles are numbered in the order the tree has them, not the mesh
+    const glm::vec3* GetTriangle(uint32_t Triangle) const { return &m_Corners[Triangle * 3]; }
+    size_t GetNumTriangles() const { return m_Corners.size() / 3; }
+    size_t GetNumNodes() const { return m_Nodes.size(); }
+    bool IsEmpty() const { return m_Nodes.empty(); }
+
+    // bounds of the whole mesh
+    glm::vec3 GetMin() const { return m_Nodes.empty() ? glm::vec3(0.f) : m_Nodes[0].Min; }
+    glm::vec3 GetMax() const { return m_Nodes.empty() ? glm::vec3(0.f) : m_Nodes[0].Max; }
+
+private:
+    // leaves with more than this many triangles are split, if splitting is any cheaper
+    static constexpr uint32_t MaxLeafTriangles = 4;
+    // past this depth nodes are split down the middle instead, which bounds the depth
+    // to this plus the log2 of the number of triangles
+    static constexpr uint32_t MaxSahDepth = 64;
+    static constexpr size_t MaxStackDepth = MaxSahDepth + 40;
+
+    // depth-first, an inner node's first child is the node straight after it
+    struct Node
+    {
+        glm::vec3 Min = {};
+        // leaves: the first triangle. Inner nodes: the second child
+        uint32_t Start = 0;
+        glm::vec3 Max = {};
+        // 0 for inner nodes
+        uint32_t Count = 0;
+    };
+
+    static bool s_Overlaps(const glm::vec3& AMin, const glm::vec3& AMax, const glm::vec3& BMin, const glm::vec3& BMax)
+    {
+        return AMin.x <= BMax.x && AMax.x >= BMin.x
+            && AMin.y <= BMax.y && AMax.y >= BMin.y
+            && AMin.z <= BMax.z && AMax.z >= BMin.z;
+    }
+
+    hx::vector<Node, MEMCAT(Physics)> m_Nodes;
+    // 3 per triangle, sorted so that each leaf's triangles are together
+    hx::vector<glm::vec3, MEMCAT(Physics)> m_Corners;
+};
@@ -4212,10 +4212,18 @@ static void renderProperties()
                         conflictingProps.insert(std::pair(prop.first, false));
                 }
                 else
-                    propToComponent[pname] = sel->MemberToComponentMap[pname].Type;
+                {
+                    EntityComponent from = EntityComponent::None;
+
+                    if (sel->ComponentApis)
+                        if (const auto& mit = sel->ComponentApis->MemberToComponent.find(pname); mit != sel->ComponentApis->MemberToComponent.end())
+                            from = mit->second;
+
+                    propToComponent[pname] = from;
+                }
             }
 
-            for (uint16_t tag : sel->Tags)
+            for (uint16_t tag : sel->GetTags())
                 tags.insert(GameObjectManager::Get()->Collections[tag].Name);
         }
 
@@ -5156,11 +5164,14 @@ static void renderInfo(double DeltaTime)
 
                 ImGui::PlotLines("Usage", usageValues, GraphDatapoints, 0, nullptr, FLT_MAX, FLT_MAX, ImVec2(0, 100));
                 ImGui::PlotLines("Activity", activityValues, GraphDatapoints, 0, nullptr, FLT_MAX, FLT_MAX, ImVec2(0, 100));
+                ImGui::Text("Frame arena: %.2f KB", (float)Memory::FrameActivity[i].load() / 1000.f);
 
                 ImGui::TreePop(); // ocornut why do you do this to me
             }
         }
 
+        ImGui::Text("Frame arena capacity: %.2f KB", (float)Memory::FrameArenaCapacity.load() / 1000.f);
+
         if (IsSamplingStats)
             for (int i = 0; i < (int)Memory::Category::count; i++)
                 SampledCsv += std::to_string(memcounts[i]) + ",";
@@ -387,7 +387,7 @@ std::string GetUserHomeDirectoryPath()
 	return home;
 }
 
-void Engine::Initialize(int ThreadCount, bool Headless)
+void Engine::Initialize(ThreadManager::PoolConfiguration Threads, bool Headless)
 {
     ZoneScopedC(tracy::Color::Aqua);
 
@@ -409,7 +409,14 @@ void Engine::Initialize(int ThreadCount, bool Headless)
 
     Log.Info("Initializing managers...");
 
-    ThreadManagerInstance.Initialize(ThreadCount);
+    if (Threads.ComputeThreads < 0)
+        Threads.ComputeThreads = readFromConfiguration(Config, "WorkerThreads", -1);
+    if (Threads.IoThreads < 0)
+        Threads.IoThreads = readFromConfiguration(Config, "IoWorkerThreads", -1);
+    if (!Threads.PinComputeThreads.has_value())
+        Threads.PinComputeThreads = readFromConfiguration(Config, "PinWorkerThreads", false);
+
+    ThreadManagerInstance.Initialize(Threads);
     TextureManagerInstance.Initialize(IsHeadlessMode);
     ShaderManagerInstance.Initialize(IsHeadlessMode);
     MaterialManagerInstance.Initialize(); // mat after tex and shd as it may attempt to load a texture and shader
@@ -455,13 +462,16 @@ void Engine::Initialize(int ThreadCount, bool Headless)
 
 static void traverseHierarchy(
 	Scene& RendererScene,
-	Physics::World& PhysicsWorld,
 	std::vector<EcParticleEmitter*>& ParticleEmitters,
 	GameObject* Root,
 	EcCamera* SceneCamera,
 	double DeltaTime,
 	EcDirectionalLight** Sun,
-	bool DebugCollisionAabbs
+	bool DebugCollisionAabbs,
+	// bodies are drawn between their last two ticks if given
+	const Physics::World* TickedWorld,
+	// from where things are to where they're drawn, anything attached to a body moves with it
+	const glm::mat4& Offset = glm::mat4(1.f)
 )
 {
 	ZoneScopedC(tracy::Color::LightGoldenrod);
@@ -469,25 +479,32 @@ static void traverseHierarchy(
 	static uint32_t boxframeMaterial = UINT32_MAX;
 	static uint32_t cubeMesh = MeshProvider::Get()->LoadFromPath("!Cube");
 
-	Root->ForEachChild([&](const ObjectHandle& object) -> bool
+	Root->VisitDescendants([&](GameObject& object) -> GameObject::VisitResult
 	{
-		if (EcSound* sound = object->FindComponent<EcSound>(); sound && !Engine::Get()->IsHeadlessMode)
+		if (EcSound* sound = object.FindComponent<EcSound>(); sound && !Engine::Get()->IsHeadlessMode)
 			sound->Update(DeltaTime);
 
-		if (!object->GetEnabled())
-			return true; // continue
+		if (!object.GetEnabled())
+			return GameObject::VisitResult::SkipChildren;
 
-		EcTransform* ct = object->FindComponent<EcTransform>();
+		EcTransform* ct = object.FindComponent<EcTransform>();
 		// both useless without a Transform
-		EcMesh* cm = ct ? object->FindComponent<EcMesh>() : nullptr;
-		EcRigidBody* rb = ct ? object->FindComponent<EcRigidBody>() : nullptr;
+		EcMesh* cm = ct ? object.FindComponent<EcMesh>() : nullptr;
+		EcRigidBody* rb = ct ? object.FindComponent<EcRigidBody>() : nullptr;
+
+		glm::mat4 offset = Offset;
+		glm::mat4 drawTransform = ct ? Offset * ct->Transform : glm::mat4(1.f);
 
+		// bodies are gathered for the simulation by `Physics::GatherBodies`
 		if (rb)
 		{
-			if (rb->PhysicsDynamics)
-				PhysicsWorld.Dynamics.emplace_back(object);
-			else if (rb->PhysicsCollisions)
-				PhysicsWorld.Statics.emplace_back(object);
+			glm::mat4 interpolated;
+
+			if (TickedWorld && Physics::GetInterpolatedTransform(*TickedWorld, object.ObjectId, ct->Transform, &interpolated))
+			{
+				drawTransform = Offset * interpolated;
+				offset = drawTransform * glm::inverse(ct->Transform);
+			}
 
 			if (DebugCollisionAabbs && rb->PhysicsCollisions)
 			{
@@ -511,13 +528,13 @@ static void traverseHierarchy(
 		if (cm)
 		{
 			if (cm->Transparency > .95f || Engine::Get()->IsHeadlessMode)
-				return true; // continue
+				return GameObject::VisitResult::SkipChildren;
 
 			// TODO: frustum culling
 
 			RendererScene.RenderList.emplace_back(
 				cm->RenderMeshId,
-				ct->Transform,
+				drawTransform,
 				cm->MaterialId,
 				cm->Tint,
 				cm->Transparency,
@@ -528,21 +545,21 @@ static void traverseHierarchy(
 			);
 		}
 
-		if (EcTreeLink* link = object->FindComponent<EcTreeLink>(); link && link->Target.IsValid())
+		if (EcTreeLink* link = object.FindComponent<EcTreeLink>(); link && link->Target.IsValid())
 			traverseHierarchy(
 				RendererScene,
-				PhysicsWorld,
 				ParticleEmitters,
 				link->Target,
 				SceneCamera,
 				DeltaTime,
 				Sun,
-				DebugCollisionAabbs
+				DebugCollisionAabbs,
+				TickedWorld
 			);
 
-		EcDirectionalLight* directional = object->FindComponent<EcDirectionalLight>();
-		EcPointLight* point = object->FindComponent<EcPointLight>();
-		EcSpotLight* spot = object->FindComponent<EcSpotLight>();
+		EcDirectionalLight* directional = object.FindComponent<EcDirectionalLight>();
+		EcPointLight* point = object.FindComponent<EcPointLight>();
+		EcSpotLight* spot = object.FindComponent<EcSpotLight>();
 		
 		if (directional)
 		{
@@ -561,7 +578,7 @@ static void traverseHierarchy(
 		{
 			if (point)
 				RendererScene.LightingList.push_back(LightItem{
-					.Position = (glm::vec3)ct->Transform[3],
+					.Position = (glm::vec3)drawTransform[3],
 					.LightColor = point->LightColor * point->Brightness,
 					.Range = point->Range,
 					.Type = LightType::Point,
@@ -570,38 +587,48 @@ static void traverseHierarchy(
 
 			if (spot)
 				RendererScene.LightingList.push_back(LightItem{
-					.Position = (glm::vec3)ct->Transform[3],
+					.Position = (glm::vec3)drawTransform[3],
 					.LightColor = spot->LightColor * spot->Brightness,
 					.Range = spot->Range,
-					.SpotLightDirection = (glm::vec3)ct->Transform[2],
+					.SpotLightDirection = (glm::vec3)drawTransform[2],
 					.Angle = spot->Angle,
 					.Type = LightType::Spot,
 					.Shadows = false, /* spot->Shadows, */
 				});
 		}
 
-		if (EcAnimator* animator = object->FindComponent<EcAnimator>(); animator && animator->Animating)
+		if (EcAnimator* animator = object.FindComponent<EcAnimator>(); animator && animator->Animating)
+		{
 			animator->Step(DeltaTime);
+			// the joints are below us, and are about to be visited
+			EcTransform::s_FlushDirty();
+		}
 
-		if (!object->Children.empty())
+		if (EcParticleEmitter* emitter = object.FindComponent<EcParticleEmitter>())
+		{
+			emitter->Update(DeltaTime);
+			ParticleEmitters.push_back(emitter);
+		}
+
+		// the children need to be moved along with the body
+		if (offset != Offset)
+		{
 			traverseHierarchy(
 				RendererScene,
-				PhysicsWorld,
 				ParticleEmitters,
-				object.Dereference(),
+				&object,
 				SceneCamera,
 				DeltaTime,
 				Sun,
-				DebugCollisionAabbs
+				DebugCollisionAabbs,
+				TickedWorld,
+				offset
 			);
-		
-		if (EcParticleEmitter* emitter = object->FindComponent<EcParticleEmitter>())
-		{
-			emitter->Update(DeltaTime);
-			ParticleEmitters.push_back(emitter);
+
+			return GameObject::VisitResult::SkipChildren;
 		}
 
-		return true; // continue
+		return GameObject::VisitResult::Continue;
 	});
 }
 
@@ -738,7 +765,7 @@ ImVec2 Engine::GetViewportInputRectSize() const
 	return OverrideDefaultViewportInputRect ? OverrideViewportInputSize : ImVec2((float)WindowSizeX, (float)WindowSizeY);
 }
 
-void Engine::m_Render(double deltaTime, const std::vector<EcParticleEmitter*>& particleEmitters)
+void Engine::m_Render(double deltaTime, const glm::mat4& camTrans, const std::vector<EcParticleEmitter*>& particleEmitters)
 {
     ZoneScoped;
 
@@ -756,15 +783,8 @@ void Engine::m_Render(double deltaTime, const std::vector<EcParticleEmitter*>& p
     const ObjectHandle& sceneCamObject = m_Workspace->FindComponent<EcWorkspace>()->GetSceneCamera();
     EcCamera* sceneCamera = sceneCamObject->FindComponent<EcCamera>();
 
-    // we do this AFTER  `traverseHierarchy` in case any Scripts
-    // update the camera transform
-    glm::mat4 renderMatrix = sceneCamera->GetRenderMatrix(aspectRatio);
-
-    glm::mat4 camTrans = sceneCamera->GetWorldTransform();
-
-    glm::mat4 view = glm::inverse(camTrans);
-	view[3] = glm::vec4(0.f, 0.f, 0.f, 1.f);
-
+    // `camTrans` is read before the physics ticks are dispatched, as they might move
+    // the camera while we're drawing
     glm::mat4 projection = glm::perspective(
         glm::radians(sceneCamera->FieldOfView),
         aspectRatio,
@@ -772,6 +792,11 @@ void Engine::m_Render(double deltaTime, const std::vector<EcParticleEmitter*>& p
         sceneCamera->FarPlane
     );
 
+    glm::mat4 renderMatrix = projection * glm::inverse(camTrans);
+
+    glm::mat4 view = glm::inverse(camTrans);
+	view[3] = glm::vec4(0.f, 0.f, 0.f, 1.f);
+
     glm::mat4 skyRenderMatrix = projection * view;
 
     SkyboxShader.SetUniform("Phoenix_RenderMatrix", skyRenderMatrix);
@@ -813,7 +838,7 @@ void Engine::m_Render(double deltaTime, const std::vector<EcParticleEmitter*>& p
 	glEnable(GL_DEPTH_TEST);
 
 	// Main render pass
-	RendererContext.DrawScene(CurrentScene, renderMatrix, sceneCamera->GetWorldTransform(), GetRunningTime(), DebugWireframeRendering);
+	RendererContext.DrawScene(CurrentScene, renderMatrix, camTrans, GetRunningTime(), DebugWireframeRendering);
 
 	for (EcParticleEmitter* emitter : particleEmitters)
 		emitter->Render(renderMatrix);
@@ -881,6 +906,9 @@ void Engine::m_Render(double deltaTime, const std::vector<EcParticleEmitter*>& p
 		);
 	}
 
+	// they can inspect and change the bodies
+	PhysicsInstance.FinishTicks();
+
 	if (DeveloperTools::Initialized)
 		DeveloperTools::Frame(deltaTime);
 
@@ -947,6 +975,9 @@ void Engine::UnbindDataModel(const ObjectHandle& DataModel)
 		RAISE_RT("{} was not a bound datamodel", DataModel->Name);
 }
 
+// every Parallel VM step dispatched this frame
+static ThreadManager::TaskGroup s_ParallelVMTasks;
+
 static void dispatchParallelVMs(Engine* engine)
 {
     ZoneScoped;
@@ -957,6 +988,9 @@ static void dispatchParallelVMs(Engine* engine)
             continue;
 
 		vm->Desynchronized = true;
+		// incremented here rather than in the task, otherwise anything
+		// checking it before the task gets picked up sees `0`
+		ScriptEngine::ParallelVMsExecuting++;
 
         engine->ThreadManagerInstance.Dispatch(
             "ParallelVM",
@@ -965,11 +999,12 @@ static void dispatchParallelVMs(Engine* engine)
                 ZoneScoped;
                 ZoneText(vm->Name.data(), vm->Name.size());
 
-				ScriptEngine::ParallelVMsExecuting++;
                 vm->StepParallelScheduler(ScriptEngine::ExecutionPhase::Parallel);
 				ScriptEngine::ParallelVMsExecuting--;
             },
-            true
+            true,
+            ThreadManager::TaskPriority::High,
+            &s_ParallelVMTasks
         );
     }
 }
@@ -978,8 +1013,7 @@ static void waitForParallelVMs()
 {
     ZoneScoped;
 
-    while (ScriptEngine::ParallelVMsExecuting != 0)
-        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    ThreadManager::Get()->Wait(s_ParallelVMTasks);
 }
 
 void Engine::Start()
@@ -1188,6 +1222,9 @@ void Engine::Start()
 		for (const ObjectHandle& bound : BoundDataModels)
 			Reflection::SignalEvent(bound->FindComponent<EcDataModel>()->OnFrameBeginCallbacks, { deltaTime }, "DataModel.OnFrameBegin");
 
+		// from the last step or ticks, which have finished by now
+		Physics::FireCollisionEvents(physWorld);
+
         waitForParallelVMs();      // tsan ??
         ScriptEngine::StepVMs();   // serial phase
         dispatchParallelVMs(this);
@@ -1202,22 +1239,41 @@ void Engine::Start()
 
 			CurrentScene.RenderList.clear();
 			CurrentScene.LightingList.clear();
-			physWorld.Dynamics.clear();
-			physWorld.Statics.clear();
 			particleEmittersRenderList.clear();
 
+			EcTransform::s_FlushDirty();
+
+			// before drawing, so we know where between the last two ticks to draw the bodies
+			PhysicsInstance.AdvanceTicks(physWorld, deltaTime);
+
 			// Aggregate mesh and light data into lists
 			traverseHierarchy(
 				CurrentScene,
-				physWorld,
 				particleEmittersRenderList,
 				m_Workspace.Referred(),
 				sceneCamera,
 				deltaTime,
 				&sun,
-				PhysicsInstance.DebugCollisionAabbs
+				PhysicsInstance.DebugCollisionAabbs,
+				PhysicsInstance.FixedTickRate > 0.0 ? &physWorld : nullptr
 			);
 
+			physWorld.Workspace = m_Workspace->ObjectId;
+			Physics::GatherBodies(physWorld);
+
+			// from the last step or ticks, which have finished by now. Bodies are drawn as of then
+			// this frame anyway, as the next step or ticks only run after this
+			for (const glm::vec3& contact : physWorld.DebugContacts)
+				CurrentScene.RenderList.push_back(RenderItem{
+					.RenderMeshId = 0,
+					.Transform = glm::translate(glm::scale(glm::mat4(1.f), glm::vec3(0.2f)), contact),
+					.MaterialId = MaterialManagerInstance.LoadFromPath("unlit"),
+					.TintColor = glm::vec3(1.f, 0.f, 0.f),
+					.Transparency = 0.1f,
+					.FaceCulling = FaceCullingMode::None
+				});
+			physWorld.DebugContacts.clear();
+
             // TODO weird skybox graphical corruption if we don't draw anything
             if (CurrentScene.RenderList.size() == 0)
                 CurrentScene.RenderList.push_back(RenderItem{
@@ -1231,26 +1287,50 @@ void Engine::Start()
                 workspaceComponent = m_Workspace->FindComponent<EcWorkspace>();
                 assert(workspaceComponent);
 
-                for (const auto& it : workspaceComponent->SpatialHash)
-                {
-                    if (it.second.size() == 0)
-                        continue;
+                // the tree has no density to show, its leaves' fat AABBs are drawn instead
+                if (workspaceComponent->Broadphase == EnBroadphase::Tree)
+                    workspaceComponent->Tree.ForEachNode([this](const glm::vec3& Min, const glm::vec3& Max, bool IsLeaf)
+                    {
+                        if (!IsLeaf)
+                            return;
+
+                        CurrentScene.RenderList.push_back(RenderItem{
+                            .RenderMeshId = 1, // `!Cube`
+                            .Transform = glm::translate(glm::mat4(1.f), (Min + Max) / 2.f) * glm::scale(glm::mat4(1.f), Max - Min),
+                            .MaterialId = MaterialManagerInstance.LoadFromPath("@base/materials/boxframe.mtl"),
+                            .TintColor = glm::vec3(1.f, 0.f, 0.f),
+                            .Transparency = 0.f,
+                            .FaceCulling = FaceCullingMode::None
+                        });
+                    });
 
+                workspaceComponent->Grid.ForEachCell([this](const glm::ivec3& Cell, uint32_t NumObjects)
+                {
                     CurrentScene.RenderList.push_back(RenderItem{
                         .RenderMeshId = 0,
-                        .Transform = glm::translate(glm::scale(glm::mat4(1.f), glm::vec3(SPATIAL_HASH_GRID_SIZE)), (glm::vec3)it.first),
+                        .Transform = glm::translate(glm::scale(glm::mat4(1.f), glm::vec3(SPATIAL_HASH_GRID_SIZE)), glm::vec3(Cell)),
                         .MaterialId = MaterialManagerInstance.LoadFromPath("@base/materials/neon.mtl"),
                         .TintColor = glm::vec3(1.f, 0.f, 0.f),
-                        .Transparency = std::clamp(1.f - ((float)(it.second.size() + 5) / 64.f), 0.2f, 1.f),
+                        .Transparency = std::clamp(1.f - ((float)(NumObjects + 5) / 64.f), 0.2f, 1.f),
                         .FaceCulling = FaceCullingMode::None
                     });
-                }
+                });
             }
 
             sceneCamera = sceneCamObject->FindComponent<EcCamera>();
 		}
 
-        if (PhysicsInstance.Simulating && !PhysicsInstance.SimulatingForcePaused && physWorld.Dynamics.size() > 0)
+		// read now, as the camera may be under a body which the ticks are about to move
+		glm::mat4 cameraTransform = sceneCamera->GetWorldTransform();
+
+        // ticks run alongside rendering, and are waited on before the Developer Tools get a look at the scene.
+        // Nothing may read transforms or the broadphase until then, including Parallel Scripts
+        if (PhysicsInstance.FixedTickRate > 0.0)
+        {
+            waitForParallelVMs();
+            PhysicsInstance.DispatchTicks(physWorld);
+        }
+        else if (PhysicsInstance.Simulating && !PhysicsInstance.SimulatingForcePaused && physWorld.Dynamics.size() > 0)
             PhysicsInstance.Step(physWorld, deltaTime * PhysicsInstance.Timescale);
 
         if (!IsHeadlessMode)
@@ -1269,7 +1349,8 @@ void Engine::Start()
 			TIME_SCOPE_AS("Shadows");
 			ZoneScopedN("Shadows");
 
-			Scene sunScene;
+			Scene& sunScene = m_ShadowScene;
+			sunScene.RenderList.clear();
 			sunScene.RenderList.reserve(CurrentScene.RenderList.size());
 			sunScene.UsedShaders = CurrentScene.UsedShaders;
 
@@ -1292,7 +1373,7 @@ void Engine::Start()
 			);
 			sunView[3] = glm::vec4(glm::vec3(sunView[3]) + sun->ShadowViewOffset, 1.f);
 			if (sun->ShadowViewMoveWithCamera)
-				sunView[3] = glm::vec4(glm::vec3(sunView[3]) - glm::vec3(sceneCamera->GetWorldTransform()[3]), 1.f);
+				sunView[3] = glm::vec4(glm::vec3(sunView[3]) - glm::vec3(cameraTransform[3]), 1.f);
 
 			glm::mat4 sunRenderMatrix = sunOrtho * sunView;
 
@@ -1333,10 +1414,12 @@ void Engine::Start()
                     shader.SetUniform("Phoenix_FogColor", env->FogColor.ToGenericValue());
             }
 
-			m_Render(deltaTime, particleEmittersRenderList);
+			m_Render(deltaTime, cameraTransform, particleEmittersRenderList);
 			RendererContext.SwapBuffers();
 		}
 
+		// ticks use frame memory, and are not allowed to outlive the frame
+		PhysicsInstance.FinishTicks();
 		waitForParallelVMs();
 
 		// End of frame
@@ -1353,6 +1436,10 @@ void Engine::Start()
 			this->FramesPerSecond = m_DrawnFramesInSecond;
 			m_DrawnFramesInSecond = -1;
 
+			for (IComponentManager* manager : ObjectManager.ComponentManagers)
+				if (manager)
+					manager->Compact();
+
 			Logging::Save();
 		}
 
@@ -191,7 +191,7 @@ static void doApiDump()
 
 struct EngineInitConfig
 {
-    std::optional<int> ThreadManagerThreadCount;
+    ThreadManager::PoolConfiguration Threads;
     std::optional<const char*> ScriptTool;
     std::optional<std::string> RootScene;
     std::optional<bool> Developer;
@@ -205,7 +205,7 @@ static const char* ScriptTool = nullptr;
 static void init(Engine* engine, const EngineInitConfig& InitConfig)
 {
     ZoneScoped;
-    engine->Initialize(InitConfig.ThreadManagerThreadCount.value_or(-1), InitConfig.Headless.value_or(false));
+    engine->Initialize(InitConfig.Threads, InitConfig.Headless.value_or(false));
 
     if (InitConfig.DoApiDump)
         doApiDump();
@@ -373,12 +373,26 @@ static void processCliArgs(EngineInitConfig& InitConfig, int argc, char** argv)
         {
             if (i + 1 < argc)
             {
-                InitConfig.ThreadManagerThreadCount = std::stoi(argv[i + 1]);
+                InitConfig.Threads.ComputeThreads = std::stoi(argv[i + 1]);
                 i++;
             }
             else
                 RAISE_RT("'--threads' argument from command-line was not followed by the desired Thread Count");
         }
+        else if (strcmp(v, "--io-threads") == 0)
+        {
+            if (i + 1 < argc)
+            {
+                InitConfig.Threads.IoThreads = std::stoi(argv[i + 1]);
+                i++;
+            }
+            else
+                RAISE_RT("'--io-threads' argument from command-line was not followed by the desired Thread Count");
+        }
+        else if (isBoolArgument(v, "--pin-threads"))
+        {
+            InitConfig.Threads.PinComputeThreads = checkBoolArgument(v, "--pin-threads", true);
+        }
         else if (strcmp(v, "--tracy") == 0)
         {
             DeveloperTools::LaunchTracy();
@@ -1,4 +1,5 @@
 // 24/01/2025
+// (04/02/2026 only allocations too big for the thread pools further down, now)
 // this thing functions based on padding the allocated memory with an
 // `AllocHeader` that describes the size and category of the allocation
 // https://stackoverflow.com/a/1208728/16875161
@@ -10,8 +11,12 @@
 
 #include <tracy/Tracy.hpp>
 #include <assert.h>
-#include <format>
+#include <algorithm>
 #include <stdexcept>
+#include <cstring>
+#include <format>
+#include <mutex>
+#include <new>
 
 #include "Memory.hpp"
 
@@ -27,6 +32,118 @@ struct alignas(std::max_align_t) AllocHeader
 
 static_assert(sizeof(AllocHeader) % alignof(std::max_align_t) == 0);
 
+// 03/02/2026
+// Frame arena. Allocations bump an atomic offset into the current chunk, if it's
+// full a chunk twice the size is put in front of it. At the end of the frame, if more
+// than one chunk was needed they're merged into a single one big enough for the
+// whole frame, so after the first few frames it's just the one chunk being reused
+
+#define FRAME_ARENA_INITIAL_SIZE (size_t(1024) * 1024)
+
+struct alignas(std::max_align_t) FrameArenaChunk
+{
+	FrameArenaChunk* Next = nullptr;
+	size_t Capacity = 0;
+	std::atomic_size_t Used = 0;
+
+	uint8_t* Data()
+	{
+		return (uint8_t*)this + sizeof(FrameArenaChunk);
+	}
+};
+
+static std::atomic<FrameArenaChunk*> s_FrameArenaHead = nullptr;
+static std::mutex s_FrameArenaGrowMutex;
+static std::array<std::atomic_size_t, static_cast<size_t>(Memory::Category::count)> s_FrameActivityWip{ 0 };
+
+static FrameArenaChunk* newFrameArenaChunk(size_t Capacity, FrameArenaChunk* Next)
+{
+	void* mem = malloc(sizeof(FrameArenaChunk) + Capacity);
+	if (!mem)
+		throw std::bad_alloc();
+
+	FrameArenaChunk* chunk = new (mem) FrameArenaChunk;
+	chunk->Next = Next;
+	chunk->Capacity = Capacity;
+
+	Memory::FrameArenaCapacity += Capacity;
+
+	return chunk;
+}
+
+void* Memory::FrameAlloc(size_t Size, Memory::Category MemCat)
+{
+	constexpr size_t Alignment = alignof(std::max_align_t);
+	Size = std::max((Size + Alignment - 1) & ~(Alignment - 1), Alignment);
+
+	s_FrameActivityWip[static_cast<uint8_t>(MemCat)].fetch_add(Size, std::memory_order_relaxed);
+
+	while (true)
+	{
+		FrameArenaChunk* chunk = s_FrameArenaHead.load(std::memory_order_acquire);
+
+		if (chunk)
+		{
+			size_t offset = chunk->Used.fetch_add(Size, std::memory_order_relaxed);
+
+			if (offset + Size <= chunk->Capacity)
+				return chunk->Data() + offset;
+		}
+
+		std::unique_lock<std::mutex> lock = std::unique_lock<std::mutex>(s_FrameArenaGrowMutex);
+
+		// someone else already grew it while we were waiting
+		if (s_FrameArenaHead.load(std::memory_order_acquire) != chunk)
+			continue;
+
+		size_t capacity = std::max(chunk ? chunk->Capacity * 2 : FRAME_ARENA_INITIAL_SIZE, Size);
+		s_FrameArenaHead.store(newFrameArenaChunk(capacity, chunk), std::memory_order_release);
+	}
+}
+
+// nothing may be allocating from the arena while this runs
+static void resetFrameArena()
+{
+	ZoneScoped;
+
+	for (size_t i = 0; i < s_FrameActivityWip.size(); i++)
+	{
+		Memory::FrameActivity[i] = s_FrameActivityWip[i].load();
+		s_FrameActivityWip[i] = 0;
+	}
+
+	FrameArenaChunk* head = s_FrameArenaHead.load();
+
+	if (!head)
+		return;
+
+	if (head->Next)
+	{
+		size_t total = 0;
+
+		for (FrameArenaChunk* chunk = head; chunk;)
+		{
+			FrameArenaChunk* next = chunk->Next;
+
+			total += chunk->Capacity;
+			Memory::FrameArenaCapacity -= chunk->Capacity;
+			free(chunk);
+
+			chunk = next;
+		}
+
+		s_FrameArenaHead = newFrameArenaChunk(total, nullptr);
+	}
+	else
+	{
+#ifndef NDEBUG
+		// make anything still holding onto last frame's memory obvious
+		memset(head->Data(), 0xCD, std::min(head->Used.load(), head->Capacity));
+#endif
+		head->Used = 0;
+	}
+}
+
 #if defined(PHOENIX_ReleaseTSan) || defined(PHOENIX_DebugTSan)
 
 void* Memory::GetPointerInfo(void* Ptr, uint32_t*, uint8_t*)
@@ -51,14 +168,458 @@ void* Memory::ReAlloc(void* Ptr, uint32_t N, Memory::Category)
 
 void Memory::FrameFinish()
 {
+	resetFrameArena();
+}
+
+#else
+
+// 04/02/2026
+// Small allocations (up to `POOL_MAX_SIZE`) are served from per-thread pools instead.
+// Each pool page is `POOL_PAGE_SIZE`-aligned and only holds blocks of one size class and
+// one category, so the page a block lives in (found by masking the address) tells us
+// everything the `AllocHeader` would have, and a two-level page map tells us whether a
+// pointer is pooled at all. Blocks freed by a thread other than the owner of their page
+// are pushed onto the owner's `RemoteFrees` list, and handed back the next time it
+// allocates. Statistics are kept per thread cache and only summed up in `::FrameFinish`,
+// so `Counters` and `Activity` are as of the end of the previous frame.
+// Thread caches are never freed, when a thread exits its cache is orphaned and the
+// next new thread adopts it, along with all of its pages
+
+#define POOL_PAGE_SIZE (64u * 1024u)
+#define POOL_PAGE_SHIFT 16u
+#define POOL_MAX_SIZE 1024u
+#define POOL_NUM_CLASSES 20u
+// (re-)drain remote frees every this-many allocations, even if we haven't run out
+#define POOL_DRAIN_INTERVAL 256u
+
+static_assert((1u << POOL_PAGE_SHIFT) == POOL_PAGE_SIZE);
+
+static constexpr uint32_t s_SizeClasses[] = {
+	16, 32, 48, 64, 80, 96, 112, 128,
+	160, 192, 224, 256,
+	320, 384, 448, 512,
+	640, 768, 896, 1024
+};
+
+static_assert(std::size(s_SizeClasses) == POOL_NUM_CLASSES);
+static_assert(s_SizeClasses[POOL_NUM_CLASSES - 1] == POOL_MAX_SIZE);
+
+// indexed by `(Size + 15) / 16`
+static constexpr std::array<uint8_t, POOL_MAX_SIZE / 16 + 1> s_SizeToClass = []()
+{
+	std::array<uint8_t, POOL_MAX_SIZE / 16 + 1> table{};
+	uint8_t sizeClass = 0;
+
+	for (uint32_t i = 0; i < table.size(); i++)
+	{
+		while (s_SizeClasses[sizeClass] < i * 16)
+			sizeClass++;
+
+		table[i] = sizeClass;
+	}
+
+	return table;
+}();
+
+static uint8_t sizeToClass(uint32_t Size)
+{
+	assert(Size <= POOL_MAX_SIZE);
+	return s_SizeToClass[(Size + 15) / 16];
+}
+
+struct FreeBlock
+{
+	FreeBlock* Next;
+};
+
+struct ThreadCache;
+
+struct alignas(64) PoolPage
+{
+	ThreadCache* Owner = nullptr;
+	// neighbours in the owner's bin, only while `InBin`
+	PoolPage* Prev = nullptr;
+	PoolPage* Next = nullptr;
+
+	FreeBlock* FreeList = nullptr;
+	// blocks past this have never been handed out
+	uint8_t* BumpCursor = nullptr;
+
+	uint32_t BlockSize = 0;
+	uint32_t NumUsed = 0;
+	uint8_t Category = 0;
+	uint8_t SizeClass = 0;
+	bool InBin = false;
+};
+
+static_assert(sizeof(PoolPage) % 16 == 0);
+
+struct CategoryStats
+{
+	// only ever written by the thread which owns the cache, so
+	// no read-modify-writes, but `::FrameFinish` reads them
+	std::atomic<uint64_t> Allocated = 0;
+	std::atomic<uint64_t> Freed = 0;
+};
+
+struct ThreadCache
+{
+	// pages with at least one free block
+	PoolPage* Bins[static_cast<size_t>(Memory::Category::count)][POOL_NUM_CLASSES] = {};
+	std::atomic<FreeBlock*> RemoteFrees = nullptr;
+
+	std::array<CategoryStats, static_cast<size_t>(Memory::Category::count)> Stats;
+
+	ThreadCache* NextInRegistry = nullptr;
+	ThreadCache* NextOrphan = nullptr;
+	uint32_t AllocsSinceDrain = 0;
+};
+
+static std::atomic<ThreadCache*> s_CacheRegistry = nullptr;
+static ThreadCache* s_OrphanedCaches = nullptr;
+static std::mutex s_OrphanedCachesMutex;
+
+// for when a thread allocates after its cache has already been released
+static std::array<CategoryStats, static_cast<size_t>(Memory::Category::count)> s_UncachedStats;
+static std::array<uint64_t, static_cast<size_t>(Memory::Category::count)> s_PrevActivityTotals{ 0 };
+
+static PoolPage* s_FreePages = nullptr;
+static std::mutex s_FreePagesMutex;
+
+// page number -> pool page, split on the top and bottom 16 bits of the
+// page number. Good for 48-bit addresses, which is all we get anyway
+static std::atomic<std::atomic<PoolPage*>*> s_PageMap[1u << 16];
+static std::mutex s_PageMapMutex;
+
+static thread_local ThreadCache* t_Cache = nullptr;
+static thread_local bool t_CacheReleased = false;
+
+static void addStat(std::atomic<uint64_t>& Stat, uint64_t Bytes)
+{
+	Stat.store(Stat.load(std::memory_order_relaxed) + Bytes, std::memory_order_relaxed);
+}
+
+static void countAlloc(ThreadCache* Cache, uint8_t MemCat, uint64_t Bytes)
+{
+	if (Cache)
+		addStat(Cache->Stats[MemCat].Allocated, Bytes);
+	else
+		s_UncachedStats[MemCat].Allocated.fetch_add(Bytes, std::memory_order_relaxed);
 }
 
+static void countFree(ThreadCache* Cache, uint8_t MemCat, uint64_t Bytes)
+{
+	if (Cache)
+		addStat(Cache->Stats[MemCat].Freed, Bytes);
+	else
+		s_UncachedStats[MemCat].Freed.fetch_add(Bytes, std::memory_order_relaxed);
+}
+
+static PoolPage* pageOf(void* Pointer)
+{
+	return (PoolPage*)((uintptr_t)Pointer & ~(uintptr_t)(POOL_PAGE_SIZE - 1));
+}
+
+// `nullptr` if `Pointer` didn't come from a pool
+static PoolPage* findPoolPage(void* Pointer)
+{
+	uintptr_t pageNumber = (uintptr_t)Pointer >> POOL_PAGE_SHIFT;
+
+	if (pageNumber >> 32)
+		return nullptr;
+
+	std::atomic<PoolPage*>* leaf = s_PageMap[pageNumber >> 16].load(std::memory_order_acquire);
+
+	return leaf ? leaf[pageNumber & 0xFFFF].load(std::memory_order_relaxed) : nullptr;
+}
+
+static void registerPoolPage(PoolPage* Page)
+{
+	uintptr_t pageNumber = (uintptr_t)Page >> POOL_PAGE_SHIFT;
+	assert((pageNumber >> 32) == 0);
+
+	std::atomic<std::atomic<PoolPage*>*>& root = s_PageMap[pageNumber >> 16];
+	std::atomic<PoolPage*>* leaf = root.load(std::memory_order_acquire);
+
+	if (!leaf)
+	{
+		std::unique_lock<std::mutex> lock = std::unique_lock<std::mutex>(s_PageMapMutex);
+		leaf = root.load(std::memory_order_acquire);
+
+		if (!leaf)
+		{
+			leaf = (std::atomic<PoolPage*>*)calloc(1u << 16, sizeof(std::atomic<PoolPage*>));
+			if (!leaf)
+				throw std::bad_alloc();
+
+			root.store(leaf, std::memory_order_release);
+		}
+	}
+
+	leaf[pageNumber & 0xFFFF].store(Page, std::memory_order_release);
+}
+
+static PoolPage* acquirePoolPage()
+{
+	{
+		std::unique_lock<std::mutex> lock = std::unique_lock<std::mutex>(s_FreePagesMutex);
+
+		if (PoolPage* page = s_FreePages)
+		{
+			s_FreePages = page->Next;
+			return page;
+		}
+	}
+
+#ifdef _WIN32
+	void* memory = _aligned_malloc(POOL_PAGE_SIZE, POOL_PAGE_SIZE);
 #else
+	void* memory = aligned_alloc(POOL_PAGE_SIZE, POOL_PAGE_SIZE);
+#endif
+
+	if (!memory)
+		throw std::bad_alloc();
+
+	PoolPage* page = new (memory) PoolPage;
+	registerPoolPage(page);
 
-static std::array<std::atomic_size_t, static_cast<size_t>(Memory::Category::count)> s_ActivityWip{ 0 };
+	return page;
+}
+
+// pages stay registered and are never given back to the OS, only re-used
+static void releasePoolPage(PoolPage* Page)
+{
+	Page->Owner = nullptr;
+
+	std::unique_lock<std::mutex> lock = std::unique_lock<std::mutex>(s_FreePagesMutex);
+	Page->Next = s_FreePages;
+	s_FreePages = Page;
+}
+
+static void binLink(ThreadCache* Cache, PoolPage* Page)
+{
+	PoolPage*& head = Cache->Bins[Page->Category][Page->SizeClass];
+
+	Page->Prev = nullptr;
+	Page->Next = head;
+	if (head)
+		head->Prev = Page;
+
+	head = Page;
+	Page->InBin = true;
+}
+
+static void binUnlink(ThreadCache* Cache, PoolPage* Page)
+{
+	PoolPage*& head = Cache->Bins[Page->Category][Page->SizeClass];
+
+	if (Page->Prev)
+		Page->Prev->Next = Page->Next;
+	else
+		head = Page->Next;
+
+	if (Page->Next)
+		Page->Next->Prev = Page->Prev;
+
+	Page->Prev = nullptr;
+	Page->Next = nullptr;
+	Page->InBin = false;
+}
+
+static void localFree(ThreadCache* Cache, PoolPage* Page, void* Pointer)
+{
+	assert(Page->Owner == Cache);
+	assert(Page->NumUsed > 0);
+
+	FreeBlock* block = (FreeBlock*)Pointer;
+	block->Next = Page->FreeList;
+	Page->FreeList = block;
+	Page->NumUsed--;
+
+	if (!Page->InBin)
+		binLink(Cache, Page);
+
+	// hand fully-free pages back, but keep at least one per bin so
+	// that alloc-free-alloc-free doesn't keep acquiring and releasing it
+	else if (Page->NumUsed == 0 && (Page->Prev || Page->Next))
+	{
+		binUnlink(Cache, Page);
+		releasePoolPage(Page);
+	}
+}
+
+static void drainRemoteFrees(ThreadCache* Cache)
+{
+	Cache->AllocsSinceDrain = 0;
+
+	if (!Cache->RemoteFrees.load(std::memory_order_relaxed))
+		return;
+
+	FreeBlock* block = Cache->RemoteFrees.exchange(nullptr, std::memory_order_acquire);
+
+	while (block)
+	{
+		FreeBlock* next = block->Next;
+		localFree(Cache, pageOf(block), block);
+		block = next;
+	}
+}
+
+static void pushRemoteFree(ThreadCache* Owner, void* Pointer)
+{
+	FreeBlock* block = (FreeBlock*)Pointer;
+	FreeBlock* head = Owner->RemoteFrees.load(std::memory_order_relaxed);
+
+	do
+		block->Next = head;
+	while (!Owner->RemoteFrees.compare_exchange_weak(head, block, std::memory_order_release, std::memory_order_relaxed));
+}
+
+struct ThreadCacheReleaser
+{
+	~ThreadCacheReleaser()
+	{
+		if (!t_Cache)
+			return;
+
+		std::unique_lock<std::mutex> lock = std::unique_lock<std::mutex>(s_OrphanedCachesMutex);
+		t_Cache->NextOrphan = s_OrphanedCaches;
+		s_OrphanedCaches = t_Cache;
+
+		t_Cache = nullptr;
+		t_CacheReleased = true;
+	}
+};
+
+// `nullptr` if the thread is already being torn down
+static ThreadCache* getThreadCache()
+{
+	if (t_Cache || t_CacheReleased)
+		return t_Cache;
+
+	// orphans the cache once the thread exits
+	static thread_local ThreadCacheReleaser Releaser;
+
+	{
+		std::unique_lock<std::mutex> lock = std::unique_lock<std::mutex>(s_OrphanedCachesMutex);
+
+		if (s_OrphanedCaches)
+		{
+			t_Cache = s_OrphanedCaches;
+			s_OrphanedCaches = t_Cache->NextOrphan;
+			t_Cache->NextOrphan = nullptr;
+
+			return t_Cache;
+		}
+	}
+
+	// not through `new`, that'd come straight back here
+	void* memory = malloc(sizeof(ThreadCache));
+	if (!memory)
+		throw std::bad_alloc();
+
+	ThreadCache* cache = new (memory) ThreadCache;
+
+	ThreadCache* head = s_CacheRegistry.load(std::memory_order_relaxed);
+	do
+		cache->NextInRegistry = head;
+	while (!s_CacheRegistry.compare_exchange_weak(head, cache, std::memory_order_release, std::memory_order_relaxed));
+
+	t_Cache = cache;
+	return cache;
+}
+
+static void* poolAlloc(ThreadCache* Cache, uint32_t Size, uint8_t MemCat)
+{
+	uint8_t sizeClass = sizeToClass(Size);
+
+	if (++Cache->AllocsSinceDrain >= POOL_DRAIN_INTERVAL)
+		drainRemoteFrees(Cache);
+
+	PoolPage* page = Cache->Bins[MemCat][sizeClass];
+
+	if (!page)
+	{
+		drainRemoteFrees(Cache);
+		page = Cache->Bins[MemCat][sizeClass];
+	}
+
+	if (!page)
+	{
+		page = acquirePoolPage();
+		page->Owner = Cache;
+		page->FreeList = nullptr;
+		page->BumpCursor = (uint8_t*)page + sizeof(PoolPage);
+		page->BlockSize = s_SizeClasses[sizeClass];
+		page->NumUsed = 0;
+		page->Category = MemCat;
+		page->SizeClass = sizeClass;
+
+		binLink(Cache, page);
+	}
+
+	void* block = nullptr;
+	uint8_t* pageEnd = (uint8_t*)page + POOL_PAGE_SIZE;
+
+	if (page->FreeList)
+	{
+		block = page->FreeList;
+		page->FreeList = page->FreeList->Next;
+	}
+	else
+	{
+		block = page->BumpCursor;
+		page->BumpCursor += page->BlockSize;
+	}
+
+	page->NumUsed++;
+
+	if (!page->FreeList && (size_t)(pageEnd - page->BumpCursor) < page->BlockSize)
+		binUnlink(Cache, page);
+
+	countAlloc(Cache, MemCat, page->BlockSize);
+
+#ifdef TRACY_ENABLE
+	if (MemCat != static_cast<uint8_t>(Memory::Category::Default))
+		TracyAllocN(block, page->BlockSize, Memory::CategoryNames[MemCat]);
+	else
+		TracyAlloc(block, page->BlockSize);
+#endif
+
+	return block;
+}
+
+static void poolFree(PoolPage* Page, void* Pointer)
+{
+	ThreadCache* cache = t_Cache;
+
+#ifdef TRACY_ENABLE
+	if (Page->Category != static_cast<uint8_t>(Memory::Category::Default))
+		TracyFreeN(Pointer, Memory::CategoryNames[Page->Category]);
+	else
+		TracyFree(Pointer);
+#endif
+
+	countFree(cache, Page->Category, Page->BlockSize);
+
+	if (Page->Owner == cache)
+		localFree(cache, Page, Pointer);
+	else
+		pushRemoteFree(Page->Owner, Pointer);
+}
 
 void* Memory::GetPointerInfo(void* Pointer, uint32_t* Size, uint8_t* Category)
 {
+	if (PoolPage* page = findPoolPage(Pointer))
+	{
+		if (Size)
+			*Size = page->BlockSize;
+		if (Category)
+			*Category = page->Category;
+
+		return Pointer;
+	}
+
 	AllocHeader* header = (AllocHeader*)((uintptr_t)Pointer - sizeof(AllocHeader));
 	void* realPointer = (void*)((uintptr_t)header);
 
@@ -80,13 +641,17 @@ void* Memory::Alloc(uint32_t Size, Memory::Category MemCat)
 	if (Size == 0)
 		Size = 1;
 
+	uint8_t memIndex = static_cast<uint8_t>(MemCat);
+	ThreadCache* cache = getThreadCache();
+
+	if (Size <= POOL_MAX_SIZE && cache)
+		return poolAlloc(cache, Size, memIndex);
+
 	Size += sizeof(AllocHeader);
 	void* ptr = malloc(Size);
 
 	if (ptr)
 	{
-		uint8_t memIndex = static_cast<uint8_t>(MemCat);
-
 #ifdef TRACY_ENABLE
 		if (MemCat != Memory::Category::Default)
 			TracyAllocN(ptr, Size, CategoryNames[memIndex]);
@@ -94,8 +659,7 @@ void* Memory::Alloc(uint32_t Size, Memory::Category MemCat)
 			TracyAlloc(ptr, Size);
 #endif
 
-		Counters[memIndex].fetch_add(Size, std::memory_order_relaxed);
-		s_ActivityWip[memIndex].fetch_add(Size, std::memory_order_relaxed);
+		countAlloc(cache, memIndex, Size);
 
 		*(AllocHeader*)ptr = { .Size = Size, .Category = memIndex };
 
@@ -116,17 +680,39 @@ void* Memory::ReAlloc(void* Pointer, uint32_t Size, Memory::Category MemCat)
 	if (Pointer == nullptr)
 		return Alloc(Size, MemCat);
 
-	Size += sizeof(AllocHeader);
-
 	uint8_t memIndex = static_cast<uint8_t>(MemCat);
 
 	uint32_t prevSize = UINT32_MAX;
 	uint8_t prevMemCat = 0;
-	Pointer = GetPointerInfo(Pointer, &prevSize, &prevMemCat);
+	void* realPointer = GetPointerInfo(Pointer, &prevSize, &prevMemCat);
 
 	if (prevMemCat != memIndex)
 		throw std::runtime_error("Tried to `::ReAlloc` into a different memory category");
 
+	const bool wasPooled = realPointer == Pointer;
+	const uint32_t prevUsableSize = wasPooled ? prevSize : prevSize - (uint32_t)sizeof(AllocHeader);
+
+	// still the same size class, nothing to do
+	if (wasPooled && Size <= POOL_MAX_SIZE && sizeToClass(Size) == pageOf(Pointer)->SizeClass)
+		return Pointer;
+
+	// moving between the pools and `malloc`
+	if (wasPooled || Size <= POOL_MAX_SIZE)
+	{
+		void* newPointer = Alloc(Size, MemCat);
+
+		if (newPointer)
+		{
+			memcpy(newPointer, Pointer, std::min(Size, prevUsableSize));
+			Free(Pointer);
+		}
+
+		return newPointer;
+	}
+
+	Size += sizeof(AllocHeader);
+	Pointer = realPointer;
+
 	// stupid g++ with stupid "may be used after `void* realloc"
 	// SHUT UP
 	// I KNOW WHAT I'M DOING
@@ -151,9 +737,9 @@ void* Memory::ReAlloc(void* Pointer, uint32_t Size, Memory::Category MemCat)
 			TracyAlloc(ptr, Size);
 #endif
 
-		Counters[memIndex].fetch_sub(prevSize, std::memory_order_relaxed);
-		Counters[memIndex].fetch_add(Size, std::memory_order_relaxed);
-		s_ActivityWip[memIndex].fetch_add(prevSize + Size, std::memory_order_relaxed);
+		ThreadCache* cache = getThreadCache();
+		countFree(cache, memIndex, prevSize);
+		countAlloc(cache, memIndex, Size);
 
 		*(AllocHeader*)ptr = { .Size = Size, .Category = memIndex };
 
@@ -169,6 +755,12 @@ void Memory::Free(void* Pointer)
 	if (!Pointer)
 		return;
 
+	if (PoolPage* page = findPoolPage(Pointer))
+	{
+		poolFree(page, Pointer);
+		return;
+	}
+
 	uint32_t size = UINT32_MAX;
 	uint8_t memcat = UINT8_MAX;
 
@@ -183,20 +775,42 @@ void Memory::Free(void* Pointer)
 		TracyFree(Pointer);
 #endif
 
-	assert(Counters[memcat] > 0);
-	Counters[memcat].fetch_sub(size, std::memory_order_relaxed);
-	Activity[memcat].fetch_add(size, std::memory_order_relaxed);
+	countFree(t_Cache, memcat, size);
 
 	free(Pointer);
 }
 
 void Memory::FrameFinish()
 {
-	for (size_t i = 0; i < Activity.size(); i++)
+	std::array<uint64_t, static_cast<size_t>(Memory::Category::count)> allocated{ 0 };
+	std::array<uint64_t, static_cast<size_t>(Memory::Category::count)> freed{ 0 };
+
+	auto sumStats = [&allocated, &freed](const std::array<CategoryStats, static_cast<size_t>(Memory::Category::count)>& Stats)
 	{
-		Activity[i] = s_ActivityWip[i].load();
-		s_ActivityWip[i] = 0;
+		for (size_t i = 0; i < Stats.size(); i++)
+		{
+			allocated[i] += Stats[i].Allocated.load(std::memory_order_relaxed);
+			freed[i] += Stats[i].Freed.load(std::memory_order_relaxed);
+		}
+	};
+
+	for (ThreadCache* cache = s_CacheRegistry.load(std::memory_order_acquire); cache; cache = cache->NextInRegistry)
+		sumStats(cache->Stats);
+
+	sumStats(s_UncachedStats);
+
+	for (size_t i = 0; i < Counters.size(); i++)
+	{
+		// blocks can be freed by a different thread than the one that allocated them,
+		// so any one thread's `Freed` can be above its `Allocated`, but never the total
+		Counters[i] = allocated[i] >= freed[i] ? allocated[i] - freed[i] : 0;
+
+		uint64_t activityTotal = allocated[i] + freed[i];
+		Activity[i] = activityTotal - s_PrevActivityTotals[i];
+		s_PrevActivityTotals[i] = activityTotal;
 	}
+
+	resetFrameArena();
 }
 
 void* operator new(size_t size)
@@ -3,6 +3,7 @@
 #define GLM_ENABLE_EXPERIMENTAL
 
 #include <glm/gtx/euler_angles.hpp>
+#include <deque>
 
 #include "Reflection.hpp"
 #include "datatype/GameObject.hpp"
@@ -437,6 +438,19 @@ std::string_view Reflection::GenericValue::AsStringView() const
     }
 }
 
+std::string_view Reflection::GenericValue::AsBufferView() const
+{
+    if (Type != ValueType::Buffer)
+        WRONG_TYPE();
+    else
+    {
+        if (Size + 1 > REFLECTION_GV_SSO)
+            return std::string_view(Val.Str, Size);
+        else
+            return std::string_view(Val.StrSso, Size);
+    }
+}
+
 bool Reflection::GenericValue::AsBoolean() const
 {
     return Type == ValueType::Boolean
@@ -744,30 +758,59 @@ void Reflection::EventCleanup(std::vector<EventConnection>& Callbacks)
     }
 }
 
-void Reflection::SignalEvent(const std::vector<EventConnection>& Connections, const std::vector<GenericValue>& Arguments, const std::string_view Name)
+// callbacks can fire events of their own, so each level of nesting copies into its own
+// list. They're kept for the next event to reach that depth, rather than using frame memory,
+// which a Script firing events in a loop would grow until the end of the frame. A `deque`,
+// so lists further up the stack stay where they are as it grows
+static thread_local std::deque<std::vector<Reflection::EventConnection>> t_DispatchLists;
+static thread_local size_t t_DispatchDepth = 0;
+
+static void dispatchEvent(const std::vector<Reflection::EventConnection>& Connections, const std::vector<Reflection::GenericValue>& Arguments, uint32_t From)
 {
-    ZoneScoped;
-    ZoneText(Name.data(), Name.size());
+    if (t_DispatchDepth == t_DispatchLists.size())
+        t_DispatchLists.emplace_back();
 
-    const std::vector<Reflection::EventConnection> dispatching = Connections;
+    // copied in case a callback (dis)connects
+    std::vector<Reflection::EventConnection>& dispatching = t_DispatchLists[t_DispatchDepth];
+    dispatching.assign(Connections.begin(), Connections.end());
+
+    struct DepthGuard
+    {
+        std::vector<Reflection::EventConnection>& List;
+
+        DepthGuard(std::vector<Reflection::EventConnection>& L)
+            : List(L)
+        {
+            t_DispatchDepth++;
+        }
+        ~DepthGuard()
+        {
+            // drop the callbacks' captures now, but keep the capacity
+            List.clear();
+            t_DispatchDepth--;
+        }
+    } guard{ dispatching };
 
     for (uint32_t id = 0; id < (uint32_t)dispatching.size(); id++)
     {
         if (const Reflection::EventCallbackFunction& callback = dispatching[id].Callback)
-            callback(Arguments, id, UINT32_MAX);
+            callback(Arguments, id, From);
     }
 }
 
-void Reflection::SignalRestrictedEvent(uint32_t From, const std::vector<EventConnection>& Connections, const std::vector<GenericValue>& Arguments, const std::string_view Name)
+void Reflection::SignalEvent(const std::vector<EventConnection>& Connections, const std::vector<GenericValue>& Arguments, const std::string_view Name)
 {
     ZoneScoped;
     ZoneText(Name.data(), Name.size());
 
-    const std::vector<Reflection::EventConnection> dispatching = Connections;
+    dispatchEvent(Connections, Arguments, UINT32_MAX);
+}
 
-    for (uint32_t id = 0; id < (uint32_t)dispatching.size(); id++)
-    {
-        if (const Reflection::EventCallbackFunction& callback = dispatching[id].Callback)
-            callback(Arguments, id, From);
-    }
+void Reflection::SignalRestrictedEvent(uint32_t From, const std::vector<EventConnection>& Connections, const std::vector<GenericValue>& Arguments, const std::string_view Name)
+{
+    ZoneScoped;
+    ZoneText(Name.data(), Name.size());
+
+    dispatchEvent(Connections, Arguments, From);
+}
 }
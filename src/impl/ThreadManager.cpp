@@ -5,6 +5,10 @@
 
 #include <tracy/Tracy.hpp>
 #include <format>
+#include <random>
+#include <fstream>
+#include <bit>
+#include <set>
 #include <assert.h>
 
 #include "ThreadManager.hpp"
@@ -74,6 +78,8 @@ static void SetThreadName( const char* threadName)
 
 #elif defined(__linux__)
 #include <sys/prctl.h>
+#include <pthread.h>
+#include <sched.h>
 static void SetThreadName( const char* threadName)
 {
   prctl(PR_SET_NAME,threadName,0,0,0);
@@ -89,107 +95,672 @@ static void SetThreadName(std::thread* thread, const char* threadName)
 
 static ThreadManager* s_Instance;
 
-const char* const s_WorkerFiberNames[] = {
-	"Phoenix1",
-	"Phoenix2",
-	"Phoenix3",
-	"Phoenix4",
-	"Phoenix5",
-	"Phoenix6",
-	"Phoenix7",
-	"Phoenix8"
+// first logical CPU of each physical core, empty if we couldn't find out
+static std::vector<uint32_t> getPhysicalCores()
+{
+	std::vector<uint32_t> cores;
+
+#if defined(_WIN32)
+
+	DWORD length = 0;
+	GetLogicalProcessorInformationEx(RelationProcessorCore, nullptr, &length);
+
+	if (GetLastError() != ERROR_INSUFFICIENT_BUFFER)
+		return cores;
+
+	std::vector<uint8_t> buffer(length);
+
+	if (!GetLogicalProcessorInformationEx(RelationProcessorCore, (PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX)buffer.data(), &length))
+		return cores;
+
+	for (DWORD offset = 0; offset < length;)
+	{
+		const SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX* info = (PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX)(buffer.data() + offset);
+
+		// `SetThreadAffinityMask` only reaches the first processor group
+		if (info->Processor.GroupMask[0].Group == 0 && info->Processor.GroupMask[0].Mask != 0)
+			cores.push_back((uint32_t)std::countr_zero((uint64_t)info->Processor.GroupMask[0].Mask));
+
+		offset += info->Size;
+	}
+
+#elif defined(__linux__)
+
+	std::set<std::pair<int, int>> seen;
+
+	for (uint32_t cpu = 0; cpu < std::thread::hardware_concurrency(); cpu++)
+	{
+		std::string topologyDir = std::format("/sys/devices/system/cpu/cpu{}/topology/", cpu);
+		std::ifstream coreIdFile(topologyDir + "core_id");
+		std::ifstream packageIdFile(topologyDir + "physical_package_id");
+
+		int coreId = -1;
+		int packageId = -1;
+
+		if (!(coreIdFile >> coreId) || !(packageIdFile >> packageId))
+			return {};
+
+		// SMT siblings share a core and package id, keep the first of each
+		if (seen.insert({ packageId, coreId }).second)
+			cores.push_back(cpu);
+	}
+
+#endif
+
+	return cores;
+}
+
+static void pinCurrentThread(uint32_t Cpu)
+{
+#if defined(_WIN32)
+	if (Cpu < 64 && SetThreadAffinityMask(GetCurrentThread(), 1ull << Cpu) == 0)
+		Log.WarningF("Failed to pin thread to CPU {}", Cpu);
+
+#elif defined(__linux__)
+	cpu_set_t set;
+	CPU_ZERO(&set);
+	CPU_SET(Cpu, &set);
+
+	if (pthread_setaffinity_np(pthread_self(), sizeof(set), &set) != 0)
+		Log.WarningF("Failed to pin thread to CPU {}", Cpu);
+
+#else
+	(void)Cpu;
+#endif
+}
+
+// index into `m_WorkerStates` if the current thread is a worker, -1 otherwise
+static thread_local int64_t t_WorkerIndex = -1;
+static thread_local ThreadManager* t_WorkerOwner = nullptr;
+
+// 02/02/2026
+// Chase-Lev work-stealing deque, the owning worker pushes and pops at the bottom,
+// other workers steal from the top
+// "Correct and Efficient Work-Stealing for Weak Memory Models", Lê et al. 2013
+template <class T>
+class WorkStealingDeque
+{
+public:
+	WorkStealingDeque()
+		: m_Ring(new Ring(256))
+	{
+	}
+
+	~WorkStealingDeque()
+	{
+		delete m_Ring.load(std::memory_order_relaxed);
+
+		for (Ring* ring : m_Retired)
+			delete ring;
+	}
+
+	// owner only
+	void Push(T* Item)
+	{
+		int64_t bottom = m_Bottom.load(std::memory_order_relaxed);
+		int64_t top = m_Top.load(std::memory_order_acquire);
+		Ring* ring = m_Ring.load(std::memory_order_relaxed);
+
+		if (bottom - top > ring->Capacity - 1)
+			ring = m_Grow(ring, bottom, top);
+
+		ring->Put(bottom, Item);
+		std::atomic_thread_fence(std::memory_order_release);
+		m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+	}
+
+	// owner only
+	T* Pop()
+	{
+		int64_t bottom = m_Bottom.load(std::memory_order_relaxed) - 1;
+		Ring* ring = m_Ring.load(std::memory_order_relaxed);
+		m_Bottom.store(bottom, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		int64_t top = m_Top.load(std::memory_order_relaxed);
+
+		if (top > bottom)
+		{
+			m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+			return nullptr;
+		}
+
+		T* item = ring->Get(bottom);
+
+		if (top == bottom)
+		{
+			// last item, race against thieves for it
+			if (!m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+				item = nullptr;
+
+			m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+		}
+
+		return item;
+	}
+
+	// any thread
+	T* Steal()
+	{
+		int64_t top = m_Top.load(std::memory_order_acquire);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		int64_t bottom = m_Bottom.load(std::memory_order_acquire);
+
+		if (top >= bottom)
+			return nullptr;
+
+		Ring* ring = m_Ring.load(std::memory_order_acquire);
+		T* item = ring->Get(top);
+
+		if (!m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+			return nullptr;
+
+		return item;
+	}
+
+	bool IsEmpty() const
+	{
+		return m_Bottom.load(std::memory_order_relaxed) <= m_Top.load(std::memory_order_relaxed);
+	}
+
+private:
+	struct Ring
+	{
+		Ring(int64_t Cap)
+			: Capacity(Cap),
+			Slots(new std::atomic<T*>[Cap])
+		{
+			assert((Capacity & (Capacity - 1)) == 0);
+		}
+
+		T* Get(int64_t Index)
+		{
+			return Slots[Index & (Capacity - 1)].load(std::memory_order_relaxed);
+		}
+
+		void Put(int64_t Index, T* Item)
+		{
+			Slots[Index & (Capacity - 1)].store(Item, std::memory_order_relaxed);
+		}
+
+		int64_t Capacity;
+		std::unique_ptr<std::atomic<T*>[]> Slots;
+	};
+
+	Ring* m_Grow(Ring* Old, int64_t Bottom, int64_t Top)
+	{
+		Ring* grown = new Ring(Old->Capacity * 2);
+
+		for (int64_t i = Top; i < Bottom; i++)
+			grown->Put(i, Old->Get(i));
+
+		// thieves may still be reading from the old ring
+		m_Retired.push_back(Old);
+		m_Ring.store(grown, std::memory_order_release);
+
+		return grown;
+	}
+
+	alignas(64) std::atomic<int64_t> m_Top = 0;
+	alignas(64) std::atomic<int64_t> m_Bottom = 0;
+	std::atomic<Ring*> m_Ring;
+	std::vector<Ring*> m_Retired;
 };
 
+struct ThreadManager::WorkerState
+{
+	WorkStealingDeque<Task> Deque;
+};
+
+ThreadManager::TaskGroup::~TaskGroup()
+{
+	// make sure whoever finished the last task has let go of us
+	std::unique_lock<std::mutex> lock = std::unique_lock<std::mutex>(m_ContinuationsMutex);
+	assert(m_Pending == 0);
+}
+
+bool ThreadManager::TaskGroup::IsDone() const
+{
+	return m_Pending.load() == 0;
+}
+
+static uint32_t randomWorker(uint32_t NumWorkers)
+{
+	static thread_local std::minstd_rand Rng{ std::random_device{}() };
+	return (uint32_t)(Rng() % NumWorkers);
+}
+
+ThreadManager::ThreadManager() = default;
+
 // 09/05/2025
 // https://www.geeksforgeeks.org/thread-pool-in-cpp/
-void ThreadManager::Initialize(int NumThreadsOverride)
+void ThreadManager::Initialize(const PoolConfiguration& Configuration)
 {
 	ZoneScoped;
 
-	size_t numThreads = static_cast<size_t>(std::max((float)std::thread::hardware_concurrency() * 0.75f, 3.f));
-	numThreads = std::min(numThreads, static_cast<size_t>(8ull));
+	const std::vector<uint32_t> physicalCores = getPhysicalCores();
+	const size_t numLogical = std::max(std::thread::hardware_concurrency(), 1u);
+
+	// one worker per physical core, minus the main thread's. SMT siblings mostly
+	// compete for the same execution units and don't buy us much
+	size_t numThreads = physicalCores.empty()
+							? static_cast<size_t>((float)numLogical * 0.75f)
+							: physicalCores.size() - 1;
+	numThreads = std::max(numThreads, static_cast<size_t>(3ull));
+
+	// I/O workers spend most of their time blocked, so they aren't tied to the core count
+	size_t numIoThreads = std::clamp(numLogical / 4, static_cast<size_t>(2ull), static_cast<size_t>(8ull));
+
+	if (Configuration.ComputeThreads > -1)
+		numThreads = static_cast<size_t>(Configuration.ComputeThreads);
+	if (Configuration.IoThreads > -1)
+		numIoThreads = static_cast<size_t>(Configuration.IoThreads);
 
-	if (NumThreadsOverride > -1)
-		numThreads = static_cast<size_t>(NumThreadsOverride);
+	bool pin = Configuration.PinComputeThreads.value_or(false);
+
+	if (pin && physicalCores.empty())
+	{
+		Log.Warning("Compute worker pinning was requested, but the CPU topology could not be determined. Workers will not be pinned");
+		pin = false;
+	}
 
-	Log.InfoF("Creating {} parallel threads...", numThreads);
+	Log.InfoF(
+		"Creating {} compute threads{} and {} I/O threads...",
+		numThreads, pin ? " (pinned)" : "", numIoThreads
+	);
 	Concurrency = (int)numThreads;
+	IoConcurrency = (int)numIoThreads;
+
+	s_Instance = this;
+
+	// all deques must exist before any worker may try to steal from them
+	m_WorkerStates.reserve(numThreads);
+	m_WorkerNames.reserve(numThreads);
+	for (size_t i = 0; i < numThreads; i++)
+	{
+		m_WorkerStates.push_back(std::make_unique<WorkerState>());
+		m_WorkerNames.push_back(std::format("Phoenix{}", i + 1));
+	}
+
+	m_IoWorkerNames.reserve(numIoThreads);
+	for (size_t i = 0; i < numIoThreads; i++)
+		m_IoWorkerNames.push_back(std::format("PhoenixIo{}", i + 1));
 
 	for (size_t i = 0; i < numThreads; i++)
 	{
+		std::optional<uint32_t> cpu;
+
+		// leave the first core for the main thread
+		if (pin)
+			cpu = physicalCores[(i + 1) % physicalCores.size()];
+
 		m_Workers.emplace_back(
+			[this, i, cpu]
+			{
+				m_WorkerMain(i, cpu);
+			}
+		);
+	}
+
+	for (size_t i = 0; i < numIoThreads; i++)
+		m_IoWorkers.emplace_back(
 			[this, i]
 			{
-				TracyFiberEnter(s_WorkerFiberNames[i]);
-				SetThreadName(s_WorkerFiberNames[i]);
-				// thread-local
-				Log.ContextExtraTags = std::format("LogContext:{}", s_WorkerFiberNames[i]);
+				m_IoWorkerMain(i);
+			}
+		);
 
-				while (true)
-				{
-					Task task;
+	Log.Info("ThreadManager initialized");
+}
+
+void ThreadManager::m_WorkerMain(size_t WorkerIndex, std::optional<uint32_t> PinToCpu)
+{
+	const char* name = m_WorkerNames[WorkerIndex].c_str();
 
-					{
-						std::unique_lock<std::mutex> lock = std::unique_lock<std::mutex>(m_TasksMutex);
+	TracyFiberEnter(name);
+	SetThreadName(name);
+	// thread-local
+	Log.ContextExtraTags = std::format("LogContext:{}", name);
 
-						m_TasksCv.wait(
-							lock,
-							[this]
-							{
-								return !m_Tasks.empty() || m_Stop;
-							}
-						);
+	if (PinToCpu)
+		pinCurrentThread(*PinToCpu);
+
+	t_WorkerIndex = (int64_t)WorkerIndex;
+	t_WorkerOwner = this;
+
+	while (true)
+	{
+		// read the epoch *before* looking for work, so that anything submitted
+		// after we've looked makes the `wait` below return immediately
+		uint32_t epoch = m_WorkEpoch.load();
+
+		if (Task* task = m_FindTask(WorkerIndex))
+		{
+			m_RunTask(task);
+			continue;
+		}
+
+		// every queue we can see is empty, and nothing new can be injected once stopping
+		if (m_Stop.load())
+			break;
+
+		m_NumSleeping++;
+		m_WorkEpoch.wait(epoch);
+		m_NumSleeping--;
+	}
+
+	t_WorkerIndex = -1;
+	t_WorkerOwner = nullptr;
+
+	TracyFiberLeave;
+}
 
-						if (m_Stop && m_Tasks.empty())
-						{
-							TracyFiberLeave;
-							return;
-						}
+void ThreadManager::m_IoWorkerMain(size_t WorkerIndex)
+{
+	const char* name = m_IoWorkerNames[WorkerIndex].c_str();
 
-						task = std::move(m_Tasks.front());
-						m_Tasks.pop();
+	TracyFiberEnter(name);
+	SetThreadName(name);
+	// thread-local
+	Log.ContextExtraTags = std::format("LogContext:{}", name);
 
-						if (m_Stop && !task.IsCritical)
-							continue;
-					}
+	while (true)
+	{
+		Task* task = nullptr;
+		bool shouldRun = false;
 
-					ZoneScopedN("Task");
-					ZoneText(task.Name.data(), task.Name.size());
+		{
+			std::unique_lock<std::mutex> lock = std::unique_lock<std::mutex>(m_IoTasksMutex);
 
-					task.Function();
+			m_IoTasksCv.wait(
+				lock,
+				[this]
+				{
+					return !m_IoTasks.empty() || m_IoStop;
 				}
+			);
+
+			if (m_IoStop && m_IoTasks.empty())
+				break;
+
+			task = m_IoTasks.front();
+			m_IoTasks.pop();
+
+			// decided here, `m_IoStop` is only written under the lock
+			shouldRun = !m_IoStop || task->IsCritical;
+		}
+
+		if (shouldRun)
+		{
+			ZoneScopedN("IoTask");
+			ZoneText(task->Name.data(), task->Name.size());
+
+			task->Function();
+		}
 
-				TracyFiberLeave;
+		delete task;
+	}
+
+	TracyFiberLeave;
+}
+
+ThreadManager::Task* ThreadManager::m_FindTask(size_t WorkerIndex)
+{
+	if (Task* task = m_WorkerStates[WorkerIndex]->Deque.Pop())
+		return task;
+
+	if (m_InjectedCount.load() > 0)
+	{
+		std::unique_lock<std::mutex> lock = std::unique_lock<std::mutex>(m_InjectedMutex);
+
+		for (std::deque<Task*>& queue : m_Injected)
+			if (!queue.empty())
+			{
+				Task* task = queue.front();
+				queue.pop_front();
+				m_InjectedCount--;
+
+				return task;
 			}
-		);
 	}
 
-	s_Instance = this;
+	const uint32_t numWorkers = (uint32_t)m_WorkerStates.size();
+	const uint32_t start = randomWorker(numWorkers);
 
-	Log.Info("ThreadManager initialized");
+	for (uint32_t i = 0; i < numWorkers; i++)
+	{
+		uint32_t victim = (start + i) % numWorkers;
+
+		if (victim == WorkerIndex)
+			continue;
+
+		if (Task* task = m_WorkerStates[victim]->Deque.Steal())
+			return task;
+	}
+
+	return nullptr;
+}
+
+ThreadManager::Task* ThreadManager::m_FindGroupTask(TaskGroup& Group)
+{
+	// anything on our own deque was most likely spawned by whatever we're waiting on
+	if (t_WorkerOwner == this && t_WorkerIndex >= 0)
+		if (Task* task = m_WorkerStates[t_WorkerIndex]->Deque.Pop())
+			return task;
+
+	// don't pick up unrelated work from the injection queues, it could be
+	// arbitrarily long and stall whoever is waiting (usually the main thread)
+	if (m_InjectedCount.load() > 0)
+	{
+		std::unique_lock<std::mutex> lock = std::unique_lock<std::mutex>(m_InjectedMutex);
+
+		for (std::deque<Task*>& queue : m_Injected)
+			for (auto it = queue.begin(); it != queue.end(); ++it)
+				if ((*it)->Group == &Group)
+				{
+					Task* task = *it;
+					queue.erase(it);
+					m_InjectedCount--;
+
+					return task;
+				}
+	}
+
+	return nullptr;
+}
+
+void ThreadManager::m_RunTask(Task* Item)
+{
+	if (!m_Stop.load() || Item->IsCritical)
+	{
+		ZoneScopedN("Task");
+		ZoneText(Item->Name.data(), Item->Name.size());
+
+		Item->Function();
+	}
+
+	TaskGroup* group = Item->Group;
+	delete Item;
+
+	if (group)
+		m_CompleteOne(*group);
+}
+
+void ThreadManager::m_CompleteOne(TaskGroup& Group)
+{
+	std::vector<Task*> continuations;
+
+	{
+		std::unique_lock<std::mutex> lock = std::unique_lock<std::mutex>(Group.m_ContinuationsMutex);
+
+		if (Group.m_Pending.fetch_sub(1) == 1)
+		{
+			continuations.swap(Group.m_Continuations);
+			Group.m_Pending.notify_all();
+		}
+	}
+
+	for (Task* continuation : continuations)
+		m_Submit(continuation);
+}
+
+void ThreadManager::m_WakeWorkers(bool All)
+{
+	m_WorkEpoch++;
+
+	if (m_NumSleeping.load() == 0)
+		return;
+
+	if (All)
+		m_WorkEpoch.notify_all();
+	else
+		m_WorkEpoch.notify_one();
 }
 
-void ThreadManager::Dispatch(const std::string_view& Name, std::function<void()> Task, bool IsCritical)
+void ThreadManager::m_Submit(Task* Item)
+{
+	if (t_WorkerOwner == this && t_WorkerIndex >= 0)
+		m_WorkerStates[t_WorkerIndex]->Deque.Push(Item);
+	else
+	{
+		std::unique_lock<std::mutex> lock = std::unique_lock<std::mutex>(m_InjectedMutex);
+		m_Injected[(size_t)Item->Priority].push_back(Item);
+		m_InjectedCount++;
+	}
+
+	m_WakeWorkers(false);
+}
+
+void ThreadManager::Dispatch(
+	const std::string_view& Name,
+	std::function<void()> Function,
+	bool IsCritical,
+	TaskPriority Priority,
+	TaskGroup* Group,
+	TaskGroup* After
+)
 {
 	assert(s_Instance == this);
-	assert(!m_Stop);
+	assert(!m_Stop || t_WorkerOwner == this);
 
 	if (m_Workers.size() == 0)
 	{
-		Task();
+		// everything runs inline, so `After` is always done already
+		assert(!After || After->IsDone());
+		Function();
 		return;
 	}
 
+	Task* task = new Task{
+		.Function = std::move(Function),
+		.Name = Name,
+		.Group = Group,
+		.Priority = Priority,
+		.IsCritical = IsCritical
+	};
+
+	if (Group)
+		Group->m_Pending++;
+
+	if (After)
 	{
-		std::unique_lock<std::mutex> lock = std::unique_lock<std::mutex>(m_TasksMutex);
-		m_Tasks.push({
-			.Function = std::move(Task),
+		std::unique_lock<std::mutex> lock = std::unique_lock<std::mutex>(After->m_ContinuationsMutex);
+
+		if (After->m_Pending.load() != 0)
+		{
+			After->m_Continuations.push_back(task);
+			return;
+		}
+	}
+
+	m_Submit(task);
+}
+
+void ThreadManager::DispatchIo(const std::string_view& Name, std::function<void()> Function, bool IsCritical)
+{
+	assert(s_Instance == this);
+	assert(!m_IoStop);
+
+	if (m_IoWorkers.size() == 0)
+	{
+		Function();
+		return;
+	}
+
+	{
+		std::unique_lock<std::mutex> lock = std::unique_lock<std::mutex>(m_IoTasksMutex);
+		m_IoTasks.push(new Task{
+			.Function = std::move(Function),
 			.Name = Name,
-			.IsCritical = IsCritical,
+			.IsCritical = IsCritical
 		});
 	}
 
-	m_TasksCv.notify_one();
+	m_IoTasksCv.notify_one();
+}
+
+void ThreadManager::Wait(TaskGroup& Group)
+{
+	ZoneScoped;
+
+	while (uint32_t pending = Group.m_Pending.load())
+	{
+		if (Task* task = m_FindGroupTask(Group))
+		{
+			m_RunTask(task);
+			continue;
+		}
+
+		Group.m_Pending.wait(pending);
+	}
+
+	// the last task to finish might still be holding the lock
+	std::unique_lock<std::mutex> lock = std::unique_lock<std::mutex>(Group.m_ContinuationsMutex);
+}
+
+void ThreadManager::ParallelFor(
+	const std::string_view& Name,
+	size_t Begin,
+	size_t End,
+	size_t Grain,
+	const std::function<void(size_t, size_t)>& Body,
+	TaskPriority Priority
+)
+{
+	ZoneScoped;
+
+	if (Begin >= End)
+		return;
+
+	Grain = std::max(Grain, (size_t)1);
+
+	// no point splitting it up if there's nobody to share it with
+	if (m_Workers.size() == 0 || End - Begin <= Grain)
+	{
+		Body(Begin, End);
+		return;
+	}
+
+	TaskGroup group;
+
+	for (size_t chunk = Begin + Grain; chunk < End; chunk += Grain)
+	{
+		size_t chunkEnd = std::min(chunk + Grain, End);
+
+		Dispatch(
+			Name,
+			[&Body, chunk, chunkEnd]()
+			{
+				Body(chunk, chunkEnd);
+			},
+			true,
+			Priority,
+			&group
+		);
+	}
+
+	Body(Begin, std::min(Begin + Grain, End));
+
+	Wait(group);
 }
 
 void ThreadManager::m_StopThreads()
@@ -197,12 +768,29 @@ void ThreadManager::m_StopThreads()
 	ZoneScoped;
 
 	{
-		std::unique_lock<std::mutex> lock = std::unique_lock<std::mutex>(m_TasksMutex);
-		m_Stop = true;
+		std::unique_lock<std::mutex> lock = std::unique_lock<std::mutex>(m_IoTasksMutex);
+		m_IoStop = true;
 	}
 
-	m_TasksCv.notify_all();
+	m_IoTasksCv.notify_all();
+	m_IoWorkers.clear();
+
+	m_Stop = true;
+	m_WakeWorkers(true);
+
 	m_Workers.clear();
+
+	// only possible if there were never any workers to run them
+	for (std::deque<Task*>& queue : m_Injected)
+	{
+		for (Task* task : queue)
+			m_RunTask(task);
+
+		queue.clear();
+	}
+
+	m_InjectedCount = 0;
+	m_WorkerStates.clear();
 }
 
 void ThreadManager::Shutdown()
@@ -349,10 +349,13 @@ void MeshProvider::Shutdown()
     for (GpuMesh& gpuMesh : m_GpuMeshes)
         gpuMesh.Delete();
 
+    std::unique_lock<std::mutex> lock = std::unique_lock<std::mutex>(m_MeshesMutex);
+
     m_Meshes.clear();
     m_StringToMeshId.clear();
     m_LoadingRequests.clear();
     m_GpuMeshes.clear();
+    m_TriangleBvhs.clear();
 
     s_Instance = nullptr;
 }
@@ -801,6 +804,9 @@ static void finishAndUploadMesh(Mesh& mesh, MeshProvider::GpuMesh& gpuMesh, bool
 
 uint32_t MeshProvider::Assign(Mesh mesh, const std::string& InternalName, bool UploadToGpu)
 {
+    // uploading can shrink the vertex and index arrays, so that's done under the lock too
+    std::unique_lock<std::mutex> lock = std::unique_lock<std::mutex>(m_MeshesMutex);
+
     uint32_t assignedId = static_cast<uint32_t>(m_Meshes.size());
 
     auto prevPair = m_StringToMeshId.find(InternalName);
@@ -812,6 +818,7 @@ uint32_t MeshProvider::Assign(Mesh mesh, const std::string& InternalName, bool U
 
         m_Meshes[prevPair->second] = mesh;
         assignedId = prevPair->second;
+        m_TriangleBvhs.erase(assignedId);
 
         if (preExisting.GpuId != UINT32_MAX)
         {
@@ -864,7 +871,10 @@ uint32_t MeshProvider::LoadFromPath(
                 if (loadRequest.ResourceId != meshIt->second)
                     continue;
 
-                m_Meshes[meshIt->second].MeshDataPreserved = true;
+                {
+                    std::unique_lock<std::mutex> lock = std::unique_lock<std::mutex>(m_MeshesMutex);
+                    m_Meshes[meshIt->second].MeshDataPreserved = true;
+                }
 
                 loadRequest.Future.wait();
                 this->FinalizeAsyncLoadedMeshes();
@@ -886,9 +896,12 @@ uint32_t MeshProvider::LoadFromPath(
             std::promise<Mesh>* promise = new std::promise<Mesh>;
 
             uint32_t resourceId = this->Assign(Mesh{}, Path);
-            m_Meshes.at(resourceId).MeshDataPreserved = PreserveMeshData;
+            {
+                std::unique_lock<std::mutex> lock = std::unique_lock<std::mutex>(m_MeshesMutex);
+                m_Meshes.at(resourceId).MeshDataPreserved = PreserveMeshData;
+            }
 
-            ThreadManager::Get()->Dispatch(
+            ThreadManager::Get()->DispatchIo(
                 "AsyncMeshLoad",
                 [promise, this, Path]()
                 {
@@ -989,6 +1002,50 @@ MeshProvider::GpuMesh& MeshProvider::GetGpuMesh(uint32_t Id)
     return m_GpuMeshes.at(Id);
 }
 
+std::shared_ptr<const TriangleBvh> MeshProvider::GetTriangleBvh(uint32_t Id)
+{
+    std::shared_ptr<TriangleBvhSlot> slot;
+
+    {
+        std::unique_lock<std::mutex> lock = std::unique_lock<std::mutex>(m_MeshesMutex);
+
+        if (auto it = m_TriangleBvhs.find(Id); it != m_TriangleBvhs.end())
+            slot = it->second;
+        else
+        {
+            const Mesh& mesh = m_Meshes.at(Id);
+
+            // still loading, it'll be built once it's here
+            if (mesh.Indices.empty())
+                return nullptr;
+
+            // copied, as the mesh can be replaced as soon as the lock is let go of
+            slot = std::make_shared<TriangleBvhSlot>();
+            slot->Triangles.Vertices = mesh.Vertices;
+            slot->Triangles.Indices = mesh.Indices;
+
+            m_TriangleBvhs.emplace(Id, slot);
+        }
+    }
+
+    // the build takes a while for a big mesh, so it isn't done under the lock, which would hold up
+    // every other mesh. Anything asking for this one in the meantime waits for it here instead
+    std::call_once(slot->Built, [&slot]()
+    {
+        // shared, so that replacing the mesh doesn't free it from under a `Gjk::Shape` on another thread
+        slot->Bvh = std::make_shared<const TriangleBvh>(TriangleBvh::s_FromMesh(slot->Triangles));
+        slot->Triangles = Mesh();
+    });
+
+    return slot->Bvh->IsEmpty() ? nullptr : slot->Bvh;
+}
+
+void MeshProvider::ReadMesh(uint32_t Id, const std::function<void(const Mesh&)>& Reader)
+{
+    std::unique_lock<std::mutex> lock = std::unique_lock<std::mutex>(m_MeshesMutex);
+    Reader(m_Meshes.at(Id));
+}
+
 void MeshProvider::FinalizeAsyncLoadedMeshes()
 {
     ZoneScoped;
@@ -1001,18 +1058,27 @@ void MeshProvider::FinalizeAsyncLoadedMeshes()
         ZoneScopedN("MeshReady");
 
         const Mesh& loadedMesh = it->Future.get();
-        Mesh* mesh = &m_Meshes.at(it->ResourceId);
+        Mesh* mesh = nullptr;
 
-        mesh->Vertices = loadedMesh.Vertices;
-        mesh->Indices = loadedMesh.Indices;
-        mesh->Bones = loadedMesh.Bones;
+        {
+            std::unique_lock<std::mutex> lock = std::unique_lock<std::mutex>(m_MeshesMutex);
+            mesh = &m_Meshes.at(it->ResourceId);
 
+            mesh->Vertices = loadedMesh.Vertices;
+            mesh->Indices = loadedMesh.Indices;
+            mesh->Bones = loadedMesh.Bones;
+            m_TriangleBvhs.erase(it->ResourceId);
+        }
+
+        // not under the lock, it can `::Assign` other meshes
         if (it->PostLoadCallback)
             it->PostLoadCallback(*mesh);
-        mesh = &m_Meshes.at(it->ResourceId);
 
         if (!IsHeadless)
-            m_CreateAndUploadGpuMesh(*mesh);
+        {
+            std::unique_lock<std::mutex> lock = std::unique_lock<std::mutex>(m_MeshesMutex);
+            m_CreateAndUploadGpuMesh(m_Meshes.at(it->ResourceId));
+        }
 
         delete it->Promise;
 
@@ -1,3 +1,4 @@
+#include <filesystem>
 #include <cfloat>
 #include <glm/gtc/type_ptr.hpp>
 #include <stb/stb_image.h>
@@ -11,8 +12,10 @@
 #include "datatype/GameObject.hpp"
 #include "component/Transform.hpp"
 #include "component/Animation.hpp"
+#include "component/RigidBody.hpp"
 #include "component/Model.hpp"
 #include "component/Mesh.hpp"
+#include "geometry/ConvexDecomposition.hpp"
 #include "Utilities.hpp"
 #include "FileRW.hpp"
 #include "Log.hpp"
@@ -87,7 +90,50 @@ static std::string getTexturePath(
     }
 }
 
-ModelLoader::ModelLoader(const std::string& AssetPath, uint32_t Parent)
+// decomposes the mesh into hulls saved next to it, `meshes/crow/main.001.hxmesh` gets
+// `meshes/crow/main.001.hull1.hxmesh` and so on, listed in `meshes/crow/main.001.hulls.json`.
+// Returns the path of that, or an empty string if the mesh is too flat for any hulls
+static std::string generateHulls(const Mesh& Data, const std::string& MeshPath)
+{
+    ZoneScoped;
+
+    std::vector<Mesh> hulls = ConvexDecomposition::Decompose(Data);
+
+    if (hulls.empty())
+        return "";
+
+    MeshProvider* meshProvider = MeshProvider::Get();
+    std::string basePath = MeshPath.substr(0, MeshPath.size() - std::string_view(".hxmesh").size());
+    nlohmann::json hullsJson = { { "Hulls", nlohmann::json::array() } };
+
+    for (size_t index = 0; index < hulls.size(); index++)
+    {
+        std::string hullPath = basePath + ".hull" + std::to_string(index + 1) + ".hxmesh";
+
+        meshProvider->UnloadMesh(hullPath);
+        meshProvider->Save(hulls[index], hullPath);
+        hullsJson["Hulls"].push_back(hullPath);
+    }
+
+    // a previous import may have had more hulls, which would otherwise be left lying around
+    for (size_t index = hulls.size() + 1; ; index++)
+    {
+        std::string stalePath = basePath + ".hull" + std::to_string(index) + ".hxmesh";
+        std::error_code ec;
+
+        meshProvider->UnloadMesh(stalePath);
+
+        if (!std::filesystem::remove(FileRW::ResolvePathNormalized(stalePath), ec))
+            break;
+    }
+
+    std::string hullsPath = basePath + ".hulls.json";
+    PHX_CHECK(FileRW::WriteFileCreateDirectories(hullsPath, hullsJson.dump(2)));
+
+    return hullsPath;
+}
+
+ModelLoader::ModelLoader(const std::string& AssetPath, uint32_t Parent, bool GenerateHulls)
 {
     ZoneScoped;
 
@@ -300,6 +346,19 @@ ModelLoader::ModelLoader(const std::string& AssetPath, uint32_t Parent)
             meshProvider->Save(node.Data, meshPath);
             meshObject->SetRenderMesh(meshPath);
 
+            // the decomposition is of the bind pose, which a rigged mesh won't stay in
+            if (GenerateHulls && !m_HasSkinning)
+            {
+                std::string hullsPath = generateHulls(node.Data, meshPath);
+
+                if (!hullsPath.empty())
+                {
+                    EcRigidBody* rigidBody = object->FindComponent<EcRigidBody>();
+                    rigidBody->SetHullsFile(hullsPath);
+                    rigidBody->CollisionType = EnCollisionType::Hulls;
+                }
+            }
+
             TextureManager* texManager = TextureManager::Get();
 
             nlohmann::json materialJson;
@@ -753,11 +753,10 @@ std::vector<ObjectHandle> SceneFormat::Deserialize(
             ct->RecomputeTransformTree();
         else
         {
-            object->ForEachDescendant([](const ObjectHandle& d)
+            object->VisitDescendants([](GameObject& d)
             {
-                if (EcTransform* dt = d->FindComponent<EcTransform>())
+                if (EcTransform* dt = d.FindComponent<EcTransform>())
                     dt->RecomputeTransformTree();
-                return true;
             });
         }
     }
@@ -925,10 +924,10 @@ void Serializer::SerializeObject(GameObject* Object, bool IsRootNode)
         item[propName] = ser;
     }
 
-    if (Object->Tags.size() > 0)
+    if (Object->GetTags().size() > 0)
     {
         item["$_tags"] = nlohmann::json::array();
-        for (uint16_t tagId : Object->Tags)
+        for (uint16_t tagId : Object->GetTags())
             item["$_tags"].push_back(GameObjectManager::Get()->Collections[tagId].Name);
     }
 
@@ -948,11 +947,10 @@ std::string SceneFormat::Serialize(std::vector<GameObject*> Objects, const std::
     {
         serializer.SerializeObject(rootObject, /* IsRootNode = */ true);
 
-        rootObject->ForEachDescendant([&serializer](const ObjectHandle& desc)
+        rootObject->VisitDescendants([&serializer](GameObject& desc)
         {
-            if (desc->Serializes)
-                serializer.SerializeObject(desc.Dereference());
-            return true;
+            if (desc.Serializes)
+                serializer.SerializeObject(&desc);
         });
     }
 
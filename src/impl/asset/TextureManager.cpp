@@ -429,7 +429,7 @@ uint32_t TextureManager::LoadFromPath(const std::string& Path, bool ShouldLoadAs
 
             std::promise<Texture>* promise = new std::promise<Texture>;
 
-            ThreadManager::Get()->Dispatch(
+            ThreadManager::Get()->DispatchIo(
                 "AsyncTextureLoad",
                 [promise, ActualPath, newResourceId]()
                 {
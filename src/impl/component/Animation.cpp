@@ -259,12 +259,10 @@ void EcAnimator::BuildRig()
     ZoneScoped;
     Joints.clear();
 
-    Object->ForEachDescendant([this](const ObjectHandle& desc)
+    Object->VisitDescendants([this](GameObject& desc)
     {
-        if (desc->FindComponent<EcTransform>() || desc->FindComponent<EcBone>())
-            Joints[desc->Name].push_back(desc);
-
-        return true;
+        if (desc.FindComponent<EcTransform>() || desc.FindComponent<EcBone>())
+            Joints[desc.Name].push_back(&desc);
     });
 }
 
@@ -346,8 +344,8 @@ void EcAnimator::Step(double DeltaTime)
                         {
                             cb->SetTransform(transs);
 
-                            EcMesh* mesh = (EcMesh*)GetComponentManagerByComponentType(EntityComponent::Mesh)->GetComponent(cb->TargetMesh);
-                            meshes.insert(mesh);
+                            if (EcMesh* mesh = cb->GetTargetMesh())
+                                meshes.insert(mesh);
                         }
                         else if (EcTransform* ct = joint->FindComponent<EcTransform>())
                         {
@@ -45,6 +45,8 @@ static void loadMeshDataFromMap(const std::vector<Reflection::GenericValue>& inp
                     else
                         RAISE_RT("Invalid field on vertex '{}'", vname);
                 });
+
+                mesh.Vertices.push_back(v);
             }
         }
         else if (name == "Indices")
@@ -70,7 +72,7 @@ static void loadMeshDataFromMap(const std::vector<Reflection::GenericValue>& inp
 
 static void loadMeshDataFromBuffer(const std::vector<Reflection::GenericValue>& inputs, Mesh& mesh)
 {
-    const std::string_view& buffer = std::string_view(inputs[1].Val.Str, inputs[1].Size);
+    std::string_view buffer = inputs[1].AsBufferView();
 
     if (buffer.size() < sizeof(uint32_t) * 2)
         RAISE_RT("Expected buffer to have at least {} bytes, got {}", sizeof(uint32_t) * 2, buffer.size());
@@ -227,12 +229,13 @@ const Reflection::StaticMethodMap& AssetServiceComponentManager::GetMethods()
         } },
 
         { "ImportModel", Reflection::MethodDescriptor{
-            REFLECTION_SPAN({ Reflection::ValueType::String }),
+            REFLECTION_SPAN({ Reflection::ValueType::String, REFLECTION_OPTIONAL(Boolean) }),
             REFLECTION_SPAN({ Reflection::ValueType::GameObject }),
             [](void*, const std::vector<Reflection::GenericValue>& inputs) -> std::vector<Reflection::GenericValue>
             {
                 const std::string& path = std::string(inputs[0].AsStringView());
-	            ObjectHandle loaded = ModelLoader(path, PHX_GAMEOBJECT_NULL_ID).Model;
+                bool generateHulls = inputs.size() > 1 && inputs[1].AsBoolean();
+	            ObjectHandle loaded = ModelLoader(path, PHX_GAMEOBJECT_NULL_ID, generateHulls).Model;
 
                 return { loaded->ToGenericValue() };
             }
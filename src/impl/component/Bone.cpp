@@ -7,17 +7,17 @@
 #include "datatype/GameObject.hpp"
 #include "asset/MeshProvider.hpp"
 
-static EcMesh* getTargetMesh(EcBone* Bone)
+EcMesh* EcBone::GetTargetMesh()
 {
-	if (Bone->TargetMesh != UINT32_MAX)
-		return (EcMesh*)GetComponentManagerByComponentType(EntityComponent::Mesh)->GetComponent(Bone->TargetMesh);
+	if (TargetMesh.Type == EntityComponent::Mesh)
+		return TargetMesh.Get<EcMesh>();
 	else
 		return nullptr;
 }
 
 static Bone* getUnderlyingBone(EcBone* BoneComponent)
 {
-	EcMesh* cm = getTargetMesh(BoneComponent);
+	EcMesh* cm = BoneComponent->GetTargetMesh();
 
 	if (cm)
 	{
@@ -63,8 +63,8 @@ const Reflection::StaticPropertyMap& BoneComponentManager::GetProperties()
                 EcBone* boneObj = static_cast<EcBone*>(p);
                 boneObj->SetTransform(gv.AsMatrix());
 
-                EcMesh* mesh = getTargetMesh(boneObj);
-                mesh->RecomputeBoneMatrices();
+                if (EcMesh* mesh = boneObj->GetTargetMesh())
+                    mesh->RecomputeBoneMatrices();
 			}
 		),
 
@@ -95,7 +95,7 @@ const Reflection::StaticPropertyMap& BoneComponentManager::GetProperties()
 			GameObject,
 			[](void* p) -> Reflection::GenericValue
 			{
-				if (EcMesh* cm = getTargetMesh(static_cast<EcBone*>(p)))
+				if (EcMesh* cm = static_cast<EcBone*>(p)->GetTargetMesh())
 					return cm->Object->ToGenericValue();
 				else
 					return GameObject::s_ToGenericValue(nullptr);
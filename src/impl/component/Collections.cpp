@@ -5,7 +5,7 @@
 uint32_t CollectionsComponentManager::CreateComponent(GameObject* Object)
 {
     uint32_t id = ComponentManager<EcCollections>::CreateComponent(Object);
-    Components[id].Reference = { id, EntityComponent::Collections };
+    Components[id].Reference = { id, EntityComponent::Collections, Components[id].Generation };
     Components[id].Object = Object;
 
     return id;
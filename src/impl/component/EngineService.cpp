@@ -6,8 +6,10 @@
 
 #include "component/EngineService.hpp"
 #include "datatype/JsonGenerics.hpp"
+#include "datatype/ComponentBase.hpp"
 #include "Version.hpp"
 #include "Engine.hpp"
+#include "Memory.hpp"
 
 const Reflection::StaticPropertyMap& EngineComponentManager::GetProperties()
 {
@@ -189,6 +191,35 @@ const Reflection::StaticMethodMap& EngineComponentManager::GetMethods()
                 return { JsonToGeneric(engine->Config[inputs[0].AsStringView()]) };
             }
         } },
+
+        { "GetMemoryUsage", Reflection::MethodDescriptor{
+            REFLECTION_SPAN({ Reflection::ValueType::String }),
+            REFLECTION_SPAN({ Reflection::ValueType::Integer }),
+            [](void*, const std::vector<Reflection::GenericValue>& inputs) -> std::vector<Reflection::GenericValue>
+            {
+                std::string_view category = inputs[0].AsStringView();
+
+                for (size_t i = 0; i < (size_t)Memory::Category::count; i++)
+                    if (category == Memory::CategoryNames[i])
+                        return { (int64_t)Memory::Counters[i].load() };
+
+                RAISE_RT("Invalid memory category '{}'", category);
+            }
+        } },
+
+        { "GetComponentSlots", Reflection::MethodDescriptor{
+            REFLECTION_SPAN({ Reflection::ValueType::String }),
+            REFLECTION_SPAN({ Reflection::ValueType::Integer }),
+            [](void*, const std::vector<Reflection::GenericValue>& inputs) -> std::vector<Reflection::GenericValue>
+            {
+                EntityComponent type = FindComponentTypeByName(inputs[0].AsStringView());
+
+                if (type == EntityComponent::None)
+                    RAISE_RT("Invalid component '{}'", inputs[0].AsStringView());
+
+                return { (int64_t)GetComponentManagerByComponentType(type)->GetNumSlots() };
+            }
+        } },
     };
 
     return methods;
@@ -222,7 +222,7 @@ void EcMesh::SetRenderMesh(const std::string_view& MeshPath)
 
 				bone->Transform = b.Transform;
 				bone->SkeletalBoneId = boneId;
-				bone->TargetMesh = cm->ComponentId;
+				bone->TargetMesh = { cm->ComponentId, EntityComponent::Mesh, cm->Generation };
 
 				boneNameToObject[b.Name] = boneObj.Reference;
 			}
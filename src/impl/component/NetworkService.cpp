@@ -160,7 +160,7 @@ const Reflection::StaticMethodMap& NetworkComponentManager::GetMethods()
                 std::promise<std::vector<Reflection::GenericValue>>* prom = new std::promise<std::vector<Reflection::GenericValue>>;
                 HttpRequest request = parseRequestFromReflection(inputs[0]);
 
-                ThreadManager::Get()->Dispatch(
+                ThreadManager::Get()->DispatchIo(
                     "HttpRequest",
                     [request, prom]()
                     {
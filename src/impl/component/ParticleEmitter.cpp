@@ -131,6 +131,9 @@ void EcParticleEmitter::Update(double DeltaTime)
 	float deltaTimeForGLM = static_cast<float>(DeltaTime);
 	float timeBetweenSpawn = 1.f / this->Rate;
 
+	EcTransform* ct = Object->FindComponent<EcTransform>();
+	m_Transform = ct ? ct->Transform : glm::mat4(1.f);
+
 	if (m_TimeSinceLastSpawn >= timeBetweenSpawn && this->Emitting)
 	{
 		uint32_t numToSpawn = static_cast<uint32_t>(m_TimeSinceLastSpawn / timeBetweenSpawn);
@@ -140,8 +143,6 @@ void EcParticleEmitter::Update(double DeltaTime)
 		// Spawn a new particle
 		std::uniform_real_distribution<float> lifetimeDist(this->Lifetime.x, this->Lifetime.y);
 
-		EcTransform* ct = Object->FindComponent<EcTransform>();
-
 		for (uint32_t i = 0; i < numToSpawn; i++)
 		{
 			Particle newParticle = {
@@ -150,7 +151,7 @@ void EcParticleEmitter::Update(double DeltaTime)
 				.Size = 1.f,
 				.Transparency = 0.f,
 				.Tint = Color(1.f, 1.f, 1.f),
-				.Position = this->ParticlesAreAttached ? glm::vec3() : glm::vec3(ct->Transform[3])
+				.Position = this->ParticlesAreAttached ? glm::vec3() : glm::vec3(m_Transform[3])
 			};
 
 			m_Particles[m_GetUsableParticleIndex()] = newParticle;
@@ -175,11 +176,7 @@ void EcParticleEmitter::Update(double DeltaTime)
 
 void EcParticleEmitter::Render(const glm::mat4& RenderMatrix)
 {
-	if (m_Particles.empty())
-		return;
-
-	EcTransform* ct = Object->FindComponent<EcTransform>();
-	if (!ct)
+	if (m_Particles.empty() || !Object->FindComponent<EcTransform>())
 		return;
 
 	TextureManager* texManager = TextureManager::Get();
@@ -225,7 +222,7 @@ void EcParticleEmitter::Render(const glm::mat4& RenderMatrix)
 		glm::mat4 transform = glm::translate(glm::mat4(1.f), particle.Position);
 
 		if (ParticlesAreAttached)
-			transform *= ct->Transform;
+			transform *= m_Transform;
 
 		particleShader.SetUniform("Phoenix_Position", glm::vec3(transform[3]));
 		particleShader.SetUniform("Phoenix_Size", particle.Size);
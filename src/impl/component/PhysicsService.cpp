@@ -23,11 +23,41 @@ const Reflection::StaticPropertyMap& PhysicsComponentManager::GetProperties()
 {
     static const Reflection::StaticPropertyMap props = {
         PROPERTY_PROXY(Timescale, Double),
+        PROPERTY_PROXY(FixedTickRate, Double),
         PROPERTY_PROXY(Simulating, Boolean),
         PROPERTY_PROXY(Gravity, Vector3),
         PROPERTY_PROXY(DebugCollisionAabbs, Boolean),
         PROPERTY_PROXY(DebugContactPoints, Boolean),
         PROPERTY_PROXY(DebugSpatialHeat, Boolean),
+
+        REFLECTION_PROPERTY(
+            "Broadphase",
+            Integer,
+            [](void* p) -> Reflection::GenericValue
+            {
+                return static_cast<uint32_t>(static_cast<EcPhysicsService*>(p)->Broadphase);
+            },
+            [](void* p, const Reflection::GenericValue& gv)
+            {
+                EcPhysicsService* ep = static_cast<EcPhysicsService*>(p);
+                int64_t broadphase = gv.AsInteger();
+
+                if (broadphase != (int64_t)EnBroadphase::Grid && broadphase != (int64_t)EnBroadphase::Tree)
+                    RAISE_RT("Invalid Broadphase {}", broadphase);
+
+                ep->Broadphase = static_cast<EnBroadphase>(broadphase);
+
+                // Workspaces created later pick it up from `Physics` as well
+                if (ep->IsServiceInstance)
+                {
+                    Physics::Get()->Broadphase = ep->Broadphase;
+
+                    for (EcWorkspace& workspace : ComponentManager<EcWorkspace>::Get()->Components)
+                        if (workspace.Valid)
+                            workspace.SetBroadphase(ep->Broadphase);
+                }
+            }
+        ),
     };
 
     return props;
@@ -6,76 +6,104 @@
 
 #include "component/RigidBody.hpp"
 #include "component/Workspace.hpp"
+#include "component/Mesh.hpp"
 #include "asset/MeshProvider.hpp"
+#include "geometry/SimdMath.hpp"
 #include "FileRW.hpp"
 
-static float roundNToGrid(float x)
+static_assert(SpatialGrid::NullProxy == EcRigidBody::NullBroadphaseProxy && AabbTree::NullNode == EcRigidBody::NullBroadphaseProxy);
+
+// whatever was resting on or against the box can't be left asleep, as what was holding it
+// up may have moved or gone. Waking one body of a sleeping island is enough, the rest are
+// woken by it touching them in the next step
+static void wakeSleepersIn(const EcWorkspace* Workspace, const glm::vec3& Position, const glm::vec3& Size, uint32_t Except)
 {
-    return glm::round(x / SPATIAL_HASH_GRID_SIZE) * SPATIAL_HASH_GRID_SIZE;
+    GameObjectManager* objectManager = GameObjectManager::Get();
+
+    Workspace->VisitBroadphase(Position - Size / 2.f, Position + Size / 2.f, [objectManager, Except](uint32_t oid) -> bool
+    {
+        if (oid == Except)
+            return false;
+
+        if (GameObject* object = objectManager->FindById(oid))
+            if (EcRigidBody* crb = object->FindComponent<EcRigidBody>(); crb && crb->Sleeping)
+                crb->Wake();
+
+        return false;
+    });
 }
 
-static glm::vec3 roundToGrid(const glm::vec3& v)
+static EcWorkspace* broadphaseWorkspace(EcRigidBody* crb)
 {
-    return glm::vec3(roundNToGrid(v.x), roundNToGrid(v.y), roundNToGrid(v.z));
+    GameObject* pw = crb->PrevWorkspace.Referred();
+    return pw ? pw->FindComponent<EcWorkspace>() : nullptr;
 }
 
-static void updateSpatialHash(EcRigidBody* crb, bool placeNew)
+static void removeFromBroadphase(EcRigidBody* crb)
 {
-    ZoneScoped;
+    if (crb->BroadphaseProxy == EcRigidBody::NullBroadphaseProxy)
+        return;
 
-    if (GameObject* pw = crb->PrevWorkspace.Referred(); crb->SpatialHashPoints.size() > 0 && pw)
-        if (EcWorkspace* pcw = pw->FindComponent<EcWorkspace>())
-        {
-            for (const glm::vec3& point : crb->SpatialHashPoints)
-            {
-                auto& cell = pcw->SpatialHash[point];
-                auto it = std::find(cell.begin(), cell.end(), crb->Object->ObjectId);
-                assert(it != cell.end());
+    if (EcWorkspace* pcw = broadphaseWorkspace(crb))
+    {
+        uint32_t proxy = crb->BroadphaseProxy;
+        uint32_t oid = crb->Object.TargetId;
 
-                cell.erase(it);
-            }
+        wakeSleepersIn(pcw, crb->CollisionAabb.Position, crb->CollisionAabb.Size, oid);
+
+        if (pcw->Broadphase == EnBroadphase::Tree)
+        {
+            if (pcw->Tree.OwnsProxy(proxy, oid))
+                pcw->Tree.DestroyProxy(proxy);
         }
+        else if (pcw->Grid.OwnsProxy(proxy, oid))
+            pcw->Grid.DestroyProxy(proxy);
+    }
 
-    crb->SpatialHashPoints.clear();
+    crb->BroadphaseProxy = EcRigidBody::NullBroadphaseProxy;
+}
 
-    if (!crb->PhysicsCollisions)
-        return;
+static void updateSpatialHash(EcRigidBody* crb, bool placeNew)
+{
+    ZoneScoped;
 
-    GameObject* ocw = GameObjectManager::Get()->FindById(crb->Object->OwningWorkspace);
+    GameObject* ocw = crb->PhysicsCollisions ? GameObjectManager::Get()->FindById(crb->Object->OwningWorkspace) : nullptr;
     EcWorkspace* cw = ocw ? ocw->FindComponent<EcWorkspace>() : nullptr;
-    crb->PrevWorkspace = ocw;
-
-    if (!cw || !placeNew)
-        return;
 
     glm::vec3 min = crb->CollisionAabb.Position - crb->CollisionAabb.Size / 2.f;
     glm::vec3 max = crb->CollisionAabb.Position + crb->CollisionAabb.Size / 2.f;
 
-    min = roundToGrid(min);
-    max = roundToGrid(max);
+    bool inRange = std::abs(min.x) <= (float)INT32_MAX && std::abs(min.y) <= (float)INT32_MAX && std::abs(min.z) <= (float)INT32_MAX
+        && std::abs(max.x) <= (float)INT32_MAX && std::abs(max.y) <= (float)INT32_MAX && std::abs(max.z) <= (float)INT32_MAX;
+
+    bool place = cw && placeNew && inRange;
 
-    if (std::abs(min.x) > (float)INT32_MAX || std::abs(min.y) > (float)INT32_MAX || std::abs(min.z) > (float)INT32_MAX
-        || std::abs(max.x) > (float)INT32_MAX || std::abs(max.y) > (float)INT32_MAX || std::abs(max.z) > (float)INT32_MAX
-    )
+    // the proxy belongs to the broadphase of whichever Workspace we were in before
+    if (!place || crb->PrevWorkspace.Referred() != ocw)
+        removeFromBroadphase(crb);
+
+    if (crb->PhysicsCollisions)
+        crb->PrevWorkspace = ocw;
+
+    if (!place)
         return;
 
-    if (min == max)
+    uint32_t oid = crb->Object.TargetId;
+
+    if (cw->Broadphase == EnBroadphase::Tree)
     {
-        cw->SpatialHash[min].push_back(crb->Object.TargetId);
-        crb->SpatialHashPoints = { min };
-        return;
+        if (crb->BroadphaseProxy == EcRigidBody::NullBroadphaseProxy)
+            crb->BroadphaseProxy = cw->Tree.CreateProxy(min, max, oid);
+        else
+            cw->Tree.MoveProxy(crb->BroadphaseProxy, min, max);
     }
+    else
+    {
+        if (crb->BroadphaseProxy == EcRigidBody::NullBroadphaseProxy)
+            crb->BroadphaseProxy = cw->Grid.CreateProxy(oid);
 
-    for (float x = min.x; x <= max.x; x += SPATIAL_HASH_GRID_SIZE)
-        for (float y = min.y; y <= max.y; y += SPATIAL_HASH_GRID_SIZE)
-            for (float z = min.z; z <= max.z; z += SPATIAL_HASH_GRID_SIZE)
-            {
-                glm::vec3 point = { x, y, z };
-                assert(roundToGrid(point) == point);
-
-                cw->SpatialHash[point].push_back(crb->Object.TargetId);
-                crb->SpatialHashPoints.push_back(point);
-            }
+        cw->Grid.SetCells(crb->BroadphaseProxy, SpatialGrid::CellOf(min), SpatialGrid::CellOf(max));
+    }
 }
 
 uint32_t RigidBodyComponentManager::CreateComponent(GameObject* Object)
@@ -87,11 +115,28 @@ uint32_t RigidBodyComponentManager::CreateComponent(GameObject* Object)
     return id;
 }
 
+void RigidBodyComponentManager::DeleteComponent(uint32_t Id)
+{
+    removeFromBroadphase(&Components[Id]);
+    ComponentManager<EcRigidBody>::DeleteComponent(Id);
+}
+
 const Reflection::StaticPropertyMap& RigidBodyComponentManager::GetProperties()
 {
     static const Reflection::StaticPropertyMap props = {
-        REFLECTION_PROPERTY_SIMPLE(EcRigidBody, PhysicsDynamics, Boolean),
+        REFLECTION_PROPERTY(
+            "PhysicsDynamics",
+            Boolean,
+            REFLECTION_PROPERTY_GET_SIMPLE(EcRigidBody, PhysicsDynamics),
+            [](void* p, const Reflection::GenericValue& gv)
+            {
+                EcRigidBody* crb = static_cast<EcRigidBody*>(p);
+                crb->PhysicsDynamics = gv.AsBoolean();
+                crb->Wake();
+            }
+        ),
         REFLECTION_PROPERTY_SIMPLE(EcRigidBody, PhysicsRotations, Boolean),
+        REFLECTION_PROPERTY_SIMPLE(EcRigidBody, Continuous, Boolean),
 
         REFLECTION_PROPERTY(
             "PhysicsCollisions",
@@ -118,12 +163,71 @@ const Reflection::StaticPropertyMap& RigidBodyComponentManager::GetProperties()
                 static_cast<EcRigidBody*>(p)->CollisionType = static_cast<EnCollisionType>(gv.AsInteger());
             }
         ),
+        REFLECTION_PROPERTY(
+            "CollisionGroup",
+            Integer,
+            [](void* p)
+            -> Reflection::GenericValue
+            {
+                return (uint32_t)static_cast<EcRigidBody*>(p)->CollisionGroup;
+            },
+            [](void* p, const Reflection::GenericValue& gv)
+            {
+                int64_t group = gv.AsInteger();
+
+                if (group < 0 || group > 31)
+                    RAISE_RT("Collision group must be between 0 and 31, got {}", group);
+
+                static_cast<EcRigidBody*>(p)->CollisionGroup = (uint8_t)group;
+            }
+        ),
 
-        REFLECTION_PROPERTY_SIMPLE(EcRigidBody, LinearVelocity, Vector3),
-        REFLECTION_PROPERTY_SIMPLE(EcRigidBody, AngularVelocity, Vector3),
+        REFLECTION_PROPERTY(
+            "LinearVelocity",
+            Vector3,
+            REFLECTION_PROPERTY_GET_SIMPLE(EcRigidBody, LinearVelocity),
+            [](void* p, const Reflection::GenericValue& gv)
+            {
+                EcRigidBody* crb = static_cast<EcRigidBody*>(p);
+                crb->LinearVelocity = gv.AsVector3();
+                crb->Wake();
+            }
+        ),
+        REFLECTION_PROPERTY(
+            "AngularVelocity",
+            Vector3,
+            REFLECTION_PROPERTY_GET_SIMPLE(EcRigidBody, AngularVelocity),
+            [](void* p, const Reflection::GenericValue& gv)
+            {
+                EcRigidBody* crb = static_cast<EcRigidBody*>(p);
+                crb->AngularVelocity = gv.AsVector3();
+                crb->Wake();
+            }
+        ),
         REFLECTION_PROPERTY_SIMPLE(EcRigidBody, Friction, Double),
         REFLECTION_PROPERTY_SIMPLE(EcRigidBody, Restitution, Double),
         REFLECTION_PROPERTY_SIMPLE(EcRigidBody, GravityFactor, Double),
+        REFLECTION_PROPERTY_SIMPLE(EcRigidBody, LinearSleepThreshold, Double),
+        REFLECTION_PROPERTY_SIMPLE(EcRigidBody, AngularSleepThreshold, Double),
+
+        REFLECTION_PROPERTY(
+            "Sleeping",
+            Boolean,
+            REFLECTION_PROPERTY_GET_SIMPLE(EcRigidBody, Sleeping),
+            [](void* p, const Reflection::GenericValue& gv)
+            {
+                EcRigidBody* crb = static_cast<EcRigidBody*>(p);
+
+                if (gv.AsBoolean())
+                {
+                    crb->Sleeping = true;
+                    crb->LinearVelocity = glm::vec3(0.f);
+                    crb->AngularVelocity = glm::vec3(0.f);
+                }
+                else
+                    crb->Wake();
+            }
+        ),
 
         REFLECTION_PROPERTY(
             "Density",
@@ -157,6 +261,16 @@ const Reflection::StaticPropertyMap& RigidBodyComponentManager::GetProperties()
     return props;
 }
 
+const Reflection::StaticEventMap& RigidBodyComponentManager::GetEvents()
+{
+    static const Reflection::StaticEventMap events = {
+        REFLECTION_EVENT(EcRigidBody, OnCollisionBegan, REFLECTION_OPTIONAL(GameObject)),
+        REFLECTION_EVENT(EcRigidBody, OnCollisionEnded, REFLECTION_OPTIONAL(GameObject)),
+    };
+
+    return events;
+}
+
 void EcRigidBody::RecomputeAabb()
 {
     ZoneScoped;
@@ -165,26 +279,70 @@ void EcRigidBody::RecomputeAabb()
     if (!ct)
         return;
 
-    const glm::mat4& transform = ct->Transform;
-    std::array<glm::vec3, 8> verts;
+    glm::vec3 prevPosition = CollisionAabb.Position;
+    glm::vec3 prevSize = CollisionAabb.Size;
+
+    SimdMath::AabbsFromObbs(&ct->Transform, &CollisionAabb.Position, &CollisionAabb.Size, 1);
+    m_CommitAabb(prevPosition, prevSize);
+}
 
-    int i = 0;
-    for (int x : {-1, 1})
-        for (int y : {-1, 1})
-            for (int z : {-1, 1})
-                verts[i++] = transform * glm::vec4(x, y, z, 1.f);
+void EcRigidBody::s_RecomputeAabbs(EcRigidBody* const* Bodies, size_t Count)
+{
+    ZoneScoped;
+
+    // reused between calls, like `propagateWorldTransforms`' scratch
+    static thread_local std::vector<EcRigidBody*> withTransform;
+    static thread_local std::vector<glm::mat4> transforms;
+    static thread_local std::vector<glm::vec3> centers;
+    static thread_local std::vector<glm::vec3> halfSizes;
+
+    withTransform.clear();
+    transforms.clear();
+
+    for (size_t i = 0; i < Count; i++)
+        if (EcTransform* ct = Bodies[i]->Object->FindComponent<EcTransform>())
+        {
+            withTransform.push_back(Bodies[i]);
+            transforms.push_back(ct->Transform);
+        }
 
-    glm::vec3 max = glm::vec3(-FLT_MAX);
-    glm::vec3 min = glm::vec3( FLT_MAX);
+    centers.resize(transforms.size());
+    halfSizes.resize(transforms.size());
+    SimdMath::AabbsFromObbs(transforms.data(), centers.data(), halfSizes.data(), transforms.size());
 
-    for (const glm::vec3& v : verts)
+    for (size_t i = 0; i < withTransform.size(); i++)
     {
-        max = glm::max(max, v);
-        min = glm::min(min, v);
+        EcRigidBody* crb = withTransform[i];
+        glm::vec3 prevPosition = crb->CollisionAabb.Position;
+        glm::vec3 prevSize = crb->CollisionAabb.Size;
+
+        crb->CollisionAabb.Position = centers[i];
+        crb->CollisionAabb.Size = halfSizes[i];
+        crb->m_CommitAabb(prevPosition, prevSize);
     }
+}
+
+void EcRigidBody::Wake()
+{
+    Sleeping = false;
+    SleepTimer = 0.f;
+}
+
+void EcRigidBody::m_CommitAabb(const glm::vec3& PrevPosition, const glm::vec3& PrevSize)
+{
+    // the simulation only moves awake dynamic bodies, and those can't be touching a sleeping
+    // one without waking it. Anything else was moved, resized or teleported by something else,
+    // and may have been holding up whatever is asleep where it was, or be in the way of it now
+    bool movedExternally = (!PhysicsDynamics || Sleeping)
+        && (PrevPosition != CollisionAabb.Position || PrevSize != CollisionAabb.Size);
+
+    if (movedExternally && BroadphaseProxy != NullBroadphaseProxy)
+        if (EcWorkspace* pcw = broadphaseWorkspace(this))
+            wakeSleepersIn(pcw, PrevPosition, PrevSize, Object.TargetId);
 
-    this->CollisionAabb.Position = (min + max) / 2.f;
-    this->CollisionAabb.Size = (max - min) / 2.f;
+    // the simulation doesn't move sleeping bodies, so something else did
+    if (Sleeping)
+        Wake();
 
     bool tooBig = CollisionAabb.Size.x > 5000.f || CollisionAabb.Size.y > 5000.f || CollisionAabb.Size.z > 5000.f;
 
@@ -199,6 +357,10 @@ void EcRigidBody::RecomputeAabb()
 
     updateSpatialHash(this, !tooBig);
 
+    if (movedExternally && BroadphaseProxy != NullBroadphaseProxy)
+        if (EcWorkspace* pcw = broadphaseWorkspace(this))
+            wakeSleepersIn(pcw, CollisionAabb.Position, CollisionAabb.Size, Object.TargetId);
+
     this->Mass = Density * CollisionAabb.Size.x * CollisionAabb.Size.y * CollisionAabb.Size.z;
 }
 
@@ -212,6 +374,20 @@ static glm::mat4 getMatrixFromJson(const nlohmann::json& Json)
     return mat;
 }
 
+// the hull stays empty if the mesh's vertices weren't kept CPU-side. Can be on the tick worker
+static ConvexHull buildConvexHull(uint32_t MeshId, bool HillClimb)
+{
+    ConvexHull hull;
+
+    MeshProvider::Get()->ReadMesh(MeshId, [&hull, HillClimb](const Mesh& mesh)
+    {
+        if (mesh.MeshDataPreserved)
+            hull = ConvexHull::s_FromMesh(mesh, HillClimb);
+    });
+
+    return hull;
+}
+
 static void loadHullsFile(EcRigidBody* rb, const nlohmann::json& data)
 {
     MeshProvider* meshProv = MeshProvider::Get();
@@ -220,14 +396,45 @@ static void loadHullsFile(EcRigidBody* rb, const nlohmann::json& data)
     {
         const nlohmann::json& hullData = data["Hulls"][index];
 
+        // synchronously and with the vertices kept, the hull is built from them right away
         if (hullData.type() == nlohmann::json::value_t::string)
-            rb->Hulls.push_back(EcRigidBody::Hull{ .MeshId = meshProv->LoadFromPath((std::string)hullData) });
+            rb->Hulls.push_back(EcRigidBody::Hull{ .MeshId = meshProv->LoadFromPath((std::string)hullData, false, true) });
         else
+        {
+            // a path, or the ID of a mesh which is already loaded
+            const nlohmann::json& meshData = hullData["Mesh"];
+
             rb->Hulls.push_back(EcRigidBody::Hull{
                 .Transform = getMatrixFromJson(hullData["Transform"]),
-                .MeshId = data["Mesh"]
+                .MeshId = meshData.is_string() ? meshProv->LoadFromPath((std::string)meshData, false, true) : (uint32_t)meshData
             });
+        }
+
+        EcRigidBody::Hull& hull = rb->Hulls.back();
+        hull.Convex = buildConvexHull(hull.MeshId, true);
+    }
+}
+
+const ConvexHull& EcRigidBody::GetMeshComponentHull()
+{
+    EcMesh* cm = Object->FindComponent<EcMesh>();
+    uint32_t meshId = cm ? cm->RenderMeshId : 0;
+
+    // also retried while empty, in case the mesh was still loading
+    if (MeshComponentHull.MeshId != meshId || MeshComponentHull.Convex.IsEmpty())
+    {
+        // render meshes can have dents, so no hill-climbing
+        MeshComponentHull.MeshId = meshId;
+        MeshComponentHull.Convex = buildConvexHull(meshId, false);
     }
+
+    return MeshComponentHull.Convex;
+}
+
+std::shared_ptr<const TriangleBvh> EcRigidBody::GetMeshTriangles() const
+{
+    EcMesh* cm = Object->FindComponent<EcMesh>();
+    return cm && cm->RenderMeshId != UINT32_MAX ? MeshProvider::Get()->GetTriangleBvh(cm->RenderMeshId) : nullptr;
 }
 
 void EcRigidBody::SetHullsFile(const std::string& NewFile)
@@ -7,50 +7,154 @@
 #include "component/RigidBody.hpp"
 #include "datatype/GameObject.hpp"
 #include "geometry/DecomposeTRS.hpp"
+#include "geometry/SimdMath.hpp"
+#include "ThreadManager.hpp"
 
-static void recomputeAabbRecursive(const ObjectHandle& Object)
+// objects with a Transform whose own world transform is up-to-date, but whose
+// descendants' are not yet
+static std::vector<uint32_t> s_DirtyObjects;
+
+static EcTransform* nearestAncestorTransform(const GameObject* Object)
 {
-    if (EcRigidBody* crb = Object->FindComponent<EcRigidBody>())
-        crb->RecomputeAabb();
+    for (GameObject* parent = Object->GetParent(); parent; parent = parent->GetParent())
+        if (EcTransform* pct = parent->FindComponent<EcTransform>())
+            return pct;
 
-    Object->ForEachChild([](const ObjectHandle& Child) -> bool
-    {
-        recomputeAabbRecursive(Child);
-        return true;
-    });
+    return nullptr;
 }
 
-static void recomputeChildrenWorldTransformsRecursive(const ObjectHandle& Object)
+// whether `ct`'s world transform is stale, because something above it
+// moved and hasn't been propagated yet
+static bool hasDirtyAncestor(const EcTransform* ct)
 {
-    EcTransform* pct = Object->FindComponent<EcTransform>();
+    if (s_DirtyObjects.empty())
+        return false;
 
-    Object->ForEachChild([Object, pct](const ObjectHandle& Child) -> bool
-    {
-        if (EcTransform* ct = Child->FindComponent<EcTransform>())
-            ct->Transform = pct->Transform * ct->LocalTransform;
+    for (GameObject* parent = ct->Object->GetParent(); parent; parent = parent->GetParent())
+        if (EcTransform* pct = parent->FindComponent<EcTransform>(); pct && pct->DescendantsDirty)
+            return true;
 
-        recomputeChildrenWorldTransformsRecursive(Child);
-        return true;
-    });
+    return false;
 }
 
-static void recomputeWorldTransforms(EcTransform* ct)
+// level by level rather than as a plain walk, so that everything on one level only depends
+// on levels which are already done, and can go through the batched kernel together
+static void propagateWorldTransforms(GameObject* Root)
 {
-    ct->Transform = ct->LocalTransform;
+    ZoneScoped;
+
+    GameObjectManager* objectManager = GameObjectManager::Get();
+
+    // reused between calls, this runs on Physics-sized trees every frame
+    static thread_local std::vector<GameObject*> level;
+    static thread_local std::vector<GameObject*> nextLevel;
+    // the world transform of the nearest Transform at or above each object in `level`,
+    // carried down rather than looked up, which would walk back up the tree every time
+    static thread_local std::vector<glm::mat4> inherited;
+    static thread_local std::vector<glm::mat4> nextInherited;
+    static thread_local std::vector<EcTransform*> targets;
+    // where in `nextLevel` each of `targets` is
+    static thread_local std::vector<size_t> targetIndices;
+    static thread_local std::vector<glm::mat4> parents;
+    static thread_local std::vector<glm::mat4> locals;
 
-    GameObject* parent = ct->Object->GetParent();
+    EcTransform* rootTransform = Root->FindComponent<EcTransform>();
 
-    while (parent)
+    level.assign(1, Root);
+    inherited.assign(1, rootTransform ? rootTransform->Transform : glm::mat4(1.f));
+
+    while (!level.empty())
     {
-        if (EcTransform* pct = parent->FindComponent<EcTransform>())
+        nextLevel.clear();
+        nextInherited.clear();
+        targets.clear();
+        targetIndices.clear();
+        parents.clear();
+        locals.clear();
+
+        for (size_t i = 0; i < level.size(); i++)
+            for (uint32_t childId : level[i]->Children)
+            {
+                GameObject* child = &objectManager->WorldArray[childId];
+                nextLevel.push_back(child);
+                nextInherited.push_back(inherited[i]);
+
+                if (EcTransform* ct = child->FindComponent<EcTransform>())
+                {
+                    targets.push_back(ct);
+                    targetIndices.push_back(nextLevel.size() - 1);
+                    parents.push_back(inherited[i]);
+                    locals.push_back(ct->LocalTransform);
+                }
+            }
+
+        SimdMath::MultiplyMat4(parents.data(), locals.data(), parents.data(), targets.size());
+
+        for (size_t i = 0; i < targets.size(); i++)
         {
-            ct->Transform = pct->Transform * ct->LocalTransform; // parent should already have up-to-date World Transforms
-            break;
+            targets[i]->Transform = parents[i];
+            // covered by this walk
+            targets[i]->DescendantsDirty = false;
+
+            nextInherited[targetIndices[i]] = parents[i];
         }
-        parent = parent->GetParent();
+
+        std::swap(level, nextLevel);
+        std::swap(inherited, nextInherited);
+    }
+}
+
+static void gatherRigidBodies(GameObject* Root, std::vector<EcRigidBody*>& Bodies)
+{
+    Root->VisitDescendants([&Bodies](GameObject& Descendant)
+    {
+        if (EcRigidBody* crb = Descendant.FindComponent<EcRigidBody>())
+            Bodies.push_back(crb);
+    });
+}
+
+void EcTransform::s_FlushDirty()
+{
+    if (s_DirtyObjects.empty())
+        return;
+
+    ZoneScoped;
+
+    GameObjectManager* objectManager = GameObjectManager::Get();
+
+    // Only the shallowest of any dirty objects which are above one another need walking,
+    // the deeper ones get caught up by them. What's left are separate subtrees
+    std::vector<GameObject*> roots;
+    roots.reserve(s_DirtyObjects.size());
+
+    for (uint32_t id : s_DirtyObjects)
+    {
+        // may have been destroyed since
+        GameObject* object = &objectManager->WorldArray[id];
+        EcTransform* ct = object->Valid ? object->FindComponent<EcTransform>() : nullptr;
+
+        if (ct && ct->DescendantsDirty && !hasDirtyAncestor(ct))
+            roots.push_back(object);
+    }
+
+    s_DirtyObjects.clear();
+
+    ThreadManager::Get()->ParallelFor("PropagateTransforms", 0, roots.size(), 8, [&roots](size_t Begin, size_t End)
+    {
+        for (size_t i = Begin; i < End; i++)
+            propagateWorldTransforms(roots[i]);
+    });
+
+    std::vector<EcRigidBody*> bodies;
+
+    for (GameObject* root : roots)
+    {
+        root->FindComponent<EcTransform>()->DescendantsDirty = false;
+        gatherRigidBodies(root, bodies);
     }
 
-    recomputeChildrenWorldTransformsRecursive(ct->Object);
+    // serial, AABBs go into the Workspace's spatial hash
+    EcRigidBody::s_RecomputeAabbs(bodies.data(), bodies.size());
 }
 
 uint32_t TransformComponentManager::CreateComponent(GameObject* Object)
@@ -84,7 +188,15 @@ const Reflection::StaticPropertyMap& TransformComponentManager::GetProperties()
 
         { "Transform", Reflection::PropertyDescriptor{
             .Name = "Transform",
-            .Get = REFLECTION_PROPERTY_GET_SIMPLE(EcTransform, Transform),
+            .Get = [](void* p) -> Reflection::GenericValue
+            {
+                EcTransform* ct = static_cast<EcTransform*>(p);
+
+                if (hasDirtyAncestor(ct))
+                    EcTransform::s_FlushDirty();
+
+                return ct->Transform;
+            },
             .Set = (Reflection::PropertySetter)[](void* p, const Reflection::GenericValue& gv)
             {
                 ZoneScoped;
@@ -115,7 +227,10 @@ const Reflection::StaticEventMap& TransformComponentManager::GetEvents()
 
 void EcTransform::SetWorldTransform(const glm::mat4& NewWorldTrans)
 {
-    EcTransform* parent = Object->GetParent() ? Object->GetParent()->FindComponent<EcTransform>() : nullptr;
+    if (hasDirtyAncestor(this))
+        s_FlushDirty();
+
+    EcTransform* parent = nearestAncestorTransform(Object);
 
     LocalTransform = parent ? (glm::inverse(parent->Transform) * NewWorldTrans) : NewWorldTrans;
     Transform = NewWorldTrans;
@@ -125,13 +240,16 @@ void EcTransform::SetWorldTransform(const glm::mat4& NewWorldTrans)
 
 void EcTransform::SetWorldSize(const glm::vec3& NewWorldSize)
 {
+    if (hasDirtyAncestor(this))
+        s_FlushDirty();
+
     glm::vec3 translation = {};
     glm::quat rotation = {};
     DecomposeTRS(Transform, &translation, &rotation, nullptr);
 
     Transform = glm::translate(glm::mat4(1.f), translation) * glm::mat4_cast(rotation) * glm::scale(glm::mat4(1.f), NewWorldSize);
 
-    EcTransform* parent = Object->GetParent() ? Object->GetParent()->FindComponent<EcTransform>() : nullptr;
+    EcTransform* parent = nearestAncestorTransform(Object);
     glm::vec3 parentSize = { 1.f, 1.f, 1.f };
 
     if (parent)
@@ -161,6 +279,19 @@ void EcTransform::RecomputeTransformTree()
 {
     ZoneScoped;
 
-    recomputeWorldTransforms(this);
-    recomputeAabbRecursive(Object);
+    // our parent's world transform has to be right for ours to be
+    if (hasDirtyAncestor(this))
+        s_FlushDirty();
+
+    EcTransform* pct = nearestAncestorTransform(Object);
+    Transform = pct ? pct->Transform * LocalTransform : LocalTransform;
+
+    if (EcRigidBody* crb = Object->FindComponent<EcRigidBody>())
+        crb->RecomputeAabb();
+
+    if (!Object->Children.empty() && !DescendantsDirty)
+    {
+        DescendantsDirty = true;
+        s_DirtyObjects.push_back(Object->ObjectId);
+    }
 }
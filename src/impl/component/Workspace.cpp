@@ -1,4 +1,8 @@
 #include <glm/gtc/matrix_transform.hpp>
+#include <glm/vector_relational.hpp>
+#include <algorithm>
+#include <cstring>
+#include <cassert>
 #include <tracy/public/tracy/Tracy.hpp>
 
 #include "component/Workspace.hpp"
@@ -7,9 +11,18 @@
 #include "component/Camera.hpp"
 #include "component/Sound.hpp"
 #include "geometry/IntersectionLib.hpp"
+#include "geometry/TriangleBvh.hpp"
+#include "geometry/Gjk.hpp"
 #include "geometry/DecomposeTRS.hpp"
+#include "ThreadManager.hpp"
 #include "Engine.hpp"
 
+// rays per task of a parallel `::RaycastBatch`
+static const size_t RAYCAST_BATCH_GRAIN = 64;
+// bytes per ray in the buffers of the `RaycastBatch` method
+static const size_t RAYCAST_BATCH_RAY_STRIDE = sizeof(float) * 3;
+static const size_t RAYCAST_BATCH_RESULT_STRIDE = sizeof(float) * 6 + sizeof(uint32_t);
+
 static ObjectHandle s_FallbackCamera;
 
 static ObjectHandle createCamera()
@@ -25,6 +38,8 @@ uint32_t WorkspaceComponentManager::CreateComponent(GameObject* Object)
 {
     uint32_t id = ComponentManager<EcWorkspace>::CreateComponent(Object);
     Components[id].Object = Object;
+    // still empty, so nothing needs moving over
+    Components[id].Broadphase = Physics::Get()->Broadphase;
     Components[id].Object->OwningWorkspace = Object->ObjectId;
     Object->EvaluateOwners();
 
@@ -44,6 +59,10 @@ void WorkspaceComponentManager::DeleteComponent(uint32_t Id)
     if (wp.Object->OwningDataModel == wp.Object->ObjectId)
         wp.Object->EvaluateOwners();
 
+    // bodies notice through `OwnsProxy` the next time they move
+    wp.Grid.Clear();
+    wp.Tree.Clear();
+
     ComponentManager<EcWorkspace>::DeleteComponent(Id);
 }
 
@@ -79,6 +98,58 @@ const Reflection::StaticPropertyMap& WorkspaceComponentManager::GetProperties()
     return props;
 }
 
+// the optional filter list, ignore-list flag and collision groups from `Index` onwards
+struct QueryFilter
+{
+    std::vector<GameObject*> List;
+    bool IsIgnoreList = true;
+    uint32_t CollisionGroups = UINT32_MAX;
+};
+
+static QueryFilter queryFilterFrom(const std::vector<Reflection::GenericValue>& inputs, size_t Index)
+{
+    QueryFilter filter;
+
+    if (inputs.size() > Index)
+    {
+        const std::span<Reflection::GenericValue>& filterListGv = inputs[Index].AsArray();
+        filter.List.reserve(filterListGv.size());
+
+        for (const Reflection::GenericValue& gv : filterListGv)
+            filter.List.push_back(GameObjectManager::Get()->FromGenericValue(gv));
+    }
+
+    if (inputs.size() > Index + 1)
+        filter.IsIgnoreList = inputs[Index + 1].AsBoolean();
+
+    if (inputs.size() > Index + 2)
+        filter.CollisionGroups = (uint32_t)inputs[Index + 2].AsInteger();
+
+    return filter;
+}
+
+static Reflection::GenericValue shapecastResultToGenericValue(const SpatialCastResult& Result)
+{
+    if (!Result.Occurred)
+        return Reflection::GenericValue::Null();
+
+    return Reflection::GenericValue::MapPairs({
+        { "Object", Result.Object->ToGenericValue() },
+        { "Position", Result.Position },
+        { "Normal", Result.Normal },
+        { "Time", Result.Time },
+    });
+}
+
+static Reflection::GenericValue objectsToGenericValue(const std::vector<GameObject*>& Objects)
+{
+    std::vector<Reflection::GenericValue> gv(Objects.size());
+    for (size_t i = 0; i < Objects.size(); i++)
+        gv[i] = Objects[i]->ToGenericValue();
+
+    return Reflection::GenericValue(gv);
+}
+
 const Reflection::StaticMethodMap& WorkspaceComponentManager::GetMethods()
 {
     static const Reflection::StaticMethodMap funcs = {
@@ -176,6 +247,214 @@ const Reflection::StaticMethodMap& WorkspaceComponentManager::GetMethods()
             }
         } },
 
+        { "RaycastBatch", Reflection::MethodDescriptor{
+            REFLECTION_SPAN({ Reflection::ValueType::Buffer, Reflection::ValueType::Buffer, REFLECTION_OPTIONAL(Array), REFLECTION_OPTIONAL(Boolean), REFLECTION_OPTIONAL(Boolean) }),
+            REFLECTION_SPAN({ Reflection::ValueType::Buffer, Reflection::ValueType::Array }),
+            [](void* p, const std::vector<Reflection::GenericValue>& inputs)
+            -> std::vector<Reflection::GenericValue>
+            {
+                std::string_view originsBuffer = inputs[0].AsBufferView();
+                std::string_view vectorsBuffer = inputs[1].AsBufferView();
+
+                if (originsBuffer.size() % RAYCAST_BATCH_RAY_STRIDE != 0)
+                    RAISE_RT("Origins buffer should be a multiple of {} bytes long, got {}", RAYCAST_BATCH_RAY_STRIDE, originsBuffer.size());
+                if (vectorsBuffer.size() != originsBuffer.size())
+                    RAISE_RT("Expected {} bytes of vectors to match the origins, got {}", originsBuffer.size(), vectorsBuffer.size());
+
+                size_t numRays = originsBuffer.size() / RAYCAST_BATCH_RAY_STRIDE;
+
+                // the buffers aren't necessarily aligned for floats
+                std::vector<glm::vec3> origins(numRays);
+                std::vector<glm::vec3> vectors(numRays);
+                std::vector<SpatialCastResult> results(numRays);
+
+                for (size_t i = 0; i < numRays; i++)
+                {
+                    memcpy(&origins[i], originsBuffer.data() + i * RAYCAST_BATCH_RAY_STRIDE, RAYCAST_BATCH_RAY_STRIDE);
+                    memcpy(&vectors[i], vectorsBuffer.data() + i * RAYCAST_BATCH_RAY_STRIDE, RAYCAST_BATCH_RAY_STRIDE);
+                }
+
+                std::vector<GameObject*> filterList;
+
+                if (inputs.size() > 2)
+                {
+                    const std::span<Reflection::GenericValue>& filterListGv = inputs[2].AsArray();
+                    filterList.reserve(filterListGv.size());
+
+                    for (const Reflection::GenericValue& gv : filterListGv)
+                        filterList.push_back(GameObjectManager::Get()->FromGenericValue(gv));
+                }
+
+                static_cast<EcWorkspace*>(p)->RaycastBatch(
+                    origins,
+                    vectors,
+                    results,
+                    filterList,
+                    inputs.size() > 3 ? inputs[3].AsBoolean() : true,
+                    inputs.size() > 4 ? inputs[4].AsBoolean() : false
+                );
+
+                // each ray's position, normal, and the index of what it hit in the array of objects
+                // (from 1, like Luau's own arrays), or 0 if it didn't
+                std::string resultsBuffer(numRays * RAYCAST_BATCH_RESULT_STRIDE, '\0');
+                std::vector<Reflection::GenericValue> objects;
+                std::unordered_map<GameObject*, uint32_t> objectIndices;
+
+                for (size_t i = 0; i < numRays; i++)
+                {
+                    const SpatialCastResult& result = results[i];
+
+                    if (!result.Occurred)
+                        continue;
+
+                    auto [it, inserted] = objectIndices.try_emplace(result.Object, (uint32_t)objects.size() + 1);
+
+                    if (inserted)
+                        objects.push_back(result.Object->ToGenericValue());
+
+                    char* out = resultsBuffer.data() + i * RAYCAST_BATCH_RESULT_STRIDE;
+                    memcpy(out, &result.Position, sizeof(float) * 3);
+                    memcpy(out + sizeof(float) * 3, &result.Normal, sizeof(float) * 3);
+                    memcpy(out + sizeof(float) * 6, &it->second, sizeof(uint32_t));
+                }
+
+                Reflection::GenericValue resultsGv = resultsBuffer;
+                resultsGv.Type = Reflection::ValueType::Buffer;
+
+                return { resultsGv, Reflection::GenericValue(objects) };
+            }
+        } },
+
+        { "Spherecast", Reflection::MethodDescriptor{
+            REFLECTION_SPAN({ Reflection::ValueType::Vector3, Reflection::ValueType::Double, Reflection::ValueType::Vector3, REFLECTION_OPTIONAL(Array), REFLECTION_OPTIONAL(Boolean), REFLECTION_OPTIONAL(Integer) }),
+            REFLECTION_SPAN({ REFLECTION_OPTIONAL(Map) }),
+            [](void* p, const std::vector<Reflection::GenericValue>& inputs)
+            -> std::vector<Reflection::GenericValue>
+            {
+                float radius = (float)inputs[1].AsDouble();
+
+                if (radius < 0.f)
+                    RAISE_RT("Radius cannot be negative, got {}", radius);
+
+                QueryFilter filter = queryFilterFrom(inputs, 3);
+                SpatialCastResult result = static_cast<EcWorkspace*>(p)->Shapecast(
+                    Gjk::MakeSphere(inputs[0].AsVector3(), radius),
+                    inputs[2].AsVector3(),
+                    filter.List,
+                    filter.IsIgnoreList,
+                    filter.CollisionGroups
+                );
+
+                return { shapecastResultToGenericValue(result) };
+            }
+        } },
+
+        { "Boxcast", Reflection::MethodDescriptor{
+            REFLECTION_SPAN({ Reflection::ValueType::Matrix, Reflection::ValueType::Vector3, Reflection::ValueType::Vector3, REFLECTION_OPTIONAL(Array), REFLECTION_OPTIONAL(Boolean), REFLECTION_OPTIONAL(Integer) }),
+            REFLECTION_SPAN({ REFLECTION_OPTIONAL(Map) }),
+            [](void* p, const std::vector<Reflection::GenericValue>& inputs)
+            -> std::vector<Reflection::GenericValue>
+            {
+                glm::vec3 size = inputs[1].AsVector3();
+
+                if (glm::any(glm::lessThan(size, glm::vec3(0.f))))
+                    RAISE_RT("Size cannot be negative");
+
+                QueryFilter filter = queryFilterFrom(inputs, 3);
+                SpatialCastResult result = static_cast<EcWorkspace*>(p)->Shapecast(
+                    Gjk::MakeBox(inputs[0].AsMatrix(), size),
+                    inputs[2].AsVector3(),
+                    filter.List,
+                    filter.IsIgnoreList,
+                    filter.CollisionGroups
+                );
+
+                return { shapecastResultToGenericValue(result) };
+            }
+        } },
+
+        { "ConvexCast", Reflection::MethodDescriptor{
+            REFLECTION_SPAN({ Reflection::ValueType::Array, Reflection::ValueType::Matrix, Reflection::ValueType::Vector3, REFLECTION_OPTIONAL(Array), REFLECTION_OPTIONAL(Boolean), REFLECTION_OPTIONAL(Integer) }),
+            REFLECTION_SPAN({ REFLECTION_OPTIONAL(Map) }),
+            [](void* p, const std::vector<Reflection::GenericValue>& inputs)
+            -> std::vector<Reflection::GenericValue>
+            {
+                const std::span<Reflection::GenericValue>& points = inputs[0].AsArray();
+
+                if (points.empty())
+                    RAISE_RT("Expected at least one point");
+
+                // only the points' support matters, so they don't need to actually be the hull
+                ConvexHull hull;
+
+                for (const Reflection::GenericValue& point : points)
+                {
+                    glm::vec3 v = point.AsVector3();
+
+                    hull.X.push_back(v.x);
+                    hull.Y.push_back(v.y);
+                    hull.Z.push_back(v.z);
+                }
+
+                QueryFilter filter = queryFilterFrom(inputs, 3);
+                SpatialCastResult result = static_cast<EcWorkspace*>(p)->Shapecast(
+                    Gjk::MakeConvex(hull, inputs[1].AsMatrix()),
+                    inputs[2].AsVector3(),
+                    filter.List,
+                    filter.IsIgnoreList,
+                    filter.CollisionGroups
+                );
+
+                return { shapecastResultToGenericValue(result) };
+            }
+        } },
+
+        { "OverlapSphere", Reflection::MethodDescriptor{
+            REFLECTION_SPAN({ Reflection::ValueType::Vector3, Reflection::ValueType::Double, REFLECTION_OPTIONAL(Array), REFLECTION_OPTIONAL(Boolean), REFLECTION_OPTIONAL(Integer) }),
+            REFLECTION_SPAN({ Reflection::ValueType::Array }),
+            [](void* p, const std::vector<Reflection::GenericValue>& inputs)
+            -> std::vector<Reflection::GenericValue>
+            {
+                float radius = (float)inputs[1].AsDouble();
+
+                if (radius < 0.f)
+                    RAISE_RT("Radius cannot be negative, got {}", radius);
+
+                QueryFilter filter = queryFilterFrom(inputs, 2);
+                std::vector<GameObject*> objects = static_cast<EcWorkspace*>(p)->Overlap(
+                    Gjk::MakeSphere(inputs[0].AsVector3(), radius),
+                    filter.List,
+                    filter.IsIgnoreList,
+                    filter.CollisionGroups
+                );
+
+                return { objectsToGenericValue(objects) };
+            }
+        } },
+
+        { "OverlapBox", Reflection::MethodDescriptor{
+            REFLECTION_SPAN({ Reflection::ValueType::Matrix, Reflection::ValueType::Vector3, REFLECTION_OPTIONAL(Array), REFLECTION_OPTIONAL(Boolean), REFLECTION_OPTIONAL(Integer) }),
+            REFLECTION_SPAN({ Reflection::ValueType::Array }),
+            [](void* p, const std::vector<Reflection::GenericValue>& inputs)
+            -> std::vector<Reflection::GenericValue>
+            {
+                glm::vec3 size = inputs[1].AsVector3();
+
+                if (glm::any(glm::lessThan(size, glm::vec3(0.f))))
+                    RAISE_RT("Size cannot be negative");
+
+                QueryFilter filter = queryFilterFrom(inputs, 2);
+                std::vector<GameObject*> objects = static_cast<EcWorkspace*>(p)->Overlap(
+                    Gjk::MakeBox(inputs[0].AsMatrix(), size),
+                    filter.List,
+                    filter.IsIgnoreList,
+                    filter.CollisionGroups
+                );
+
+                return { objectsToGenericValue(objects) };
+            }
+        } },
+
         { "GetObjectsInAabb", Reflection::MethodDescriptor{
             REFLECTION_SPAN({ Reflection::ValueType::Vector3, Reflection::ValueType::Vector3, REFLECTION_OPTIONAL(Array) }),
             REFLECTION_SPAN({ Reflection::ValueType::Array }),
@@ -254,59 +533,50 @@ glm::vec3 EcWorkspace::ScreenPointToVector(glm::vec2 point, float length) const
     return glm::normalize(glm::vec3(viewMatrixInv * eyeCoords)) * length;
 }
 
-static int roundNToGrid(float x)
-{
-    return int(glm::round(x / SPATIAL_HASH_GRID_SIZE) * SPATIAL_HASH_GRID_SIZE);
-}
-
-static glm::ivec3 roundToGrid(const glm::vec3& v)
-{
-    return glm::ivec3(roundNToGrid(v.x), roundNToGrid(v.y), roundNToGrid(v.z));
-}
-
-static void hashTraceRay(
-    const EcWorkspace* cw,
-    const glm::vec3& rayStart,
-    const glm::ivec3& rayStartCell,
-    const glm::ivec3& rayEndCell,
-    const glm::vec3& rayVector,
-    const std::function<bool(const std::vector<uint32_t>&)> TestHits
+// visits the cells along the ray in order, until `VisitCell` returns `true`
+static void gridTraceRay(
+    const glm::vec3& RayStart,
+    const glm::vec3& RayVector,
+    const std::function<bool(const glm::ivec3&)>& VisitCell
 )
 {
     ZoneScoped;
 
-    glm::ivec3 step = glm::sign(rayVector) * SPATIAL_HASH_GRID_SIZE;
-    glm::vec3 rayDir = glm::normalize(rayVector);
+    glm::ivec3 currentCell = SpatialGrid::CellOf(RayStart);
+    glm::ivec3 endCell = SpatialGrid::CellOf(RayStart + RayVector);
+
+    glm::ivec3 step = glm::ivec3(glm::sign(RayVector));
+    glm::vec3 rayDir = glm::normalize(RayVector);
 
+    // distance along the ray between crossing one cell boundary and the next, per axis
     glm::vec3 tDelta = glm::vec3(
         rayDir.x != 0.f ? std::abs(1.f / rayDir.x) * SPATIAL_HASH_GRID_SIZE : FLT_MAX,
         rayDir.y != 0.f ? std::abs(1.f / rayDir.y) * SPATIAL_HASH_GRID_SIZE : FLT_MAX,
         rayDir.z != 0.f ? std::abs(1.f / rayDir.z) * SPATIAL_HASH_GRID_SIZE : FLT_MAX
     );
 
+    // distance along the ray to the first boundary crossed, per axis.
+    // Cell `C` spans `(C +- 0.5) * SPATIAL_HASH_GRID_SIZE`
     glm::vec3 tmax;
 
     for (int i = 0; i < 3; i++)
     {
         if (step[i] > 0)
-            tmax[i] = ((rayStartCell[i] + 1) - rayStart[i]) / rayDir[i];
+            tmax[i] = ((currentCell[i] + .5f) * SPATIAL_HASH_GRID_SIZE - RayStart[i]) / rayDir[i];
         else if (step[i] < 0)
-            tmax[i] = (rayStartCell[i] - rayStart[i]) / rayDir[i];
+            tmax[i] = ((currentCell[i] - .5f) * SPATIAL_HASH_GRID_SIZE - RayStart[i]) / rayDir[i];
         else
             tmax[i] = FLT_MAX;
     }
 
-    glm::ivec3 currentCell = rayStartCell;
     int depth = 0;
 
     while (true)
     {
-        const auto& cellIt = cw->SpatialHash.find(currentCell);
-
-        if (cellIt != cw->SpatialHash.end() && TestHits(cellIt->second))
+        if (VisitCell(currentCell))
             return; // hit something
 
-        if (currentCell == rayEndCell)
+        if (currentCell == endCell)
             return;
 
         if (tmax.x < tmax.y)
@@ -341,103 +611,118 @@ static void hashTraceRay(
     }
 }
 
-SpatialCastResult EcWorkspace::Raycast(const glm::vec3& Origin, const glm::vec3& Vector, const std::vector<GameObject*>& FilterList, bool FilterIsIgnoreList) const
+// whether a ray may hit the object at all
+static bool passesFilter(const GameObject* p, uint32_t WorkspaceId, const std::vector<GameObject*>& FilterList, bool FilterIsIgnoreList)
 {
-    ZoneScoped;
+    if (!p->Valid || p->IsDestructionPending || p->OwningWorkspace != WorkspaceId)
+        return false;
+
+    for (const GameObject* filter : FilterList)
+        if (p == filter || p->IsDescendantOf(filter))
+            return !FilterIsIgnoreList;
+
+    return FilterIsIgnoreList;
+}
+
+// rays are tested against the body's AABB, or its triangles for `EnCollisionType::MeshTriangles`.
+// `nullptr` if it isn't a body
+static EcRigidBody* findCastTarget(GameObject* p)
+{
+    EcTransform* ct = p->FindComponent<EcTransform>();
+    return ct ? p->FindComponent<EcRigidBody>() : nullptr;
+}
+
+static IntersectionLib::Intersection rayCastTarget(const EcRigidBody* Target, const glm::vec3& Origin, const glm::vec3& Vector)
+{
+    if (Target->CollisionType == EnCollisionType::MeshTriangles)
+        if (std::shared_ptr<const TriangleBvh> triangles = Target->GetMeshTriangles())
+        {
+            // the ray is taken into the mesh's space rather than every triangle out of it,
+            // the fraction along it that it hits at is the same in both
+            const glm::mat4& toWorld = Target->Object->FindComponent<EcTransform>()->Transform;
+            glm::mat4 toLocal = glm::inverse(toWorld);
+
+            TriangleBvh::RaycastResult hit = triangles->Raycast(
+                glm::vec3(toLocal * glm::vec4(Origin, 1.f)),
+                glm::vec3(toLocal * glm::vec4(Vector, 0.f))
+            );
+
+            if (!hit.Occurred)
+                return IntersectionLib::Intersection{};
+
+            // normals go through the inverse transpose, so they stay perpendicular under non-uniform scale
+            glm::vec3 normal = glm::transpose(glm::mat3(toLocal)) * hit.Normal;
+
+            return IntersectionLib::Intersection{
+                .Occurred = true,
+                .Position = Origin + Vector * hit.Time,
+                .Normal = glm::normalize(normal),
+                .Depth = 0.f,
+                .Time = hit.Time
+            };
+        }
 
+    return IntersectionLib::RayAabb(
+        Origin,
+        Vector,
+        Target->CollisionAabb.Position,
+        Target->CollisionAabb.Size - glm::vec3(2.f)
+    );
+}
+
+// `::Raycast`, without flushing transforms first
+static SpatialCastResult castRay(
+    const EcWorkspace& Workspace,
+    const glm::vec3& Origin,
+    const glm::vec3& Vector,
+    const std::vector<GameObject*>& FilterList,
+    bool FilterIsIgnoreList
+)
+{
     GameObjectManager* objectManager = GameObjectManager::Get();
+    uint32_t workspaceId = Workspace.Object->ObjectId;
 
     IntersectionLib::Intersection intersection;
     GameObject* hitObject = nullptr;
     float closestHit = FLT_MAX;
 
-    //float rayDistance = glm::length(Vector);
-    //glm::vec3 rayDirection = Vector / rayDistance;
-
-    hashTraceRay(this, Origin, roundToGrid(Origin), roundToGrid(Origin + Vector), Vector, [&](const std::vector<uint32_t>& CellObjects) -> bool
+    // return value is whether to stop, never does as later objects could be closer
+    const auto testObject = [&](uint32_t oid) -> bool
     {
-        ZoneScopedN("VisitCell");
+        GameObject* p = &objectManager->WorldArray[oid];
 
-        for (uint32_t oid : CellObjects)
-        {
-            GameObject* p = &objectManager->WorldArray[oid];
-            if (!p->Valid || p->IsDestructionPending || p->OwningWorkspace != Object->ObjectId)
-                continue;
-
-            if (FilterIsIgnoreList)
-            {
-                bool skip = false;
+        if (!passesFilter(p, workspaceId, FilterList, FilterIsIgnoreList))
+            return false;
 
-                for (const GameObject* ignore : FilterList)
-                    if (p == ignore || p->IsDescendantOf(ignore))
-                    {
-                        skip = true;
-                        break;
-                    }
+        if (EcRigidBody* crb = findCastTarget(p))
+        {
+            IntersectionLib::Intersection hit = rayCastTarget(crb, Origin, Vector);
 
-                if (skip)
-                    continue;
-            }
-            else
+            if (hit.Occurred && hit.Time < closestHit)
             {
-                bool found = false;
-
-                for (const GameObject* accept : FilterList)
-                    if (p == accept || p->IsDescendantOf(accept))
-                    {
-                        found = true;
-                        break;
-                    }
-
-                if (!found)
-                    continue;
+                intersection = hit;
+                closestHit = hit.Time;
+                hitObject = p;
             }
+        }
 
-            EcTransform* ct = p->FindComponent<EcTransform>();
-            EcRigidBody* crb = ct ? p->FindComponent<EcRigidBody>() : nullptr;
+        return false;
+    };
 
-            if (crb)
-            {
-                IntersectionLib::Intersection hit = IntersectionLib::RayAabb(
-                    Origin,
-                    Vector,
-                    crb->CollisionAabb.Position,
-                    crb->CollisionAabb.Size - glm::vec3(2.f)
-                );
+    if (Workspace.Broadphase == EnBroadphase::Tree)
+        Workspace.Tree.Raycast(Origin, Vector, testObject);
+    else
+        gridTraceRay(Origin, Vector, [&](const glm::ivec3& Cell) -> bool
+        {
+            ZoneScopedN("VisitCell");
 
-                if (hit.Occurred)
-                {
-                    crb->CurTransform = ct;
-
-                    //Gjk::RaycastResult rayResult;
-                    //IntersectionLib::CollisionPoints rhit = IntersectionLib::GjkRay(
-                    //    crb,
-                    //    Origin,
-                    //    rayDirection,
-                    //    rayDistance,
-                    //    &rayResult
-                    //);
-
-                    if (true)//(rayResult.HasIntersection)
-                    {
-                        intersection.Position = hit.Position; //rayResult.Point;
-                        intersection.Normal = hit.Normal; //-rhit.Normal;
-                        intersection.Time = hit.Time; //rayResult.Time;
-
-                        closestHit = hit.Time;//rayResult.Time;
-                        hitObject = p;
-                    }
-
-                    crb->CurTransform = nullptr;
-                }
-            }
-        }
+            Workspace.Grid.VisitCell(Cell, testObject);
 
-        if (hitObject)
-            return true; // hit something, no need to keep traversing the hash
-        else
-            return false; // keep checking for collisions further down our hash
-    });
+            if (hitObject)
+                return true; // hit something, no need to keep traversing the grid
+            else
+                return false; // keep checking for collisions further down the grid
+        });
 
     SpatialCastResult result;
 
@@ -447,18 +732,217 @@ SpatialCastResult EcWorkspace::Raycast(const glm::vec3& Origin, const glm::vec3&
         result.Object = hitObject;
         result.Position = intersection.Position;
         result.Normal = intersection.Normal;
+        result.Time = intersection.Time;
     }
 
     return result;
 }
 
+SpatialCastResult EcWorkspace::Raycast(const glm::vec3& Origin, const glm::vec3& Vector, const std::vector<GameObject*>& FilterList, bool FilterIsIgnoreList) const
+{
+    ZoneScoped;
+
+    // tested against world transforms and AABBs
+    EcTransform::s_FlushDirty();
+
+    return castRay(*this, Origin, Vector, FilterList, FilterIsIgnoreList);
+}
+
+// the packet's rays down the tree together, one `SimdMath::RayPacketAabb` per node for all of them.
+// Gives the same results as `castRay` on each
+static void castRayPacket(
+    const EcWorkspace& Workspace,
+    const glm::vec3* Origins,
+    const glm::vec3* Vectors,
+    SpatialCastResult* Results,
+    int NumRays,
+    const std::vector<GameObject*>& FilterList,
+    bool FilterIsIgnoreList
+)
+{
+    GameObjectManager* objectManager = GameObjectManager::Get();
+    uint32_t workspaceId = Workspace.Object->ObjectId;
+
+    SimdMath::RayPacket packet;
+    float closestHit[SimdMath::RayPacket::Width];
+
+    for (int l = 0; l < SimdMath::RayPacket::Width; l++)
+    {
+        if (l < NumRays)
+            packet.SetLane(l, Origins[l], Vectors[l]);
+        else
+            packet.DisableLane(l);
+
+        closestHit[l] = FLT_MAX;
+    }
+
+    Workspace.Tree.RaycastPacket(packet, [&](uint32_t oid, int LaneMask) -> bool
+    {
+        GameObject* p = &objectManager->WorldArray[oid];
+
+        if (!passesFilter(p, workspaceId, FilterList, FilterIsIgnoreList))
+            return false;
+
+        EcRigidBody* crb = findCastTarget(p);
+        if (!crb)
+            return false;
+
+        for (int l = 0; l < NumRays; l++)
+        {
+            if (!(LaneMask & (1 << l)))
+                continue;
+
+            IntersectionLib::Intersection hit = rayCastTarget(crb, Origins[l], Vectors[l]);
+
+            if (hit.Occurred && hit.Time < closestHit[l])
+            {
+                closestHit[l] = hit.Time;
+                // nothing which starts further along than this can be closer. Nodes starting exactly
+                // here still pass, like they would for `castRay`, in case of a tie
+                packet.MaxT[l] = std::min(packet.MaxT[l], hit.Time);
+
+                Results[l].Occurred = true;
+                Results[l].Object = p;
+                Results[l].Position = hit.Position;
+                Results[l].Normal = hit.Normal;
+                Results[l].Time = hit.Time;
+            }
+        }
+
+        return false;
+    });
+}
+
+void EcWorkspace::RaycastBatch(
+    std::span<const glm::vec3> Origins,
+    std::span<const glm::vec3> Vectors,
+    std::span<SpatialCastResult> Results,
+    const std::vector<GameObject*>& FilterList,
+    bool FilterIsIgnoreList,
+    bool Parallel
+) const
+{
+    ZoneScoped;
+
+    assert(Origins.size() == Vectors.size() && Results.size() == Origins.size());
+
+    EcTransform::s_FlushDirty();
+
+    size_t numRays = Origins.size();
+
+    for (SpatialCastResult& result : Results)
+        result = SpatialCastResult{};
+
+    if (Broadphase == EnBroadphase::Grid)
+    {
+        // each ray stops at the first cell it hits anything in, which won't be the same cell for
+        // rays which are otherwise close together, so they go one at a time
+        const auto castRange = [&](size_t Begin, size_t End)
+        {
+            for (size_t i = Begin; i < End; i++)
+                Results[i] = castRay(*this, Origins[i], Vectors[i], FilterList, FilterIsIgnoreList);
+        };
+
+        if (Parallel)
+            ThreadManager::Get()->ParallelFor("RaycastBatch", 0, numRays, RAYCAST_BATCH_GRAIN, castRange);
+        else
+            castRange(0, numRays);
+
+        return;
+    }
+
+    // rays from nearby which point the same way go down mostly the same branches of the tree,
+    // so they are sorted by direction octant and then by where they start, and packed in that order
+    std::vector<std::pair<uint64_t, uint32_t>> keyed(numRays);
+
+    for (size_t i = 0; i < numRays; i++)
+    {
+        const glm::vec3& v = Vectors[i];
+        uint64_t octant = (v.x < 0.f ? 1 : 0) | (v.y < 0.f ? 2 : 0) | (v.z < 0.f ? 4 : 0);
+        uint64_t key = octant << 60;
+
+        // 20 bits per axis, of grid cells around the world origin
+        for (int a = 0; a < 3; a++)
+        {
+            float cell = std::floor(Origins[i][a] / SPATIAL_HASH_GRID_SIZE);
+            // written so that NaN ends up at the bottom too
+            cell = cell >= -524288.f ? std::min(cell, 524287.f) : -524288.f;
+            key |= (uint64_t)((int64_t)cell + 524288) << (40 - a * 20);
+        }
+
+        keyed[i] = { key, (uint32_t)i };
+    }
+
+    std::sort(keyed.begin(), keyed.end());
+
+    const size_t width = SimdMath::RayPacket::Width;
+    size_t numPackets = (numRays + width - 1) / width;
+
+    const auto castPackets = [&](size_t Begin, size_t End)
+    {
+        glm::vec3 origins[width];
+        glm::vec3 vectors[width];
+        SpatialCastResult results[width];
+
+        for (size_t packet = Begin; packet < End; packet++)
+        {
+            size_t first = packet * width;
+            int numLanes = (int)std::min(width, numRays - first);
+
+            for (int l = 0; l < numLanes; l++)
+            {
+                uint32_t ray = keyed[first + l].second;
+
+                origins[l] = Origins[ray];
+                vectors[l] = Vectors[ray];
+                results[l] = SpatialCastResult{};
+            }
+
+            castRayPacket(*this, origins, vectors, results, numLanes, FilterList, FilterIsIgnoreList);
+
+            for (int l = 0; l < numLanes; l++)
+                Results[keyed[first + l].second] = results[l];
+        }
+    };
+
+    if (Parallel)
+        ThreadManager::Get()->ParallelFor("RaycastBatch", 0, numPackets, RAYCAST_BATCH_GRAIN / width, castPackets);
+    else
+        castPackets(0, numPackets);
+}
+
 std::vector<GameObject*> EcWorkspace::GetObjectsInAabb(const glm::vec3& Position, const glm::vec3& Size, const std::vector<GameObject*>& IgnoreList) const
 {
-    IntersectionLib::Intersection intersection;
+    ZoneScoped;
+
     std::vector<GameObject*> hits;
 
-    for (const ObjectHandle& p : Object->GetDescendants())
+    EcTransform::s_FlushDirty();
+
+    GameObjectManager* objectManager = GameObjectManager::Get();
+
+    // the grid can give the same object more than once
+    std::vector<uint32_t> candidates;
+
+    VisitBroadphase(Position - Size / 2.f, Position + Size / 2.f, [&candidates](uint32_t oid)
+    {
+        candidates.push_back(oid);
+        return false;
+    });
+
+    if (Broadphase == EnBroadphase::Grid)
     {
+        std::sort(candidates.begin(), candidates.end());
+        candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+    }
+
+    for (uint32_t oid : candidates)
+    {
+        GameObject* p = &objectManager->WorldArray[oid];
+
+        if (!p->Valid || p->IsDestructionPending || p->OwningWorkspace != Object->ObjectId)
+            continue;
+
         if (std::find(IgnoreList.begin(), IgnoreList.end(), p) != IgnoreList.end())
             continue;
     
@@ -478,13 +962,158 @@ std::vector<GameObject*> EcWorkspace::GetObjectsInAabb(const glm::vec3& Position
             );
         
             if (hit.Occurred)
-                hits.push_back(p.Dereference());
+                hits.push_back(p);
         }
     }
 
     return hits;
 }
 
+// bodies whose AABBs overlap the box, and which get through the filters, in order of ObjectId
+static std::vector<EcRigidBody*> findQueryBodies(
+    const EcWorkspace& Workspace,
+    const glm::vec3& Min,
+    const glm::vec3& Max,
+    const std::vector<GameObject*>& FilterList,
+    bool FilterIsIgnoreList,
+    uint32_t CollisionGroups
+)
+{
+    GameObjectManager* objectManager = GameObjectManager::Get();
+    uint32_t workspaceId = Workspace.Object->ObjectId;
+
+    // the grid can give the same object more than once
+    std::vector<uint32_t> candidates;
+
+    Workspace.VisitBroadphase(Min, Max, [&candidates](uint32_t oid)
+    {
+        candidates.push_back(oid);
+        return false;
+    });
+
+    std::sort(candidates.begin(), candidates.end());
+    candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+
+    std::vector<EcRigidBody*> bodies;
+
+    for (uint32_t oid : candidates)
+    {
+        GameObject* p = &objectManager->WorldArray[oid];
+
+        if (!passesFilter(p, workspaceId, FilterList, FilterIsIgnoreList))
+            continue;
+
+        EcRigidBody* crb = findCastTarget(p);
+
+        if (!crb || !(CollisionGroups & (1u << crb->CollisionGroup)))
+            continue;
+
+        // the broadphase only gives a rough idea
+        glm::vec3 bodyMin = crb->CollisionAabb.Position - crb->CollisionAabb.Size / 2.f;
+        glm::vec3 bodyMax = crb->CollisionAabb.Position + crb->CollisionAabb.Size / 2.f;
+
+        if (glm::any(glm::greaterThan(bodyMin, Max)) || glm::any(glm::lessThan(bodyMax, Min)))
+            continue;
+
+        bodies.push_back(crb);
+    }
+
+    return bodies;
+}
+
+SpatialCastResult EcWorkspace::Shapecast(
+    const Gjk::Shape& Shape,
+    const glm::vec3& Vector,
+    const std::vector<GameObject*>& FilterList,
+    bool FilterIsIgnoreList,
+    uint32_t CollisionGroups
+) const
+{
+    ZoneScoped;
+
+    EcTransform::s_FlushDirty();
+
+    glm::vec3 min;
+    glm::vec3 max;
+    Gjk::FindBounds(Shape, &min, &max);
+
+    std::vector<EcRigidBody*> bodies = findQueryBodies(
+        *this,
+        glm::min(min, min + Vector),
+        glm::max(max, max + Vector),
+        FilterList,
+        FilterIsIgnoreList,
+        CollisionGroups
+    );
+
+    SpatialCastResult result;
+    result.Time = FLT_MAX;
+
+    for (EcRigidBody* crb : bodies)
+    {
+        // the body is A, so that the normal points from it towards the shape
+        IntersectionLib::SweptIntersection sweep = IntersectionLib::SweptGjk(Gjk::MakeShape(crb), Shape, Vector, 0.f);
+
+        if (sweep.Hit.Occurred && sweep.Time < result.Time)
+        {
+            result.Occurred = true;
+            result.Object = crb->Object;
+            result.Position = sweep.Hit.Position;
+            result.Normal = sweep.Hit.Normal;
+            result.Time = sweep.Time;
+        }
+    }
+
+    if (!result.Occurred)
+        result.Time = 0.f;
+
+    return result;
+}
+
+std::vector<GameObject*> EcWorkspace::Overlap(
+    const Gjk::Shape& Shape,
+    const std::vector<GameObject*>& FilterList,
+    bool FilterIsIgnoreList,
+    uint32_t CollisionGroups
+) const
+{
+    ZoneScoped;
+
+    EcTransform::s_FlushDirty();
+
+    glm::vec3 min;
+    glm::vec3 max;
+    Gjk::FindBounds(Shape, &min, &max);
+
+    std::vector<GameObject*> overlapping;
+
+    for (EcRigidBody* crb : findQueryBodies(*this, min, max, FilterList, FilterIsIgnoreList, CollisionGroups))
+        if (IntersectionLib::Overlaps(Gjk::MakeShape(crb), Shape))
+            overlapping.push_back(crb->Object);
+
+    return overlapping;
+}
+
+void EcWorkspace::SetBroadphase(EnBroadphase NewBroadphase)
+{
+    if (NewBroadphase == Broadphase)
+        return;
+
+    ZoneScoped;
+
+    // every proxy goes with these, so all of the bodies need putting back in
+    Grid.Clear();
+    Tree.Clear();
+    Broadphase = NewBroadphase;
+
+    for (EcRigidBody& crb : ComponentManager<EcRigidBody>::Get()->Components)
+        if (crb.Valid && crb.PrevWorkspace.TargetId == Object.TargetId)
+        {
+            crb.BroadphaseProxy = EcRigidBody::NullBroadphaseProxy;
+            crb.RecomputeAabb();
+        }
+}
+
 ObjectHandle EcWorkspace::GetSceneCamera() const
 {
     if (!s_FallbackCamera.HasValue())
@@ -1,4 +1,5 @@
 #include <tracy/Tracy.hpp>
+#include <bit>
 
 #include "datatype/GameObject.hpp"
 #include "Reflection.hpp"
@@ -6,9 +7,36 @@
 #include "component/DataModel.hpp"
 #include "component/Workspace.hpp"
 #include "component/Sound.hpp"
+#include "ThreadManager.hpp"
 #include "History.hpp"
 #include "Log.hpp"
 
+// `REFLECTION_EVENT`, but the callbacks live in the object's `ColdData`,
+// which only gets allocated once something connects
+#define GAMEOBJECT_COLD_EVENT(n, ...) { \
+	#n, \
+	Reflection::EventDescriptor{ \
+		.CallbackInputs = { __VA_OPT__(REFLECTION_SPAN({ __VA_ARGS__ })) }, \
+		.Connect = [](void* p, const Reflection::EventConnection& Callback) \
+		-> uint32_t \
+		{ \
+			return Reflection::EventConnect(static_cast<GameObject*>(p)->GetColdData().n##Callbacks, Callback); \
+		}, \
+		.Disconnect = [](void* p, uint32_t Id) \
+		-> void \
+		{ \
+			if (GameObject::ColdData* cold = static_cast<GameObject*>(p)->FindColdData()) \
+				Reflection::EventDisconnect(cold->n##Callbacks, Id); \
+		}, \
+		.Cleanup = [](void* p) \
+		-> void \
+		{ \
+			if (GameObject::ColdData* cold = static_cast<GameObject*>(p)->FindColdData()) \
+				Reflection::EventCleanup(cold->n##Callbacks); \
+		} \
+	} \
+}
+
 const Reflection::StaticApi GameObject::s_Api = Reflection::StaticApi{
 	.Properties = {
 		REFLECTION_PROPERTY_SIMPLE(GameObject, Name, String),
@@ -93,8 +121,10 @@ const Reflection::StaticApi GameObject::s_Api = Reflection::StaticApi{
 			[](void* p, const std::vector<Reflection::GenericValue>&) -> std::vector<Reflection::GenericValue>
 			{
 				std::vector<Reflection::GenericValue> retval;
-				for (const ObjectHandle& g : static_cast<GameObject*>(p)->GetDescendants())
-					retval.push_back(g->ToGenericValue());
+				static_cast<GameObject*>(p)->VisitDescendants([&retval](GameObject& g)
+				{
+					retval.push_back(g.ToGenericValue());
+				});
 
 				// ctor for ValueType::Array
 				return { Reflection::GenericValue(retval) };
@@ -170,11 +200,7 @@ const Reflection::StaticApi GameObject::s_Api = Reflection::StaticApi{
 				if (ec == EntityComponent::None)
 					RAISE_RT("Invalid component '{}'", inputs[0].AsStringView());
 
-				for (const ReflectorRef& ref : static_cast<GameObject*>(p)->Components)
-					if (ref.Type == ec)
-						return { true };
-
-				return { false };
+				return { static_cast<GameObject*>(p)->HasComponent(ec) };
 			}
 		} },
 
@@ -221,7 +247,7 @@ const Reflection::StaticApi GameObject::s_Api = Reflection::StaticApi{
 
 				GameObject* obj = static_cast<GameObject*>(p);
 
-				if (std::find_if(obj->Components.begin(), obj->Components.end(), [ec](const auto& a) { return a.Type == ec; }) == obj->Components.end())
+				if (!obj->HasComponent(ec))
 					return { Reflection::GenericValue::Null() };
 				else
 					return { obj->ToGenericValue() };
@@ -268,7 +294,7 @@ const Reflection::StaticApi GameObject::s_Api = Reflection::StaticApi{
 				GameObject* obj = static_cast<GameObject*>(p);
 				std::vector<Reflection::GenericValue> tags;
 
-				for (uint16_t tagId : obj->Tags)
+				for (uint16_t tagId : obj->GetTags())
 					tags.emplace_back(GameObjectManager::Get()->Collections[tagId].Name);
 
 				return { Reflection::GenericValue(tags) };
@@ -277,10 +303,10 @@ const Reflection::StaticApi GameObject::s_Api = Reflection::StaticApi{
 	},
 
 	.Events = {
-		REFLECTION_EVENT(GameObject, OnTagAdded, Reflection::ValueType::String),
-		REFLECTION_EVENT(GameObject, OnTagRemoved, Reflection::ValueType::String),
-		REFLECTION_EVENT(GameObject, OnTreeEnabledChanged, Reflection::ValueType::Boolean),
-		REFLECTION_EVENT(GameObject, OnWorkspaceChanged, Reflection::ValueType::GameObject, Reflection::ValueType::GameObject),
+		GAMEOBJECT_COLD_EVENT(OnTagAdded, Reflection::ValueType::String),
+		GAMEOBJECT_COLD_EVENT(OnTagRemoved, Reflection::ValueType::String),
+		GAMEOBJECT_COLD_EVENT(OnTreeEnabledChanged, Reflection::ValueType::Boolean),
+		GAMEOBJECT_COLD_EVENT(OnWorkspaceChanged, Reflection::ValueType::GameObject, Reflection::ValueType::GameObject),
 	}
 };
 
@@ -297,8 +323,14 @@ void* ReflectorRef::Referred() const
 {
 	if (Type == EntityComponent::None)
 		return (void*)GameObjectManager::Get()->FindById(Id);
-	else
-		return GetComponentManagerByComponentType(Type)->GetComponent(Id);
+
+	BaseComponent* component = GetComponentManagerByComponentType(Type)->GetComponent(Id);
+
+	// the component we referred to was deleted, and something else has its slot now
+	if (component && Generation != 0 && component->Generation != Generation)
+		return nullptr;
+
+	return (void*)component;
 }
 
 static ObjectHandle cloneRecursive(
@@ -314,8 +346,8 @@ static ObjectHandle cloneRecursive(
 	for (const ReflectorRef& ref : Root->Components)
 		newObj->AddComponent(ref.Type);
 
-	for (uint16_t tag : Root->Tags)
-		newObj->Tags.push_back(tag);
+	if (!Root->GetTags().empty())
+		newObj->GetColdData().Tags = Root->GetTags();
 
 	auto overwritesIt = OverwritesMap.find(Root);
 
@@ -403,6 +435,49 @@ GameObject* GameObjectManager::FindById(uint32_t Id)
 	return &obj;
 }
 
+const ComponentApiTable* GameObjectManager::GetComponentApis(uint64_t ComponentMask)
+{
+	std::unique_lock lock(m_ComponentApiTablesMutex);
+
+	std::unique_ptr<ComponentApiTable>& table = m_ComponentApiTables[ComponentMask];
+	if (table)
+		return table.get();
+
+	table = std::make_unique<ComponentApiTable>();
+
+	// members which appear in more than one component resolve to
+	// whichever comes last in `EntityComponent`, regardless of the
+	// order the components were added in
+	for (uint64_t mask = ComponentMask; mask != 0; mask &= mask - 1)
+	{
+		EntityComponent type = static_cast<EntityComponent>(std::countr_zero(mask));
+		IComponentManager* manager = ComponentManagers[static_cast<size_t>(type)];
+
+		for (const auto& it : manager->GetProperties())
+		{
+			table->Api.Properties[it.first] = &it.second;
+			table->MemberToComponent[it.first] = type;
+		}
+		for (const auto& it : manager->GetMethods())
+		{
+			table->Api.Methods[it.first] = &it.second;
+			table->MemberToComponent[it.first] = type;
+		}
+		for (const auto& it : manager->GetEvents())
+		{
+			table->Api.Events[it.first] = &it.second;
+			table->MemberToComponent[it.first] = type;
+		}
+	}
+
+	return table.get();
+}
+
+void GameObjectManager::m_ParallelChunks(const std::string_view& Name, size_t Count, size_t Grain, const std::function<void(size_t, size_t)>& Body)
+{
+	ThreadManager::Get()->ParallelFor(Name, 0, Count, Grain, Body);
+}
+
 void GameObject::IncrementHardRefs()
 {
 	HardRefCount++;
@@ -444,16 +519,19 @@ void GameObject::Destroy()
 		GameObjectManager* ObjectManager = GameObjectManager::Get();
 		HardRefCount++;
 
-		for (uint16_t tagId : Tags)
+		if (m_ColdData)
 		{
-			GameObjectManager::Collection& collection = ObjectManager->Collections[tagId];
-			if (const auto& it = std::find(collection.Items.begin(), collection.Items.end(), ObjectId); it != collection.Items.end())
-				collection.Items.erase(it);
+			for (uint16_t tagId : m_ColdData->Tags)
+			{
+				GameObjectManager::Collection& collection = ObjectManager->Collections[tagId];
+				if (const auto& it = std::find(collection.Items.begin(), collection.Items.end(), ObjectId); it != collection.Items.end())
+					collection.Items.erase(it);
 
-			Reflection::SignalEvent(collection.RemovedEvent.Callbacks, { this->ToGenericValue() }, "TagRemovedSignal");
-			Reflection::SignalEvent(OnTagRemovedCallbacks, { ObjectManager->Collections[tagId].Name }, "GameObject.OnTagRemoved");
+				Reflection::SignalEvent(collection.RemovedEvent.Callbacks, { this->ToGenericValue() }, "TagRemovedSignal");
+				Reflection::SignalEvent(m_ColdData->OnTagRemovedCallbacks, { ObjectManager->Collections[tagId].Name }, "GameObject.OnTagRemoved");
+			}
+			m_ColdData->Tags.clear();
 		}
-		Tags.clear();
 
 		for (const ReflectorRef& ref : Components)
 		{
@@ -486,6 +564,7 @@ void GameObject::Destroy()
         NextFreeId = objectManager->NextFreeId;
         objectManager->NextFreeId = ObjectId; // stole this stick from `lua_ref`
 
+		m_ColdData.reset();
 		Valid = false;
 	}
 }
@@ -541,27 +620,26 @@ void GameObject::EvaluateOwners()
 		if (newOwningWorkspace != this->OwningWorkspace)
 		{
 			GameObjectManager* objectManager = GameObjectManager::Get();
-			Reflection::SignalEvent(
-				OnWorkspaceChangedCallbacks,
-				{
-					GameObject::s_ToGenericValue(objectManager->FindById(OwningWorkspace)),
-					GameObject::s_ToGenericValue(objectManager->FindById(newOwningWorkspace)),
-				},
-				"GameObject.OnWorkspaceChanged"
-			);
-
-			this->ForEachDescendant([newOwningWorkspace](const ObjectHandle& d) noexcept -> bool {
-				d->OwningWorkspace = newOwningWorkspace;
-				return true;
+			if (m_ColdData)
+				Reflection::SignalEvent(
+					m_ColdData->OnWorkspaceChangedCallbacks,
+					{
+						GameObject::s_ToGenericValue(objectManager->FindById(OwningWorkspace)),
+						GameObject::s_ToGenericValue(objectManager->FindById(newOwningWorkspace)),
+					},
+					"GameObject.OnWorkspaceChanged"
+				);
+
+			this->VisitDescendants([newOwningWorkspace](GameObject& d) noexcept {
+				d.OwningWorkspace = newOwningWorkspace;
 			});
 			this->OwningWorkspace = newOwningWorkspace;
 		}
 
 		if (newOwningDataModel != this->OwningDataModel)
 		{
-			this->ForEachDescendant([newOwningDataModel](const ObjectHandle& d) noexcept -> bool {
-				d->OwningDataModel = newOwningDataModel;
-				return true;
+			this->VisitDescendants([newOwningDataModel](GameObject& d) noexcept {
+				d.OwningDataModel = newOwningDataModel;
 			});
 			this->OwningDataModel = newOwningDataModel;
 		}
@@ -578,19 +656,19 @@ void GameObject::EvaluateOwners()
 			newOwningWorkspace = ObjectId;
 
 		GameObjectManager* objectManager = GameObjectManager::Get();
-		Reflection::SignalEvent(
-			OnWorkspaceChangedCallbacks,
-			{
-				GameObject::s_ToGenericValue(objectManager->FindById(OwningWorkspace)),
-				GameObject::s_ToGenericValue(objectManager->FindById(newOwningWorkspace)),
-			},
-			"GameObject.OnWorkspaceChanged"
-		);
+		if (m_ColdData)
+			Reflection::SignalEvent(
+				m_ColdData->OnWorkspaceChangedCallbacks,
+				{
+					GameObject::s_ToGenericValue(objectManager->FindById(OwningWorkspace)),
+					GameObject::s_ToGenericValue(objectManager->FindById(newOwningWorkspace)),
+				},
+				"GameObject.OnWorkspaceChanged"
+			);
 
-		this->ForEachDescendant([newOwningDataModel, newOwningWorkspace](const ObjectHandle& d) noexcept -> bool {
-			d->OwningDataModel = newOwningDataModel;
-			d->OwningWorkspace = newOwningWorkspace;
-			return true;
+		this->VisitDescendants([newOwningDataModel, newOwningWorkspace](GameObject& d) noexcept {
+			d.OwningDataModel = newOwningDataModel;
+			d.OwningWorkspace = newOwningWorkspace;
 		});
 		this->OwningDataModel = newOwningDataModel;
 		this->OwningWorkspace = newOwningWorkspace;
@@ -735,7 +813,8 @@ void GameObject::SetEnabled(bool Enabled)
 			return true;
 		});
 
-		Reflection::SignalEvent(OnTreeEnabledChangedCallbacks, { TreeEnabled }, "GameObject.OnTreeEnabledChanged");
+		if (m_ColdData)
+			Reflection::SignalEvent(m_ColdData->OnTreeEnabledChangedCallbacks, { TreeEnabled }, "GameObject.OnTreeEnabledChanged");
 	}
 
 	if (EcSound* sound = FindComponent<EcSound>())
@@ -773,50 +852,28 @@ void GameObject::ForEachChild(const std::function<bool(const ObjectHandle&)>& Ca
 	ZoneScoped;
 
 	GameObjectManager* ObjectManager = GameObjectManager::Get();
-	size_t beforeSize = ObjectManager->WorldArray.size();
 
-	for (uint32_t id : Children)
+	// by index, the callback may add children to us
+	for (size_t i = 0; i < Children.size();)
 	{
-		GameObject* child = GameObjectManager::Get()->FindById(id);
+		uint32_t childId = Children[i];
+		GameObject* child = ObjectManager->FindById(childId);
 		assert(child);
 
 		if (child->Parent != ObjectId)
+		{
+			i++;
 			continue; // callback changed parents
+		}
 
 		if (bool shouldContinue = Callback(child); !shouldContinue)
 			break;
 
-		if (ObjectManager->WorldArray.size() != beforeSize)
-			RAISE_RT("Callback cannot create objects"); // `this` may get re-allocated, very very bad
-	}
-}
-
-bool GameObject::ForEachDescendant(const std::function<bool(const ObjectHandle&)>& Callback)
-{
-	ZoneScoped;
-
-	GameObjectManager* ObjectManager = GameObjectManager::Get();
-	size_t beforeSize = ObjectManager->WorldArray.size();
-
-	for (uint32_t id : Children)
-	{
-		GameObject* child = GameObjectManager::Get()->FindById(id);
-		assert(child);
-
-		if (child->Parent != ObjectId)
-			continue; // callback changed parents
-
-		if (bool shouldContinue = Callback(child); !shouldContinue)
-			return true;
-
-		if (ObjectManager->WorldArray.size() != beforeSize)
-			RAISE_RT("Callback cannot create objects"); // `this` may get re-allocated, very very bad
-
-		if (child->ForEachDescendant(Callback))
-			return true;
+		// if the callback re-parented or destroyed the child, the rest have shifted
+		// down into its place, and `i` already points at the next one
+		if (i < Children.size() && Children[i] == childId)
+			i++;
 	}
-
-	return false;
 }
 
 std::vector<ObjectHandle> GameObject::GetChildren() const
@@ -841,15 +898,11 @@ std::vector<ObjectHandle> GameObject::GetDescendants() const
 	std::vector<ObjectHandle> descendants;
 	descendants.reserve(Children.size());
 
-	for (uint32_t id : Children)
+	// doesn't modify anything
+	const_cast<GameObject*>(this)->VisitDescendants([&descendants](GameObject& d)
 	{
-		GameObject* child = GameObjectManager::Get()->FindById(id);
-		assert(child);
-		descendants.emplace_back(child);
-
-		std::vector<ObjectHandle> childrenDescendants = child->GetDescendants();
-		std::copy(childrenDescendants.begin(), childrenDescendants.end(), std::back_inserter(descendants));
-	}
+		descendants.emplace_back(&d);
+	});
 
 	return descendants;
 }
@@ -892,25 +945,18 @@ uint32_t GameObject::AddComponent(EntityComponent Type)
 		RAISE_RT("Already have that component");
 
 	IComponentManager* manager = GetComponentManagerByComponentType(Type);
-	Components.emplace_back(manager->CreateComponent(this), Type);
+	uint32_t componentId = manager->CreateComponent(this);
 
-	uint32_t componentId = Components.back().Id;
+	Components.push_back({
+		.Id = componentId,
+		.Type = Type,
+		.Generation = manager->GetComponent(componentId)->Generation
+	});
 
-	for (const auto& it : manager->GetProperties())
-	{
-		ComponentApis.Properties[it.first] = &it.second;
-		MemberToComponentMap[it.first] = Components.back();
-	}
-	for (const auto& it : manager->GetMethods())
-	{
-		ComponentApis.Methods[it.first] = &it.second;
-		MemberToComponentMap[it.first] = Components.back();
-	}
-	for (const auto& it : manager->GetEvents())
-	{
-		ComponentApis.Events[it.first] = &it.second;
-		MemberToComponentMap[it.first] = Components.back();
-	}
+	ComponentMask |= 1ull << static_cast<size_t>(Type);
+	ComponentSlots[static_cast<size_t>(Type)] = static_cast<uint8_t>(Components.size() - 1);
+
+	ComponentApis = GameObjectManager::Get()->GetComponentApis(ComponentMask);
 
 	if (History* history = History::Get(); history->IsRecordingEnabled)
 	{
@@ -931,63 +977,61 @@ void GameObject::RemoveComponent(EntityComponent Type)
 {
 	assert(Type != EntityComponent::None);
 
-	for (auto vit = Components.begin(); vit < Components.end(); vit++)
+	if (HasComponent(Type))
 	{
-		if (vit->Type == Type)
-		{
-			IComponentManager* manager = GetComponentManagerByComponentType(Type);
-			ReflectorRef ref = *vit;
+		auto vit = Components.begin() + ComponentSlots[static_cast<size_t>(Type)];
+		assert(vit->Type == Type);
+
+		IComponentManager* manager = GetComponentManagerByComponentType(Type);
+		ReflectorRef ref = *vit;
 
-			if (History* history = History::Get(); history->IsRecordingEnabled && OwningDataModel == history->TargetDataModel)
+		if (History* history = History::Get(); history->IsRecordingEnabled && OwningDataModel == history->TargetDataModel)
+		{
+			for (const auto& [ name, prop ] : manager->GetProperties())
 			{
-				for (const auto& [ name, prop ] : manager->GetProperties())
-				{
-					if (!prop.Serializes || !prop.Set)
-						continue;
-
-					Reflection::GenericValue val = GetPropertyValue(name);
-
-					// We need to keep track of all of the properties to restore
-					// when Undo'ing
-					history->RecordEvent({
-						.Target = { .Id = ObjectId },
-						.TargetObject = this,
-						.Property = &prop,
-						.PreviousValue = val,
-						.NewValue = val
-					});
-				}
+				if (!prop.Serializes || !prop.Set)
+					continue;
 
+				Reflection::GenericValue val = GetPropertyValue(name);
+
+				// We need to keep track of all of the properties to restore
+				// when Undo'ing
 				history->RecordEvent({
 					.Target = { .Id = ObjectId },
 					.TargetObject = this,
-					.Property = std::nullopt,
-					.PreviousValue = (int64_t)Type,
-					.NewValue = Reflection::GenericValue::Null()
+					.Property = &prop,
+					.PreviousValue = val,
+					.NewValue = val
 				});
 			}
 
-			Components.erase(vit);
-			manager->DeleteComponent(ref.Id);
+			history->RecordEvent({
+				.Target = { .Id = ObjectId },
+				.TargetObject = this,
+				.Property = std::nullopt,
+				.PreviousValue = (int64_t)Type,
+				.NewValue = Reflection::GenericValue::Null()
+			});
+		}
 
-			for (const auto& it2 : manager->GetProperties())
-			{
-				ComponentApis.Properties.erase(it2.first);
-				MemberToComponentMap.erase(it2.first);
-			}
-			for (const auto& it2 : manager->GetMethods())
-			{
-				ComponentApis.Methods.erase(it2.first);
-				MemberToComponentMap.erase(it2.first);
-			}
-			for (const auto& it2 : manager->GetEvents())
-			{
-				ComponentApis.Events.erase(it2.first);
-				MemberToComponentMap.erase(it2.first);
-			}
+		const uint8_t removedSlot = ComponentSlots[static_cast<size_t>(Type)];
+		Components.erase(vit);
+		ComponentMask &= ~(1ull << static_cast<size_t>(Type));
 
-			return;
+		// everything after it moved down by one
+		for (uint64_t mask = ComponentMask; mask != 0; mask &= mask - 1)
+		{
+			uint8_t& slot = ComponentSlots[std::countr_zero(mask)];
+
+			if (slot > removedSlot)
+				slot--;
 		}
+
+		ComponentApis = ComponentMask != 0 ? GameObjectManager::Get()->GetComponentApis(ComponentMask) : nullptr;
+
+		manager->DeleteComponent(ref.Id);
+
+		return;
 	}
 
 	RAISE_RT("Tried to remove {} component from {}, but it doesn't have that!", s_EntityComponentNames[(uint8_t)Type], GetFullName());
@@ -1004,11 +1048,14 @@ const Reflection::PropertyDescriptor* GameObject::FindProperty(const std::string
 		return &it->second;
 	}
 
-	if (auto it = ComponentApis.Properties.find(PropName); it != ComponentApis.Properties.end())
+	if (!ComponentApis)
+		return nullptr;
+
+	if (auto it = ComponentApis->Api.Properties.find(PropName); it != ComponentApis->Api.Properties.end())
 	{
-		const auto& fcit = MemberToComponentMap.find(PropName);
-		assert(fcit != MemberToComponentMap.end());
-		*Reflector = fcit->second;
+		const auto& fcit = ComponentApis->MemberToComponent.find(PropName);
+		assert(fcit != ComponentApis->MemberToComponent.end());
+		*Reflector = Components[ComponentSlots[static_cast<size_t>(fcit->second)]];
 
 		assert(Reflector->Referred());
 		return it->second;
@@ -1028,11 +1075,14 @@ const Reflection::MethodDescriptor* GameObject::FindMethod(const std::string_vie
 		return &it->second;
 	}
 
-	if (auto it = ComponentApis.Methods.find(FuncName); it != ComponentApis.Methods.end())
+	if (!ComponentApis)
+		return nullptr;
+
+	if (auto it = ComponentApis->Api.Methods.find(FuncName); it != ComponentApis->Api.Methods.end())
 	{
-		const auto& fcit = MemberToComponentMap.find(FuncName);
-		assert(fcit != MemberToComponentMap.end());
-		*Reflector = fcit->second;
+		const auto& fcit = ComponentApis->MemberToComponent.find(FuncName);
+		assert(fcit != ComponentApis->MemberToComponent.end());
+		*Reflector = Components[ComponentSlots[static_cast<size_t>(fcit->second)]];
 
 		assert(Reflector->Referred());
 		return it->second;
@@ -1052,11 +1102,14 @@ const Reflection::EventDescriptor* GameObject::FindEvent(const std::string_view&
 		return &it->second;
 	}
 
-	if (auto it = ComponentApis.Events.find(EventName); it != ComponentApis.Events.end())
+	if (!ComponentApis)
+		return nullptr;
+
+	if (auto it = ComponentApis->Api.Events.find(EventName); it != ComponentApis->Api.Events.end())
 	{
-		const auto& fcit = MemberToComponentMap.find(EventName);
-		assert(fcit != MemberToComponentMap.end());
-		*Reflector = fcit->second;
+		const auto& fcit = ComponentApis->MemberToComponent.find(EventName);
+		assert(fcit != ComponentApis->MemberToComponent.end());
+		*Reflector = Components[ComponentSlots[static_cast<size_t>(fcit->second)]];
 
 		assert(Reflector->Referred());
 		return it->second;
@@ -1156,7 +1209,7 @@ std::vector<Reflection::GenericValue> GameObject::CallMethod(const std::string_v
 Reflection::PropertyMap GameObject::GetProperties() const
 {
 	// base APIs always take priority for consistency
-	Reflection::PropertyMap cumulativeProps = ComponentApis.Properties;
+	Reflection::PropertyMap cumulativeProps = ComponentApis ? ComponentApis->Api.Properties : Reflection::PropertyMap{};
 
 	for (const auto& it : s_Api.Properties)
 		cumulativeProps.insert(std::pair(it.first, &it.second));
@@ -1166,7 +1219,7 @@ Reflection::PropertyMap GameObject::GetProperties() const
 
 Reflection::MethodMap GameObject::GetMethods() const
 {
-	Reflection::MethodMap cumulativeFuncs = ComponentApis.Methods;
+	Reflection::MethodMap cumulativeFuncs = ComponentApis ? ComponentApis->Api.Methods : Reflection::MethodMap{};
 
 	for (const auto& it : s_Api.Methods)
 		cumulativeFuncs.insert(std::pair(it.first, &it.second));
@@ -1176,7 +1229,7 @@ Reflection::MethodMap GameObject::GetMethods() const
 
 Reflection::EventMap GameObject::GetEvents() const
 {
-	Reflection::EventMap cumulativeEvents = ComponentApis.Events;
+	Reflection::EventMap cumulativeEvents = ComponentApis ? ComponentApis->Api.Events : Reflection::EventMap{};
 
 	for (const auto& it : s_Api.Events)
 		cumulativeEvents.insert(std::pair(it.first, &it.second));
@@ -1188,11 +1241,11 @@ void* GameObject::FindComponentByType(EntityComponent Type) const
 {
 	assert(Type != EntityComponent::None);
 
-	for (const ReflectorRef& ref : Components)
-		if (ref.Type == Type)
-			return GetComponentManagerByComponentType(Type)->GetComponent(ref.Id);
-	
-	return nullptr;
+	if (!HasComponent(Type))
+		return nullptr;
+
+	const ReflectorRef& ref = Components[ComponentSlots[static_cast<size_t>(Type)]];
+	return GameObjectManager::Get()->ComponentManagers[static_cast<size_t>(Type)]->GetComponent(ref.Id);
 }
 
 ObjectHandle GameObjectManager::Create()
@@ -1213,11 +1266,6 @@ ObjectHandle GameObjectManager::Create()
 	    if (id >= UINT32_MAX - 1)
 	        RAISE_RT("Reached end of GameObject ID space (2^32 - 1)");
 
-#ifndef NDEBUG
-    // cause as many re-allocations as possible to catch stale pointers
-    WorldArray.shrink_to_fit();
-#endif
-
 	    WorldArray.emplace_back();
     }
     else
@@ -1311,15 +1359,16 @@ void GameObject::AddTag(const std::string& Tag)
 		RAISE_RT("Cannot call `:AddTag` on Object {} which was destroyed", GetFullName());
 
 	GameObjectManager::Collection& collection = GameObjectManager::Get()->GetCollection(Tag);
-	bool alreadyHave = std::find(Tags.begin(), Tags.end(), collection.Id) != Tags.end();
+	ColdData& cold = GetColdData();
+	bool alreadyHave = std::find(cold.Tags.begin(), cold.Tags.end(), collection.Id) != cold.Tags.end();
 
 	if (!alreadyHave)
 	{
-		Tags.push_back(collection.Id);
+		cold.Tags.push_back(collection.Id);
 		collection.Items.push_back(ObjectId);
 
 		Reflection::SignalEvent(collection.AddedEvent.Callbacks, { this->ToGenericValue() }, "TagAddedSignal");
-		Reflection::SignalEvent(OnTagAddedCallbacks, { Tag }, "GameObject.OnTagAdded");
+		Reflection::SignalEvent(cold.OnTagAddedCallbacks, { Tag }, "GameObject.OnTagAdded");
 
 		if (History* history = History::Get(); history->IsRecordingEnabled)
 		{
@@ -1341,18 +1390,19 @@ void GameObject::RemoveTag(const std::string& Tag)
 	GameObjectManager* ObjectManager = GameObjectManager::Get();
 	const auto& it = ObjectManager->CollectionNameToId.find(Tag);
 
-	if (it == ObjectManager->CollectionNameToId.end())
+	if (it == ObjectManager->CollectionNameToId.end() || !m_ColdData)
 		return;
 
-	const auto& tagIt = std::find(Tags.begin(), Tags.end(), it->second);
-	if (tagIt != Tags.end())
+	std::vector<uint16_t>& tags = m_ColdData->Tags;
+	const auto& tagIt = std::find(tags.begin(), tags.end(), it->second);
+	if (tagIt != tags.end())
 	{
-		Tags.erase(tagIt);
+		tags.erase(tagIt);
 
 		GameObjectManager::Collection& collection = ObjectManager->Collections[it->second];
 		collection.Items.erase(std::find(collection.Items.begin(), collection.Items.end(), ObjectId));
 		Reflection::SignalEvent(collection.RemovedEvent.Callbacks, { this->ToGenericValue() }, "OnTagRemovedSignal");
-		Reflection::SignalEvent(OnTagRemovedCallbacks, { Tag }, "GameObject.OnTagRemoved");
+		Reflection::SignalEvent(m_ColdData->OnTagRemovedCallbacks, { Tag }, "GameObject.OnTagRemoved");
 
 		if (History* history = History::Get(); history->IsRecordingEnabled)
 		{
@@ -1397,8 +1447,32 @@ bool GameObject::HasTag(const std::string& Tag) const
 	if (it == ObjectManager->CollectionNameToId.end())
 		return false;
 
-	const auto& tagIt = std::find(Tags.begin(), Tags.end(), it->second);
-	return tagIt != Tags.end();
+	const std::vector<uint16_t>& tags = GetTags();
+	return std::find(tags.begin(), tags.end(), it->second) != tags.end();
+}
+
+void* GameObject::ColdData::operator new(size_t Size)
+{
+	return Memory::Alloc(static_cast<uint32_t>(Size), MEMCAT(GameObject));
+}
+
+void GameObject::ColdData::operator delete(void* Pointer)
+{
+	Memory::Free(Pointer);
+}
+
+GameObject::ColdData& GameObject::GetColdData()
+{
+	if (!m_ColdData)
+		m_ColdData = std::make_unique<ColdData>();
+
+	return *m_ColdData;
+}
+
+const std::vector<uint16_t>& GameObject::GetTags() const
+{
+	static const std::vector<uint16_t> NoTags;
+	return m_ColdData ? m_ColdData->Tags : NoTags;
 }
 
 static void dumpProperties(const Reflection::StaticPropertyMap Properties, nlohmann::json& Json)
@@ -0,0 +1,300 @@
+// AabbTree.cpp, 17/10/2026
+// Insertion and balancing follow Erin Catto's `b2DynamicTree` from Box2D,
+// with surface area in place of perimeter as the cost
+
+#include <tracy/Tracy.hpp>
+#include <glm/vector_relational.hpp>
+#include <algorithm>
+
+#include "geometry/AabbTree.hpp"
+
+static float surfaceArea(const glm::vec3& Min, const glm::vec3& Max)
+{
+    glm::vec3 d = Max - Min;
+    return 2.f * (d.x * d.y + d.y * d.z + d.z * d.x);
+}
+
+uint32_t AabbTree::m_AllocateNode()
+{
+    uint32_t index = m_FreeList;
+
+    if (index != NullNode)
+        m_FreeList = m_Nodes[index].Parent;
+    else
+    {
+        index = static_cast<uint32_t>(m_Nodes.size());
+        m_Nodes.emplace_back();
+    }
+
+    m_Nodes[index] = Node{ .Height = 0 };
+    return index;
+}
+
+void AabbTree::m_FreeNode(uint32_t Index)
+{
+    m_Nodes[Index] = Node{ .Parent = m_FreeList, .Height = -1 };
+    m_FreeList = Index;
+}
+
+uint32_t AabbTree::CreateProxy(const glm::vec3& Min, const glm::vec3& Max, uint32_t ObjectId)
+{
+    uint32_t leaf = m_AllocateNode();
+    Node& node = m_Nodes[leaf];
+
+    node.Min = Min - glm::vec3(FatMargin);
+    node.Max = Max + glm::vec3(FatMargin);
+    node.ObjectId = ObjectId;
+
+    m_InsertLeaf(leaf);
+
+    return leaf;
+}
+
+void AabbTree::DestroyProxy(uint32_t Proxy)
+{
+    assert(Proxy < m_Nodes.size() && m_Nodes[Proxy].Height == 0);
+
+    m_RemoveLeaf(Proxy);
+    m_FreeNode(Proxy);
+}
+
+bool AabbTree::OwnsProxy(uint32_t Proxy, uint32_t ObjectId) const
+{
+    return Proxy < m_Nodes.size() && m_Nodes[Proxy].Height == 0 && m_Nodes[Proxy].ObjectId == ObjectId;
+}
+
+bool AabbTree::MoveProxy(uint32_t Proxy, const glm::vec3& Min, const glm::vec3& Max)
+{
+    Node& node = m_Nodes[Proxy];
+    assert(node.Height == 0);
+
+    if (glm::all(glm::lessThanEqual(node.Min, Min)) && glm::all(glm::greaterThanEqual(node.Max, Max)))
+        return false;
+
+    m_RemoveLeaf(Proxy);
+
+    // `m_RemoveLeaf` doesn't move nodes around in memory, `node` is still fine
+    node.Min = Min - glm::vec3(FatMargin);
+    node.Max = Max + glm::vec3(FatMargin);
+
+    m_InsertLeaf(Proxy);
+
+    return true;
+}
+
+void AabbTree::Clear()
+{
+    m_Nodes = {};
+    m_Root = NullNode;
+    m_FreeList = NullNode;
+}
+
+int AabbTree::GetHeight() const
+{
+    return m_Root == NullNode ? 0 : m_Nodes[m_Root].Height;
+}
+
+void AabbTree::m_InsertLeaf(uint32_t Leaf)
+{
+    ZoneScoped;
+
+    if (m_Root == NullNode)
+    {
+        m_Root = Leaf;
+        m_Nodes[Leaf].Parent = NullNode;
+        return;
+    }
+
+    const glm::vec3 leafMin = m_Nodes[Leaf].Min;
+    const glm::vec3 leafMax = m_Nodes[Leaf].Max;
+
+    // find the best sibling, by the cost of the new parent plus how much
+    // every ancestor's area would grow on the way down
+    uint32_t index = m_Root;
+
+    while (!m_Nodes[index].IsLeaf())
+    {
+        const Node& node = m_Nodes[index];
+
+        float area = surfaceArea(node.Min, node.Max);
+        float combinedArea = surfaceArea(glm::min(node.Min, leafMin), glm::max(node.Max, leafMax));
+
+        // cost of creating a new parent for this node and the leaf
+        float cost = 2.f * combinedArea;
+        // minimum cost of pushing the leaf further down
+        float inheritanceCost = 2.f * (combinedArea - area);
+
+        const auto descendCost = [&](uint32_t Child)
+        {
+            const Node& c = m_Nodes[Child];
+            float enlarged = surfaceArea(glm::min(c.Min, leafMin), glm::max(c.Max, leafMax));
+
+            return (c.IsLeaf() ? enlarged : enlarged - surfaceArea(c.Min, c.Max)) + inheritanceCost;
+        };
+
+        float cost1 = descendCost(node.Child1);
+        float cost2 = descendCost(node.Child2);
+
+        if (cost < cost1 && cost < cost2)
+            break;
+
+        index = cost1 < cost2 ? node.Child1 : node.Child2;
+    }
+
+    uint32_t sibling = index;
+    uint32_t oldParent = m_Nodes[sibling].Parent;
+    uint32_t newParent = m_AllocateNode();
+
+    {
+        Node& parent = m_Nodes[newParent];
+        parent.Parent = oldParent;
+        parent.Min = glm::min(leafMin, m_Nodes[sibling].Min);
+        parent.Max = glm::max(leafMax, m_Nodes[sibling].Max);
+        parent.Height = m_Nodes[sibling].Height + 1;
+        parent.Child1 = sibling;
+        parent.Child2 = Leaf;
+    }
+
+    if (oldParent != NullNode)
+    {
+        if (m_Nodes[oldParent].Child1 == sibling)
+            m_Nodes[oldParent].Child1 = newParent;
+        else
+            m_Nodes[oldParent].Child2 = newParent;
+    }
+    else
+        m_Root = newParent;
+
+    m_Nodes[sibling].Parent = newParent;
+    m_Nodes[Leaf].Parent = newParent;
+
+    m_Refit(m_Nodes[Leaf].Parent);
+}
+
+void AabbTree::m_RemoveLeaf(uint32_t Leaf)
+{
+    ZoneScoped;
+
+    if (Leaf == m_Root)
+    {
+        m_Root = NullNode;
+        return;
+    }
+
+    uint32_t parent = m_Nodes[Leaf].Parent;
+    uint32_t grandParent = m_Nodes[parent].Parent;
+    uint32_t sibling = m_Nodes[parent].Child1 == Leaf ? m_Nodes[parent].Child2 : m_Nodes[parent].Child1;
+
+    // the sibling takes the parent's place
+    if (grandParent != NullNode)
+    {
+        if (m_Nodes[grandParent].Child1 == parent)
+            m_Nodes[grandParent].Child1 = sibling;
+        else
+            m_Nodes[grandParent].Child2 = sibling;
+
+        m_Nodes[sibling].Parent = grandParent;
+        m_FreeNode(parent);
+
+        m_Refit(grandParent);
+    }
+    else
+    {
+        m_Root = sibling;
+        m_Nodes[sibling].Parent = NullNode;
+        m_FreeNode(parent);
+    }
+
+    m_Nodes[Leaf].Parent = NullNode;
+}
+
+void AabbTree::m_Refit(uint32_t Index)
+{
+    while (Index != NullNode)
+    {
+        Index = m_Balance(Index);
+
+        Node& node = m_Nodes[Index];
+        const Node& child1 = m_Nodes[node.Child1];
+        const Node& child2 = m_Nodes[node.Child2];
+
+        node.Height = 1 + std::max(child1.Height, child2.Height);
+        node.Min = glm::min(child1.Min, child2.Min);
+        node.Max = glm::max(child1.Max, child2.Max);
+
+        Index = node.Parent;
+    }
+}
+
+uint32_t AabbTree::m_Balance(uint32_t IndexA)
+{
+    Node& a = m_Nodes[IndexA];
+
+    if (a.IsLeaf() || a.Height < 2)
+        return IndexA;
+
+    uint32_t indexB = a.Child1;
+    uint32_t indexC = a.Child2;
+    Node& b = m_Nodes[indexB];
+    Node& c = m_Nodes[indexC];
+
+    int balance = c.Height - b.Height;
+
+    // `C` is lower down than it should be, rotate it up
+    // (the same as below, with `B` and `C` the other way around)
+    const auto rotateUp = [this, IndexA, &a](uint32_t IndexUp, Node& Up, Node& Other, bool UpIsChild2)
+    {
+        uint32_t indexF = Up.Child1;
+        uint32_t indexG = Up.Child2;
+        Node& f = m_Nodes[indexF];
+        Node& g = m_Nodes[indexG];
+
+        // `Up` takes A's place, with A as a child
+        Up.Child1 = IndexA;
+        Up.Parent = a.Parent;
+        a.Parent = IndexUp;
+
+        if (Up.Parent != NullNode)
+        {
+            if (m_Nodes[Up.Parent].Child1 == IndexA)
+                m_Nodes[Up.Parent].Child1 = IndexUp;
+            else
+                m_Nodes[Up.Parent].Child2 = IndexUp;
+        }
+        else
+            m_Root = IndexUp;
+
+        // the taller of `Up`'s children stays with it, A takes the shorter one in `Up`'s old slot
+        uint32_t indexKeep = f.Height > g.Height ? indexF : indexG;
+        uint32_t indexGive = f.Height > g.Height ? indexG : indexF;
+        Node& keep = m_Nodes[indexKeep];
+        Node& give = m_Nodes[indexGive];
+
+        Up.Child2 = indexKeep;
+
+        if (UpIsChild2)
+            a.Child2 = indexGive;
+        else
+            a.Child1 = indexGive;
+
+        give.Parent = IndexA;
+
+        a.Min = glm::min(Other.Min, give.Min);
+        a.Max = glm::max(Other.Max, give.Max);
+        a.Height = 1 + std::max(Other.Height, give.Height);
+
+        Up.Min = glm::min(a.Min, keep.Min);
+        Up.Max = glm::max(a.Max, keep.Max);
+        Up.Height = 1 + std::max(a.Height, keep.Height);
+
+        return IndexUp;
+    };
+
+    if (balance > 1)
+        return rotateUp(indexC, c, b, true);
+
+    if (balance < -1)
+        return rotateUp(indexB, b, c, false);
+
+    return IndexA;
+}
@@ -0,0 +1,750 @@
+// ConvexDecomposition.cpp, 17/10/2026
+#include <tracy/Tracy.hpp>
+#include <glm/geometric.hpp>
+#include <glm/common.hpp>
+#include <unordered_map>
+#include <algorithm>
+#include <climits>
+#include <cfloat>
+#include <cmath>
+
+#include "geometry/ConvexDecomposition.hpp"
+
+// points closer than this fraction of the hull's size to a face are treated as on it
+static const float HULL_TOLERANCE = 1e-5f;
+// cutting planes tried along each axis of a piece, evenly spaced
+static const int SPLIT_CANDIDATES = 6;
+
+namespace
+{
+    struct HullFace
+    {
+        uint32_t V[3] = {};
+        glm::vec3 Normal = {};
+        float Offset = 0.f;
+        // points in front of the face which haven't been added to the hull yet
+        std::vector<uint32_t> Outside;
+        bool Alive = true;
+    };
+
+    // a group of voxels which will end up as one hull
+    struct Part
+    {
+        std::vector<uint32_t> Voxels;
+        float Concavity = 0.f;
+    };
+
+    struct VoxelGrid
+    {
+        glm::vec3 Origin = {};
+        float Size = 0.f;
+        int Dims[3] = {};
+
+        uint32_t Index(int X, int Y, int Z) const { return (uint32_t)(X + Dims[0] * (Y + Dims[1] * Z)); }
+
+        void Coords(uint32_t Index, int* Out) const
+        {
+            Out[0] = (int)(Index % Dims[0]);
+            Out[1] = (int)((Index / Dims[0]) % Dims[1]);
+            Out[2] = (int)(Index / (Dims[0] * Dims[1]));
+        }
+    };
+}
+
+static uint64_t edgeKey(uint32_t A, uint32_t B)
+{
+    return ((uint64_t)A << 32) | B;
+}
+
+static float distanceToFace(const HullFace& Face, const glm::vec3& Point)
+{
+    return glm::dot(Face.Normal, Point) - Face.Offset;
+}
+
+Mesh ConvexDecomposition::BuildHull(const std::vector<glm::vec3>& Points)
+{
+    ZoneScoped;
+
+    Mesh mesh;
+
+    if (Points.size() < 4)
+        return mesh;
+
+    glm::vec3 min = Points[0];
+    glm::vec3 max = Points[0];
+
+    for (const glm::vec3& p : Points)
+    {
+        min = glm::min(min, p);
+        max = glm::max(max, p);
+    }
+
+    glm::vec3 extent = max - min;
+    float tolerance = std::max(std::max(extent.x, std::max(extent.y, extent.z)) * HULL_TOLERANCE, 1e-12f);
+
+    // the starting tetrahedron is spanned by the two points furthest apart along an axis,
+    // the point furthest from the line between them, then the point furthest from that plane
+    uint32_t extremes[6] = {};
+
+    for (uint32_t i = 0; i < Points.size(); i++)
+        for (int axis = 0; axis < 3; axis++)
+        {
+            if (Points[i][axis] < Points[extremes[axis * 2]][axis])
+                extremes[axis * 2] = i;
+            if (Points[i][axis] > Points[extremes[axis * 2 + 1]][axis])
+                extremes[axis * 2 + 1] = i;
+        }
+
+    int longest = 0;
+
+    for (int axis = 1; axis < 3; axis++)
+        if (extent[axis] > extent[longest])
+            longest = axis;
+
+    uint32_t initial[4] = { extremes[longest * 2], extremes[longest * 2 + 1], 0, 0 };
+    glm::vec3 lineDirection = Points[initial[1]] - Points[initial[0]];
+    float furthest = 0.f;
+
+    for (uint32_t i = 0; i < Points.size(); i++)
+    {
+        float distance = glm::length(glm::cross(Points[i] - Points[initial[0]], lineDirection));
+
+        if (distance > furthest)
+        {
+            furthest = distance;
+            initial[2] = i;
+        }
+    }
+
+    if (furthest <= tolerance * glm::length(lineDirection))
+        return mesh;
+
+    glm::vec3 planeNormal = glm::normalize(glm::cross(lineDirection, Points[initial[2]] - Points[initial[0]]));
+    furthest = 0.f;
+
+    for (uint32_t i = 0; i < Points.size(); i++)
+    {
+        float distance = std::fabs(glm::dot(Points[i] - Points[initial[0]], planeNormal));
+
+        if (distance > furthest)
+        {
+            furthest = distance;
+            initial[3] = i;
+        }
+    }
+
+    if (furthest <= tolerance)
+        return mesh;
+
+    std::vector<HullFace> faces;
+    std::unordered_map<uint64_t, uint32_t> edgeToFace;
+
+    auto addFace = [&](uint32_t A, uint32_t B, uint32_t C)
+    {
+        HullFace face;
+        face.V[0] = A;
+        face.V[1] = B;
+        face.V[2] = C;
+        face.Normal = glm::cross(Points[B] - Points[A], Points[C] - Points[A]);
+
+        // slivers along the horizon can come out with no area to speak of
+        if (float length = glm::length(face.Normal); length > 0.f)
+            face.Normal /= length;
+
+        face.Offset = glm::dot(face.Normal, Points[A]);
+
+        uint32_t index = (uint32_t)faces.size();
+        edgeToFace[edgeKey(A, B)] = index;
+        edgeToFace[edgeKey(B, C)] = index;
+        edgeToFace[edgeKey(C, A)] = index;
+
+        faces.push_back(std::move(face));
+        return index;
+    };
+
+    // wound so that each face's normal points away from the fourth point
+    if (glm::dot(Points[initial[3]] - Points[initial[0]], planeNormal) > 0.f)
+        std::swap(initial[1], initial[2]);
+
+    addFace(initial[0], initial[1], initial[2]);
+    addFace(initial[1], initial[0], initial[3]);
+    addFace(initial[2], initial[1], initial[3]);
+    addFace(initial[0], initial[2], initial[3]);
+
+    // each point goes to the face it's furthest in front of, points behind every face are inside
+    auto assign = [&](const std::vector<uint32_t>& Candidates, uint32_t FirstFace)
+    {
+        for (uint32_t point : Candidates)
+        {
+            uint32_t best = UINT32_MAX;
+            float bestDistance = tolerance;
+
+            for (uint32_t f = FirstFace; f < faces.size(); f++)
+            {
+                float distance = distanceToFace(faces[f], Points[point]);
+
+                if (distance > bestDistance)
+                {
+                    bestDistance = distance;
+                    best = f;
+                }
+            }
+
+            if (best != UINT32_MAX)
+                faces[best].Outside.push_back(point);
+        }
+    };
+
+    std::vector<uint32_t> all(Points.size());
+    for (uint32_t i = 0; i < Points.size(); i++)
+        all[i] = i;
+
+    assign(all, 0);
+
+    std::vector<uint32_t> visible;
+    std::vector<std::pair<uint32_t, uint32_t>> horizon;
+    std::vector<uint32_t> horizonStarts;
+    std::vector<uint32_t> orphans;
+    std::vector<bool> isVisible;
+
+    // the face across the edge from `A` to `B`, `UINT32_MAX` if it's gone missing
+    auto neighbourOf = [&edgeToFace](uint32_t A, uint32_t B) -> uint32_t
+    {
+        auto it = edgeToFace.find(edgeKey(B, A));
+        return it != edgeToFace.end() ? it->second : UINT32_MAX;
+    };
+
+    for (uint32_t current = 0; current < faces.size(); current++)
+    {
+        // normally done in one go, as the face can always see its own eye. Only an eye which
+        // couldn't be added leaves it alive, and then the rest of its points are tried
+        while (faces[current].Alive && !faces[current].Outside.empty())
+        {
+            uint32_t eye = faces[current].Outside[0];
+            float eyeDistance = distanceToFace(faces[current], Points[eye]);
+
+            for (uint32_t point : faces[current].Outside)
+            {
+                float distance = distanceToFace(faces[current], Points[point]);
+
+                if (distance > eyeDistance)
+                {
+                    eyeDistance = distance;
+                    eye = point;
+                }
+            }
+
+            // flood out from the face across every face which can see the eye, the edges where that
+            // stops are the horizon. Any face it's in front of at all counts, leaving out ones it's
+            // only just in front of would leave a dent for later points to slip out through
+            visible.clear();
+            horizon.clear();
+            isVisible.assign(faces.size(), false);
+
+            visible.push_back(current);
+            isVisible[current] = true;
+
+            // rounding can leave the visible faces in more than one piece, which shows up as a missing
+            // neighbour, or a horizon which isn't a single loop. Adding the eye then would tear the hull
+            bool torn = false;
+
+            for (size_t v = 0; v < visible.size() && !torn; v++)
+            {
+                const HullFace& face = faces[visible[v]];
+
+                for (int e = 0; e < 3; e++)
+                {
+                    uint32_t neighbour = neighbourOf(face.V[e], face.V[(e + 1) % 3]);
+
+                    if (neighbour == UINT32_MAX)
+                    {
+                        torn = true;
+                        break;
+                    }
+
+                    if (isVisible[neighbour])
+                        continue;
+
+                    if (distanceToFace(faces[neighbour], Points[eye]) > 0.f)
+                    {
+                        isVisible[neighbour] = true;
+                        visible.push_back(neighbour);
+                    }
+                }
+            }
+
+            if (!torn)
+            {
+                horizonStarts.clear();
+
+                for (uint32_t f : visible)
+                {
+                    const HullFace& face = faces[f];
+
+                    for (int e = 0; e < 3; e++)
+                    {
+                        uint32_t a = face.V[e];
+                        uint32_t b = face.V[(e + 1) % 3];
+
+                        if (!isVisible[neighbourOf(a, b)])
+                        {
+                            horizon.emplace_back(a, b);
+                            horizonStarts.push_back(a);
+                        }
+                    }
+                }
+
+                // in a single loop, every corner starts exactly one edge
+                std::sort(horizonStarts.begin(), horizonStarts.end());
+                torn = horizon.size() < 3 || std::adjacent_find(horizonStarts.begin(), horizonStarts.end()) != horizonStarts.end();
+            }
+
+            // so the eye is left out. It's only just outside, or the faces wouldn't have been in
+            // doubt, so the hull ends up a touch smaller rather than broken
+            if (torn)
+            {
+                std::vector<uint32_t>& outside = faces[current].Outside;
+                outside.erase(std::find(outside.begin(), outside.end(), eye));
+                continue;
+            }
+
+            orphans.clear();
+
+            for (uint32_t f : visible)
+            {
+                HullFace& face = faces[f];
+
+                for (uint32_t point : face.Outside)
+                    if (point != eye)
+                        orphans.push_back(point);
+
+                for (int e = 0; e < 3; e++)
+                    edgeToFace.erase(edgeKey(face.V[e], face.V[(e + 1) % 3]));
+
+                face.Outside.clear();
+                face.Outside.shrink_to_fit();
+                face.Alive = false;
+            }
+
+            uint32_t firstNew = (uint32_t)faces.size();
+
+            for (const auto& [a, b] : horizon)
+                addFace(a, b, eye);
+
+            assign(orphans, firstNew);
+        }
+    }
+
+    // only the vertices the hull actually uses
+    std::vector<uint32_t> remap(Points.size(), UINT32_MAX);
+
+    for (const HullFace& face : faces)
+    {
+        if (!face.Alive)
+            continue;
+
+        for (uint32_t corner : face.V)
+        {
+            if (remap[corner] == UINT32_MAX)
+            {
+                remap[corner] = (uint32_t)mesh.Vertices.size();
+
+                Vertex vertex;
+                vertex.Position = Points[corner];
+                vertex.Normal = glm::vec3(0.f);
+                vertex.Paint = glm::vec4(1.f);
+                vertex.TextureUV = glm::vec2(0.f);
+                mesh.Vertices.push_back(vertex);
+            }
+
+            mesh.Indices.push_back(remap[corner]);
+            mesh.Vertices[remap[corner]].Normal += face.Normal;
+        }
+    }
+
+    for (Vertex& vertex : mesh.Vertices)
+        if (glm::length(vertex.Normal) > 0.f)
+            vertex.Normal = glm::normalize(vertex.Normal);
+
+    return mesh;
+}
+
+static float hullVolume(const Mesh& Hull)
+{
+    float volume = 0.f;
+
+    for (size_t i = 0; i < Hull.Indices.size(); i += 3)
+    {
+        const glm::vec3& a = Hull.Vertices[Hull.Indices[i]].Position;
+        const glm::vec3& b = Hull.Vertices[Hull.Indices[i + 1]].Position;
+        const glm::vec3& c = Hull.Vertices[Hull.Indices[i + 2]].Position;
+
+        volume += glm::dot(a, glm::cross(b, c));
+    }
+
+    return volume / 6.f;
+}
+
+// Akenine-Möller's separating axis test, with the box at the origin
+static bool triangleOverlapsBox(glm::vec3 A, glm::vec3 B, glm::vec3 C, float HalfSize)
+{
+    glm::vec3 edges[3] = { B - A, C - B, A - C };
+
+    for (const glm::vec3& edge : edges)
+        for (int axis = 0; axis < 3; axis++)
+        {
+            glm::vec3 unit = glm::vec3(0.f);
+            unit[axis] = 1.f;
+
+            glm::vec3 separating = glm::cross(unit, edge);
+            float pa = glm::dot(A, separating);
+            float pb = glm::dot(B, separating);
+            float pc = glm::dot(C, separating);
+            float radius = HalfSize * (std::fabs(separating.x) + std::fabs(separating.y) + std::fabs(separating.z));
+
+            if (std::min(pa, std::min(pb, pc)) > radius || std::max(pa, std::max(pb, pc)) < -radius)
+                return false;
+        }
+
+    for (int axis = 0; axis < 3; axis++)
+        if (std::min(A[axis], std::min(B[axis], C[axis])) > HalfSize || std::max(A[axis], std::max(B[axis], C[axis])) < -HalfSize)
+            return false;
+
+    glm::vec3 normal = glm::cross(edges[0], edges[1]);
+    float radius = HalfSize * (std::fabs(normal.x) + std::fabs(normal.y) + std::fabs(normal.z));
+
+    return std::fabs(glm::dot(normal, A)) <= radius;
+}
+
+// the corners of a group of voxels, in the mesh's space. A voxel between two others along Z
+// can't be on the hull, so only the lowest and highest of each column are used
+static std::vector<glm::vec3> voxelCorners(const VoxelGrid& Grid, const std::vector<uint32_t>& Voxels)
+{
+    std::unordered_map<uint32_t, std::pair<int, int>> columns;
+
+    for (uint32_t voxel : Voxels)
+    {
+        int c[3];
+        Grid.Coords(voxel, c);
+
+        auto [it, inserted] = columns.try_emplace((uint32_t)(c[0] + Grid.Dims[0] * c[1]), c[2], c[2]);
+
+        if (!inserted)
+        {
+            it->second.first = std::min(it->second.first, c[2]);
+            it->second.second = std::max(it->second.second, c[2]);
+        }
+    }
+
+    // shared corners are only added once, keyed by their position on the grid
+    std::unordered_map<uint64_t, bool> seen;
+    std::vector<glm::vec3> corners;
+    corners.reserve(columns.size() * 8);
+
+    for (const auto& [column, range] : columns)
+    {
+        int x = (int)(column % Grid.Dims[0]);
+        int y = (int)(column / Grid.Dims[0]);
+
+        for (int z : { range.first, range.second + 1 })
+            for (int dy = 0; dy < 2; dy++)
+                for (int dx = 0; dx < 2; dx++)
+                {
+                    uint64_t key = ((uint64_t)(x + dx) << 42) | ((uint64_t)(y + dy) << 21) | (uint64_t)z;
+
+                    if (seen.emplace(key, true).second)
+                        corners.push_back(Grid.Origin + glm::vec3((float)(x + dx), (float)(y + dy), (float)z) * Grid.Size);
+                }
+    }
+
+    return corners;
+}
+
+// how much bigger the hull of the voxels is than the voxels, relative to `TotalVolume`
+static float concavity(const VoxelGrid& Grid, const std::vector<uint32_t>& Voxels, float TotalVolume)
+{
+    if (Voxels.empty())
+        return 0.f;
+
+    float voxelsVolume = (float)Voxels.size() * Grid.Size * Grid.Size * Grid.Size;
+    float volume = hullVolume(ConvexDecomposition::BuildHull(voxelCorners(Grid, Voxels)));
+
+    return std::max(volume - voxelsVolume, 0.f) / TotalVolume;
+}
+
+// the hull `Hull` would have if it only kept its vertices furthest along `NumDirections`
+// directions spread over a sphere
+static Mesh simplifyHull(const Mesh& Hull, uint32_t NumDirections)
+{
+    std::vector<uint32_t> kept;
+    const float goldenAngle = 2.39996323f;
+
+    for (uint32_t i = 0; i < NumDirections; i++)
+    {
+        float y = 1.f - 2.f * (i + .5f) / NumDirections;
+        float radius = std::sqrt(1.f - y * y);
+        glm::vec3 direction = glm::vec3(std::cos(goldenAngle * i) * radius, y, std::sin(goldenAngle * i) * radius);
+
+        uint32_t best = 0;
+        float bestDot = -FLT_MAX;
+
+        for (uint32_t v = 0; v < Hull.Vertices.size(); v++)
+        {
+            float d = glm::dot(Hull.Vertices[v].Position, direction);
+
+            if (d > bestDot)
+            {
+                bestDot = d;
+                best = v;
+            }
+        }
+
+        kept.push_back(best);
+    }
+
+    std::sort(kept.begin(), kept.end());
+    kept.erase(std::unique(kept.begin(), kept.end()), kept.end());
+
+    std::vector<glm::vec3> points;
+    points.reserve(kept.size());
+
+    for (uint32_t v : kept)
+        points.push_back(Hull.Vertices[v].Position);
+
+    return ConvexDecomposition::BuildHull(points);
+}
+
+std::vector<Mesh> ConvexDecomposition::Decompose(const Mesh& mesh, const Settings& settings)
+{
+    ZoneScoped;
+
+    std::vector<Mesh> hulls;
+
+    if (mesh.Indices.size() < 3 || settings.Resolution == 0 || settings.MaxHulls == 0)
+        return hulls;
+
+    glm::vec3 meshMin = mesh.Vertices[mesh.Indices[0]].Position;
+    glm::vec3 meshMax = meshMin;
+
+    for (uint32_t index : mesh.Indices)
+    {
+        meshMin = glm::min(meshMin, mesh.Vertices[index].Position);
+        meshMax = glm::max(meshMax, mesh.Vertices[index].Position);
+    }
+
+    glm::vec3 extent = meshMax - meshMin;
+    float longest = std::max(extent.x, std::max(extent.y, extent.z));
+
+    if (longest <= 0.f)
+        return hulls;
+
+    // cubic voxels, with empty layers all the way around so the outside is connected. Two of them,
+    // as faces on the mesh's bounds also mark the layer they're touching
+    VoxelGrid grid;
+    grid.Size = longest / settings.Resolution;
+    grid.Origin = meshMin - glm::vec3(grid.Size * 2.f);
+
+    for (int axis = 0; axis < 3; axis++)
+        grid.Dims[axis] = (int)std::ceil(extent[axis] / grid.Size) + 4;
+
+    enum : uint8_t { Unknown, Surface, Outside };
+    std::vector<uint8_t> voxels((size_t)grid.Dims[0] * grid.Dims[1] * grid.Dims[2], Unknown);
+
+    {
+        ZoneScopedN("Voxelize");
+
+        // a hair over half, so triangles lying exactly on a boundary mark both sides
+        float halfSize = grid.Size * .5001f;
+
+        for (size_t i = 0; i + 2 < mesh.Indices.size(); i += 3)
+        {
+            glm::vec3 a = mesh.Vertices[mesh.Indices[i]].Position;
+            glm::vec3 b = mesh.Vertices[mesh.Indices[i + 1]].Position;
+            glm::vec3 c = mesh.Vertices[mesh.Indices[i + 2]].Position;
+
+            glm::vec3 lo = (glm::min(a, glm::min(b, c)) - grid.Origin) / grid.Size;
+            glm::vec3 hi = (glm::max(a, glm::max(b, c)) - grid.Origin) / grid.Size;
+            int from[3];
+            int to[3];
+
+            for (int axis = 0; axis < 3; axis++)
+            {
+                from[axis] = std::clamp((int)std::floor(lo[axis]) - 1, 0, grid.Dims[axis] - 1);
+                to[axis] = std::clamp((int)std::floor(hi[axis]) + 1, 0, grid.Dims[axis] - 1);
+            }
+
+            for (int z = from[2]; z <= to[2]; z++)
+                for (int y = from[1]; y <= to[1]; y++)
+                    for (int x = from[0]; x <= to[0]; x++)
+                    {
+                        uint32_t index = grid.Index(x, y, z);
+
+                        if (voxels[index] == Surface)
+                            continue;
+
+                        glm::vec3 center = grid.Origin + (glm::vec3((float)x, (float)y, (float)z) + .5f) * grid.Size;
+
+                        if (triangleOverlapsBox(a - center, b - center, c - center, halfSize))
+                            voxels[index] = Surface;
+                    }
+        }
+    }
+
+    // anything the outside can't reach without crossing the surface is inside. Meshes with holes
+    // let the outside in, which leaves just their surface
+    {
+        ZoneScopedN("Fill");
+
+        std::vector<uint32_t> stack = { 0 };
+        voxels[0] = Outside;
+
+        while (!stack.empty())
+        {
+            uint32_t index = stack.back();
+            stack.pop_back();
+
+            int c[3];
+            grid.Coords(index, c);
+
+            for (int axis = 0; axis < 3; axis++)
+                for (int step : { -1, 1 })
+                {
+                    int n[3] = { c[0], c[1], c[2] };
+                    n[axis] += step;
+
+                    if (n[axis] < 0 || n[axis] >= grid.Dims[axis])
+                        continue;
+
+                    uint32_t neighbour = grid.Index(n[0], n[1], n[2]);
+
+                    if (voxels[neighbour] == Unknown)
+                    {
+                        voxels[neighbour] = Outside;
+                        stack.push_back(neighbour);
+                    }
+                }
+        }
+    }
+
+    std::vector<Part> parts(1);
+
+    for (uint32_t i = 0; i < voxels.size(); i++)
+        if (voxels[i] != Outside)
+            parts[0].Voxels.push_back(i);
+
+    float totalVolume = hullVolume(BuildHull(voxelCorners(grid, parts[0].Voxels)));
+
+    if (totalVolume <= 0.f)
+        return hulls;
+
+    parts[0].Concavity = concavity(grid, parts[0].Voxels, totalVolume);
+
+    // the worst piece is cut where it leaves the two halves the least concave in total,
+    // until every piece is convex enough or there are enough of them
+    while (parts.size() < settings.MaxHulls)
+    {
+        ZoneScopedN("Split");
+
+        size_t worst = 0;
+
+        for (size_t p = 1; p < parts.size(); p++)
+            if (parts[p].Concavity > parts[worst].Concavity)
+                worst = p;
+
+        if (parts[worst].Concavity <= settings.MaxConcavity)
+            break;
+
+        const std::vector<uint32_t>& source = parts[worst].Voxels;
+        int lo[3] = { INT_MAX, INT_MAX, INT_MAX };
+        int hi[3] = { INT_MIN, INT_MIN, INT_MIN };
+
+        for (uint32_t voxel : source)
+        {
+            int c[3];
+            grid.Coords(voxel, c);
+
+            for (int axis = 0; axis < 3; axis++)
+            {
+                lo[axis] = std::min(lo[axis], c[axis]);
+                hi[axis] = std::max(hi[axis], c[axis]);
+            }
+        }
+
+        float bestCost = FLT_MAX;
+        Part bestBelow;
+        Part bestAbove;
+
+        for (int axis = 0; axis < 3; axis++)
+        {
+            int span = hi[axis] - lo[axis];
+
+            if (span < 1)
+                continue;
+
+            int numCandidates = std::min(SPLIT_CANDIDATES, span);
+
+            for (int candidate = 1; candidate <= numCandidates; candidate++)
+            {
+                // voxels at or past this coordinate go above the cut
+                int cut = lo[axis] + (span * candidate + numCandidates / 2) / (numCandidates + 1) + 1;
+                cut = std::clamp(cut, lo[axis] + 1, hi[axis]);
+
+                Part below;
+                Part above;
+
+                for (uint32_t voxel : source)
+                {
+                    int c[3];
+                    grid.Coords(voxel, c);
+                    (c[axis] < cut ? below : above).Voxels.push_back(voxel);
+                }
+
+                if (below.Voxels.empty() || above.Voxels.empty())
+                    continue;
+
+                below.Concavity = concavity(grid, below.Voxels, totalVolume);
+                above.Concavity = concavity(grid, above.Voxels, totalVolume);
+
+                float cost = below.Concavity + above.Concavity;
+
+                if (cost < bestCost)
+                {
+                    bestCost = cost;
+                    bestBelow = std::move(below);
+                    bestAbove = std::move(above);
+                }
+            }
+        }
+
+        // a single voxel, nothing left to cut
+        if (bestCost == FLT_MAX)
+        {
+            parts[worst].Concavity = 0.f;
+            continue;
+        }
+
+        parts[worst] = std::move(bestBelow);
+        parts.push_back(std::move(bestAbove));
+    }
+
+    for (const Part& part : parts)
+    {
+        // voxels on the surface stick out of it by up to a voxel, which at least
+        // shouldn't go past the mesh's bounds
+        std::vector<glm::vec3> corners = voxelCorners(grid, part.Voxels);
+
+        for (glm::vec3& corner : corners)
+            corner = glm::clamp(corner, meshMin, meshMax);
+
+        Mesh hull = BuildHull(corners);
+
+        if (hull.Vertices.size() > settings.MaxHullVertices && settings.MaxHullVertices >= 4)
+            hull = simplifyHull(hull, settings.MaxHullVertices);
+
+        // flat, from being clamped against a flat mesh's bounds
+        if (!hull.Indices.empty())
+            hulls.push_back(std::move(hull));
+    }
+
+    return hulls;
+}
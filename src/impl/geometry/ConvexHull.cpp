@@ -0,0 +1,146 @@
+// ConvexHull.cpp, 17/10/2026
+#include <tracy/Tracy.hpp>
+#include <glm/geometric.hpp>
+#include <glm/common.hpp>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cassert>
+
+#include "geometry/ConvexHull.hpp"
+#include "geometry/SimdMath.hpp"
+#include "asset/Mesh.hpp"
+
+// below this, checking every vertex is quicker than walking the edges
+static const size_t HILL_CLIMB_MIN_VERTICES = 64;
+// vertices closer than this fraction of the mesh's size are treated as one
+static const float WELD_TOLERANCE = 1e-5f;
+
+ConvexHull ConvexHull::s_FromMesh(const Mesh& mesh, bool HillClimb)
+{
+    ZoneScoped;
+
+    ConvexHull hull;
+
+    if (mesh.Indices.empty())
+        return hull;
+
+    // hull meshes tend to have each corner several times over, once per face with its own normal,
+    // and not always in exactly the same place. Positions are welded on a grid much finer than
+    // the mesh, otherwise seams would cut the edges that hill-climbing walks along
+    std::vector<uint32_t> used = mesh.Indices;
+    std::sort(used.begin(), used.end());
+    used.erase(std::unique(used.begin(), used.end()), used.end());
+
+    glm::vec3 min = mesh.Vertices[used[0]].Position;
+    glm::vec3 max = min;
+
+    for (uint32_t index : used)
+    {
+        min = glm::min(min, mesh.Vertices[index].Position);
+        max = glm::max(max, mesh.Vertices[index].Position);
+    }
+
+    glm::vec3 extent = max - min;
+    float quantum = std::max(std::max(extent.x, std::max(extent.y, extent.z)) * WELD_TOLERANCE, 1e-12f);
+
+    // sorted by where they are on the grid, then by index, so the first of each weld is kept
+    std::vector<std::pair<std::array<long long, 3>, uint32_t>> keyed;
+    keyed.reserve(used.size());
+
+    for (uint32_t index : used)
+    {
+        glm::vec3 q = (mesh.Vertices[index].Position - min) / quantum;
+        keyed.push_back({ { std::llround(q.x), std::llround(q.y), std::llround(q.z) }, index });
+    }
+
+    std::sort(keyed.begin(), keyed.end());
+
+    // mesh vertex index -> hull vertex index
+    std::vector<uint32_t> remap(mesh.Vertices.size(), UINT32_MAX);
+
+    for (size_t i = 0; i < keyed.size(); i++)
+    {
+        if (i == 0 || keyed[i].first != keyed[i - 1].first)
+        {
+            const glm::vec3& position = mesh.Vertices[keyed[i].second].Position;
+
+            hull.X.push_back(position.x);
+            hull.Y.push_back(position.y);
+            hull.Z.push_back(position.z);
+        }
+
+        remap[keyed[i].second] = (uint32_t)hull.X.size() - 1;
+    }
+
+    if (!HillClimb || hull.X.size() < HILL_CLIMB_MIN_VERTICES)
+        return hull;
+
+    std::vector<std::pair<uint32_t, uint32_t>> edges;
+    edges.reserve(mesh.Indices.size() * 2);
+
+    for (size_t tri = 0; tri + 2 < mesh.Indices.size(); tri += 3)
+        for (int e = 0; e < 3; e++)
+        {
+            uint32_t a = remap[mesh.Indices[tri + e]];
+            uint32_t b = remap[mesh.Indices[tri + (e + 1) % 3]];
+
+            if (a == b)
+                continue;
+
+            edges.emplace_back(a, b);
+            edges.emplace_back(b, a);
+        }
+
+    std::sort(edges.begin(), edges.end());
+    edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+    hull.NeighbourStart.assign(hull.X.size() + 1, 0);
+    hull.Neighbours.reserve(edges.size());
+
+    for (const auto& [a, b] : edges)
+    {
+        hull.NeighbourStart[a + 1]++;
+        hull.Neighbours.push_back(b);
+    }
+
+    for (size_t i = 1; i < hull.NeighbourStart.size(); i++)
+        hull.NeighbourStart[i] += hull.NeighbourStart[i - 1];
+
+    return hull;
+}
+
+uint32_t ConvexHull::FindSupport(const glm::vec3& Direction) const
+{
+    assert(!IsEmpty());
+
+    if (Neighbours.empty())
+        return (uint32_t)SimdMath::MaxDot(X.data(), Y.data(), Z.data(), X.size(), Direction);
+
+    // on a convex hull, any vertex which isn't the furthest has a neighbour further along
+    // than it, so following the steepest edge upwards ends at the furthest one
+    uint32_t current = 0;
+    float currentDot = glm::dot(GetVertex(0), Direction);
+
+    while (true)
+    {
+        uint32_t next = current;
+
+        for (uint32_t n = NeighbourStart[current]; n < NeighbourStart[current + 1]; n++)
+        {
+            uint32_t neighbour = Neighbours[n];
+            float d = glm::dot(GetVertex(neighbour), Direction);
+
+            if (d > currentDot)
+            {
+                currentDot = d;
+                next = neighbour;
+            }
+        }
+
+        if (next == current)
+            return current;
+
+        current = next;
+    }
+}
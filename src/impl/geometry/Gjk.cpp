@@ -2,120 +2,222 @@
 // https://winter.dev/articles/gjk-algorithm
 
 #include <tracy/Tracy.hpp>
+#include <algorithm>
 #include <cassert>
 #include <cfloat>
+#include <cmath>
 
 #include "geometry/Gjk.hpp"
 #include "geometry/DecomposeTRS.hpp"
-#include "component/Mesh.hpp"
 #include "datatype/GameObject.hpp"
-#include "asset/MeshProvider.hpp"
 
-static glm::vec3 findFurthestPoint_Mesh(const EcRigidBody* Rb, glm::vec3 Direction, const Mesh& mesh, float* maxDistance, glm::vec3 maxPoint, const glm::mat4& submeshTrans = glm::mat4(1.f))
+// `Transform * Scale`, which is what the hull vertices were always put through
+static glm::mat4 scaledTransform(const glm::mat4& Transform, const glm::vec3& Scale)
 {
-	assert(mesh.MeshDataPreserved);
+	glm::mat4 m = Transform;
+	m[0] *= Scale.x;
+	m[1] *= Scale.y;
+	m[2] *= Scale.z;
 
-	EcTransform* ct = Rb->CurTransform;
-	assert(ct);
-
-	glm::vec3 size = {};
-	DecomposeTRS(ct->Transform, nullptr, nullptr, &size);
+	return m;
+}
 
-	for (uint32_t ind : mesh.Indices)
-	{
-		const Vertex& v = mesh.Vertices[ind];
+// The furthest point of an affinely-transformed hull is the transformed furthest point along the
+// direction taken into the hull's space. So only the direction gets transformed, instead of every vertex
+static void findFurthestPoint_ConvexHull(const ConvexHull& Hull, const glm::mat4& ToWorld, const glm::vec3& Direction, float* maxDistance, glm::vec3* maxPoint)
+{
+	if (Hull.IsEmpty())
+		return;
 
-		glm::vec3 vworld = glm::vec3(ct->Transform * submeshTrans * glm::vec4(v.Position * size, 1.f));
-        float distance = glm::dot(vworld, Direction);
+	glm::vec3 localDir = glm::transpose(glm::mat3(ToWorld)) * Direction;
+	glm::vec3 vworld = glm::vec3(ToWorld * glm::vec4(Hull.GetVertex(Hull.FindSupport(localDir)), 1.f));
+	float distance = glm::dot(vworld, Direction);
 
-        if (distance > *maxDistance)
-        {
-            *maxDistance = distance;
-            maxPoint = vworld;
-        }
-    }
-
-    return maxPoint;
+	if (distance > *maxDistance)
+	{
+		*maxDistance = distance;
+		*maxPoint = vworld;
+	}
 }
 
-static glm::vec3 findFurthestPoint_MeshComponent(const EcRigidBody* Rb, glm::vec3 Direction)
+static glm::vec3 findFurthestPoint_MeshComponent(const Gjk::Shape& S, glm::vec3 Direction)
 {
-	EcMesh* cm = Rb->Object->FindComponent<EcMesh>();
-
-	uint32_t meshId = cm ? cm->RenderMeshId : 0;
-	const Mesh& mesh = MeshProvider::Get()->GetMeshResource(meshId);
+	assert(S.MeshHull);
 
 	float maxDistance = -FLT_MAX;
-	return findFurthestPoint_Mesh(Rb, Direction, mesh, &maxDistance, glm::vec3(0.f));
+	glm::vec3 maxPoint = {};
+	findFurthestPoint_ConvexHull(*S.MeshHull, scaledTransform(S.Transform, S.Scale), Direction, &maxDistance, &maxPoint);
+
+	return maxPoint;
 }
 
-static glm::vec3 findFurthestPoint_Cube(const EcRigidBody* Rb, glm::vec3 Direction)
+static glm::vec3 findFurthestPoint_Cube(const Gjk::Shape& S, glm::vec3 Direction)
 {
-	glm::mat3 rotation = glm::mat3(Rb->CurTransform->Transform);
-	glm::vec3 size = {};
-	DecomposeTRS(Rb->CurTransform->Transform, nullptr, nullptr, &size);
+	glm::mat3 rotation = glm::mat3(S.Transform);
 
 	glm::vec3 localDir = glm::transpose(rotation) * Direction;
 	glm::vec3 result;
 
-	glm::vec3 halfSize = size / 2.f;
+	glm::vec3 halfSize = S.Scale / 2.f;
 
 	result.x = (localDir.x > 0.f) ? halfSize.x : -halfSize.x;
 	result.y = (localDir.y > 0.f) ? halfSize.y : -halfSize.y;
 	result.z = (localDir.z > 0.f) ? halfSize.z : -halfSize.z;
 
-	return rotation * result + glm::vec3(Rb->CurTransform->Transform[3]);
+	return rotation * result + glm::vec3(S.Transform[3]);
 }
 
-static glm::vec3 findFurthestPoint_Sphere(const EcRigidBody* Rb, glm::vec3 Direction)
+static glm::vec3 findFurthestPoint_Sphere(const Gjk::Shape& S, glm::vec3 Direction)
 {
-	glm::vec3 center = glm::vec3(Rb->CurTransform->Transform[3]);
+	glm::vec3 center = glm::vec3(S.Transform[3]);
 
 	if (glm::length(Direction) < 0.0001f)
 		return center;
 
-	glm::vec3 size = {};
-	DecomposeTRS(Rb->CurTransform->Transform, nullptr, nullptr, &size);
-
-	return center + glm::normalize(Direction) * (size.x / 2.f);
+	return center + glm::normalize(Direction) * (S.Scale.x / 2.f);
 }
 
-static glm::vec3 findFurthestPoint_Hulls(const EcRigidBody* Rb, glm::vec3 Direction)
+static glm::vec3 findFurthestPoint_Hulls(const Gjk::Shape& S, glm::vec3 Direction)
 {
-	MeshProvider* meshProv = MeshProvider::Get();
 	float maxDistance = -FLT_MAX;
 	glm::vec3 maxPoint = {};
 
-	for (const EcRigidBody::Hull& hull : Rb->Hulls)
-	{
-		const Mesh& mesh = meshProv->GetMeshResource(hull.MeshId);
-		maxPoint = findFurthestPoint_Mesh(Rb, Direction, mesh, &maxDistance, maxPoint, hull.Transform);
-	}
+	// the hulls are placed in the body's unit space, like its mesh's vertices are, so its
+	// scale goes on top of their transforms. That also scales the offsets between them
+	glm::mat4 toWorld = scaledTransform(S.Transform, S.Scale);
+
+	for (const EcRigidBody::Hull& hull : S.Body->Hulls)
+		findFurthestPoint_ConvexHull(hull.Convex, toWorld * hull.Transform, Direction, &maxDistance, &maxPoint);
+
+	return maxPoint;
+}
+
+static glm::vec3 findFurthestPoint_Triangle(const Gjk::Shape& S, glm::vec3 Direction)
+{
+	const glm::vec3* corners = S.Triangle;
+	float d0 = glm::dot(corners[0], Direction);
+	float d1 = glm::dot(corners[1], Direction);
+	float d2 = glm::dot(corners[2], Direction);
+
+	if (d0 >= d1 && d0 >= d2)
+		return corners[0];
 
-	return Rb->Hulls.size() > 0 ? maxPoint : glm::vec3();
+	return d1 >= d2 ? corners[1] : corners[2];
 }
 
-static glm::vec3 findFurthestPoint(const EcRigidBody* Rb, glm::vec3 Direction)
+static glm::vec3 findFurthestPoint(const Gjk::Shape& S, glm::vec3 Direction)
 {
-	switch (Rb->CollisionType)
+	switch (S.CollisionType)
 	{
 	case EnCollisionType::Sphere:
-		return findFurthestPoint_Sphere(Rb, Direction);
+		return findFurthestPoint_Sphere(S, Direction);
 
 	case EnCollisionType::Hulls:
-		return findFurthestPoint_Hulls(Rb, Direction);
+		return findFurthestPoint_Hulls(S, Direction);
 
 	case EnCollisionType::MeshComponent:
-		return  findFurthestPoint_MeshComponent(Rb, Direction);
+		return findFurthestPoint_MeshComponent(S, Direction);
+
+	case EnCollisionType::MeshTriangles:
+		return S.Triangle ? findFurthestPoint_Triangle(S, Direction) : findFurthestPoint_MeshComponent(S, Direction);
 
 	case EnCollisionType::Cube: default:
-		return findFurthestPoint_Cube(Rb, Direction);
+		return findFurthestPoint_Cube(S, Direction);
 	}
 }
 
 using namespace Gjk;
 
-SupportPoint Gjk::Support(const EcRigidBody* A, const EcRigidBody* B, const glm::vec3& Direction)
+// the support functions apply `Shape::Scale` themselves, so it has to be taken out of the transform.
+// Leaving it in used to make everything but spheres collide as if it were scaled twice, e.g. a Cube
+// scaled to (4, 16, 4) reached 32 above its center instead of 8
+static void splitScale(const glm::mat4& Transform, glm::mat4* Unscaled, glm::vec3* Scale)
+{
+	*Unscaled = Transform;
+	DecomposeTRS(Transform, nullptr, nullptr, Scale);
+
+	for (int i = 0; i < 3; i++)
+		if ((*Scale)[i] != 0.f)
+			(*Unscaled)[i] /= (*Scale)[i];
+}
+
+Shape Gjk::MakeShape(EcRigidBody* Rb)
+{
+	assert(Rb);
+
+	EcTransform* ct = Rb->Object->FindComponent<EcTransform>();
+
+	bool isMesh = Rb->CollisionType == EnCollisionType::MeshComponent || Rb->CollisionType == EnCollisionType::MeshTriangles;
+
+	Shape shape = {
+		.Body = Rb,
+		.MeshHull = isMesh ? &Rb->GetMeshComponentHull() : nullptr,
+		// only static bodies, a concave body with dynamics would need mass properties
+		// and a solver that copes with more than one contact against it
+		.Triangles = Rb->CollisionType == EnCollisionType::MeshTriangles && !Rb->PhysicsDynamics ? Rb->GetMeshTriangles() : nullptr,
+		.CollisionType = Rb->CollisionType
+	};
+	splitScale(ct ? ct->Transform : glm::mat4(1.f), &shape.Transform, &shape.Scale);
+
+	return shape;
+}
+
+Shape Gjk::MakeSphere(const glm::vec3& Center, float Radius)
+{
+	Shape shape = { .Scale = glm::vec3(Radius * 2.f), .CollisionType = EnCollisionType::Sphere };
+	shape.Transform[3] = glm::vec4(Center, 1.f);
+
+	return shape;
+}
+
+Shape Gjk::MakeBox(const glm::mat4& Transform, const glm::vec3& Size)
+{
+	Shape shape = { .CollisionType = EnCollisionType::Cube };
+	splitScale(Transform, &shape.Transform, &shape.Scale);
+	shape.Scale = Size;
+
+	return shape;
+}
+
+Shape Gjk::MakeConvex(const ConvexHull& Hull, const glm::mat4& Transform)
+{
+	assert(!Hull.IsEmpty());
+
+	Shape shape = { .MeshHull = &Hull, .CollisionType = EnCollisionType::MeshComponent };
+	splitScale(Transform, &shape.Transform, &shape.Scale);
+
+	return shape;
+}
+
+Shape Gjk::MakeTriangle(const glm::vec3* Corners)
+{
+	assert(Corners);
+
+	Shape shape = { .Triangle = Corners, .CollisionType = EnCollisionType::MeshTriangles };
+	// only used as a starting direction by `::FindDistance`
+	shape.Transform[3] = glm::vec4((Corners[0] + Corners[1] + Corners[2]) / 3.f, 1.f);
+
+	return shape;
+}
+
+glm::mat4 Gjk::GetTrianglesToWorld(const Shape& S)
+{
+	return scaledTransform(S.Transform, S.Scale);
+}
+
+void Gjk::FindBounds(const Shape& S, glm::vec3* Min, glm::vec3* Max)
+{
+	for (int a = 0; a < 3; a++)
+	{
+		glm::vec3 axis = {};
+		axis[a] = 1.f;
+
+		(*Max)[a] = findFurthestPoint(S, axis)[a];
+		(*Min)[a] = findFurthestPoint(S, -axis)[a];
+	}
+}
+
+SupportPoint Gjk::Support(const Shape& A, const Shape& B, const glm::vec3& Direction)
 {
 	glm::vec3 pA = findFurthestPoint(A, Direction);
 	glm::vec3 pB = findFurthestPoint(B, -Direction);
@@ -123,7 +225,7 @@ SupportPoint Gjk::Support(const EcRigidBody* A, const EcRigidBody* B, const glm:
     return SupportPoint{ .P = pA - pB, .A = pA, .B = pB };
 }
 
-SupportPoint Gjk::Support(const EcRigidBody* A, const glm::vec3& Point, const glm::vec3& Direction)
+SupportPoint Gjk::Support(const Shape& A, const glm::vec3& Point, const glm::vec3& Direction)
 {
 	glm::vec3 pA = findFurthestPoint(A, Direction);
 
@@ -247,7 +349,7 @@ static bool nextSimplex(Simplex& simp, glm::vec3& direction)
     return false;
 }
 
-Result Gjk::FindIntersection(const EcRigidBody* A, const EcRigidBody* B)
+Result Gjk::FindIntersection(const Shape& A, const Shape& B)
 {
 	ZoneScoped;
 
@@ -323,7 +425,7 @@ static glm::vec3 closestPointOnSimplex(Simplex& simp)
 	return glm::vec3(0.f);
 }
 
-RaycastResult Gjk::FindRayIntersection(const EcRigidBody* A, const glm::vec3& Origin, const glm::vec3& Direction, float Distance)
+RaycastResult Gjk::FindRayIntersection(const Shape& A, const glm::vec3& Origin, const glm::vec3& Direction, float Distance)
 {
 	float t = 0.f;
 	glm::vec3 point = Origin;
@@ -389,3 +491,260 @@ RaycastResult Gjk::FindRayIntersection(const EcRigidBody* A, const glm::vec3& Or
 	Log.Error("Iteration limit exhausted in FindRayIntersection", "Gjk::FindRayIntersection");
 	return result;
 }
+
+// closest point to the origin on the triangle ABC, as weights of A, B and C.
+// Real-Time Collision Detection, Christer Ericson, 5.1.5
+static void closestOnTriangle(const glm::vec3& A, const glm::vec3& B, const glm::vec3& C, float Weights[3])
+{
+	glm::vec3 ab = B - A;
+	glm::vec3 ac = C - A;
+	glm::vec3 ap = -A;
+
+	float d1 = glm::dot(ab, ap);
+	float d2 = glm::dot(ac, ap);
+
+	if (d1 <= 0.f && d2 <= 0.f)
+	{
+		Weights[0] = 1.f; Weights[1] = 0.f; Weights[2] = 0.f;
+		return;
+	}
+
+	glm::vec3 bp = -B;
+	float d3 = glm::dot(ab, bp);
+	float d4 = glm::dot(ac, bp);
+
+	if (d3 >= 0.f && d4 <= d3)
+	{
+		Weights[0] = 0.f; Weights[1] = 1.f; Weights[2] = 0.f;
+		return;
+	}
+
+	float vc = d1 * d4 - d3 * d2;
+
+	if (vc <= 0.f && d1 >= 0.f && d3 <= 0.f)
+	{
+		float v = d1 / (d1 - d3);
+		Weights[0] = 1.f - v; Weights[1] = v; Weights[2] = 0.f;
+		return;
+	}
+
+	glm::vec3 cp = -C;
+	float d5 = glm::dot(ab, cp);
+	float d6 = glm::dot(ac, cp);
+
+	if (d6 >= 0.f && d5 <= d6)
+	{
+		Weights[0] = 0.f; Weights[1] = 0.f; Weights[2] = 1.f;
+		return;
+	}
+
+	float vb = d5 * d2 - d1 * d6;
+
+	if (vb <= 0.f && d2 >= 0.f && d6 <= 0.f)
+	{
+		float w = d2 / (d2 - d6);
+		Weights[0] = 1.f - w; Weights[1] = 0.f; Weights[2] = w;
+		return;
+	}
+
+	float va = d3 * d6 - d5 * d4;
+
+	if (va <= 0.f && (d4 - d3) >= 0.f && (d5 - d6) >= 0.f)
+	{
+		float w = (d4 - d3) / ((d4 - d3) + (d5 - d6));
+		Weights[0] = 0.f; Weights[1] = 1.f - w; Weights[2] = w;
+		return;
+	}
+
+	float denom = va + vb + vc;
+
+	// degenerate, fall back to the closest vertex
+	if (std::abs(denom) < 1e-12f)
+	{
+		float da = glm::dot(A, A), db = glm::dot(B, B), dc = glm::dot(C, C);
+		Weights[0] = (da <= db && da <= dc) ? 1.f : 0.f;
+		Weights[1] = (Weights[0] == 0.f && db <= dc) ? 1.f : 0.f;
+		Weights[2] = (Weights[0] == 0.f && Weights[1] == 0.f) ? 1.f : 0.f;
+		return;
+	}
+
+	float v = vb / denom;
+	float w = vc / denom;
+	Weights[0] = 1.f - v - w; Weights[1] = v; Weights[2] = w;
+}
+
+// whether the origin and `Opposite` are on different sides of the plane through ABC
+static bool originOutsideFace(const glm::vec3& A, const glm::vec3& B, const glm::vec3& C, const glm::vec3& Opposite)
+{
+	glm::vec3 n = glm::cross(B - A, C - A);
+	float signOrigin = glm::dot(-A, n);
+	float signOpposite = glm::dot(Opposite - A, n);
+
+	// a flat tetrahedron has no inside, every face is a candidate
+	if (signOpposite * signOpposite < 1e-12f)
+		return true;
+
+	return signOrigin * signOpposite < 0.f;
+}
+
+// reduces the simplex down to the smallest part of it containing its closest point to the origin, and
+// returns that point. `Weights` are its barycentric coordinates over what's left, none if it's enclosed
+static glm::vec3 reduceToClosest(Simplex& Simp, float Weights[4])
+{
+	std::array<SupportPoint, 4> points = Simp.Points;
+	int numUsed = 0;
+	int used[3] = {};
+	float usedWeights[3] = {};
+
+	switch (Simp.size())
+	{
+	case 1:
+	{
+		Weights[0] = 1.f;
+		return Simp[0].P;
+	}
+
+	case 2:
+	{
+		glm::vec3 a = points[0].P;
+		glm::vec3 ab = points[1].P - a;
+		float lengthSq = glm::dot(ab, ab);
+		float t = lengthSq > 1e-12f ? std::clamp(-glm::dot(a, ab) / lengthSq, 0.f, 1.f) : 0.f;
+
+		used[0] = 0; usedWeights[0] = 1.f - t;
+		used[1] = 1; usedWeights[1] = t;
+		numUsed = 2;
+
+		break;
+	}
+
+	case 3:
+	{
+		closestOnTriangle(points[0].P, points[1].P, points[2].P, usedWeights);
+		used[0] = 0; used[1] = 1; used[2] = 2;
+		numUsed = 3;
+
+		break;
+	}
+
+	case 4:
+	{
+		static const int Faces[4][4] = {
+			// the face, then the vertex opposite to it
+			{ 0, 1, 2, 3 },
+			{ 0, 2, 3, 1 },
+			{ 0, 3, 1, 2 },
+			{ 1, 3, 2, 0 }
+		};
+
+		float bestDistanceSq = FLT_MAX;
+		bool enclosed = true;
+
+		for (const int* face : Faces)
+		{
+			if (!originOutsideFace(points[face[0]].P, points[face[1]].P, points[face[2]].P, points[face[3]].P))
+				continue;
+
+			enclosed = false;
+
+			float faceWeights[3];
+			closestOnTriangle(points[face[0]].P, points[face[1]].P, points[face[2]].P, faceWeights);
+
+			glm::vec3 closest = faceWeights[0] * points[face[0]].P + faceWeights[1] * points[face[1]].P + faceWeights[2] * points[face[2]].P;
+			float distanceSq = glm::dot(closest, closest);
+
+			if (distanceSq < bestDistanceSq)
+			{
+				bestDistanceSq = distanceSq;
+
+				for (int i = 0; i < 3; i++)
+				{
+					used[i] = face[i];
+					usedWeights[i] = faceWeights[i];
+				}
+				numUsed = 3;
+			}
+		}
+
+		if (enclosed)
+			return glm::vec3(0.f);
+
+		break;
+	}
+
+	[[unlikely]] default: assert(false);
+	}
+
+	// vertices which don't contribute are dropped
+	Simp.Size = 0;
+	glm::vec3 closest = glm::vec3(0.f);
+
+	for (int i = 0; i < numUsed; i++)
+	{
+		if (usedWeights[i] <= 0.f)
+			continue;
+
+		Weights[Simp.Size] = usedWeights[i];
+		Simp.Points[Simp.Size++] = points[used[i]];
+		closest += usedWeights[i] * points[used[i]].P;
+	}
+
+	return closest;
+}
+
+// GJK as a distance query, "A Fast and Robust GJK Implementation for Collision Detection of Convex Objects",
+// Gino van den Bergen. Walks the simplex towards the origin instead of just trying to enclose it
+DistanceResult Gjk::FindDistance(const Shape& A, const Shape& B)
+{
+	ZoneScoped;
+
+	glm::vec3 direction = glm::vec3(B.Transform[3]) - glm::vec3(A.Transform[3]);
+	if (glm::dot(direction, direction) < 1e-12f)
+		direction = glm::vec3(1.f, 0.f, 0.f);
+
+	Simplex simp;
+	simp.push_front(Support(A, B, direction));
+
+	float weights[4] = {};
+	glm::vec3 closest = simp[0].P;
+
+	for (int i = 0; i < 64; i++)
+	{
+		closest = reduceToClosest(simp, weights);
+		float distanceSq = glm::dot(closest, closest);
+
+		if (simp.size() == 4 || distanceSq < 1e-10f)
+			return DistanceResult{ .Overlapping = true };
+
+		SupportPoint s = Support(A, B, -closest);
+
+		// nothing is closer than what we already have
+		if (distanceSq - glm::dot(closest, s.P) <= 1e-5f * distanceSq)
+			break;
+
+		bool duplicate = false;
+		for (const SupportPoint& existing : simp)
+			duplicate |= existing.P == s.P;
+
+		if (duplicate)
+			break;
+
+		simp.push_front(s);
+		// the new point has no weight yet, but the old ones need to stay lined up with their points
+		for (int w = 3; w > 0; w--)
+			weights[w] = weights[w - 1];
+		weights[0] = 0.f;
+	}
+
+	DistanceResult result;
+
+	for (size_t i = 0; i < simp.size(); i++)
+	{
+		result.PointA += weights[i] * simp[(int)i].A;
+		result.PointB += weights[i] * simp[(int)i].B;
+	}
+
+	result.Distance = glm::length(closest);
+
+	return result;
+}
@@ -5,6 +5,7 @@
 #include <tracy/Tracy.hpp>
 
 #include "geometry/IntersectionLib.hpp"
+#include "geometry/TriangleBvh.hpp"
 
 static const float EPSILON = 1e-8f;
 
@@ -168,6 +169,132 @@ IntersectionLib::SweptIntersection IntersectionLib::SweptAabbAabb(
 	return sweep;
 }
 
+// `Visit(Triangle)` with the shape of each of `Mesh`'s triangles which might be in the world-space box,
+// return `true` to stop. Returns whether it was stopped
+template <class F>
+static bool forEachTriangleIn(const Gjk::Shape& Mesh, const glm::vec3& Min, const glm::vec3& Max, F&& Visit)
+{
+	assert(Mesh.Triangles);
+
+	glm::mat4 toWorld = Gjk::GetTrianglesToWorld(Mesh);
+	glm::mat4 toLocal = glm::inverse(toWorld);
+
+	// the box's corners in the mesh's space, boxed again
+	glm::vec3 localMin = glm::vec3(FLT_MAX);
+	glm::vec3 localMax = glm::vec3(-FLT_MAX);
+
+	for (int c = 0; c < 8; c++)
+	{
+		glm::vec3 corner = glm::vec3(c & 1 ? Max.x : Min.x, c & 2 ? Max.y : Min.y, c & 4 ? Max.z : Min.z);
+		glm::vec3 local = glm::vec3(toLocal * glm::vec4(corner, 1.f));
+
+		localMin = glm::min(localMin, local);
+		localMax = glm::max(localMax, local);
+	}
+
+	return Mesh.Triangles->QueryAabb(localMin, localMax, [&](uint32_t Triangle) -> bool
+	{
+		const glm::vec3* local = Mesh.Triangles->GetTriangle(Triangle);
+		glm::vec3 corners[3] = {
+			glm::vec3(toWorld * glm::vec4(local[0], 1.f)),
+			glm::vec3(toWorld * glm::vec4(local[1], 1.f)),
+			glm::vec3(toWorld * glm::vec4(local[2], 1.f))
+		};
+
+		Gjk::Shape shape = Gjk::MakeTriangle(corners);
+		shape.Body = Mesh.Body;
+
+		return Visit(shape);
+	});
+}
+
+IntersectionLib::SweptIntersection IntersectionLib::SweptGjk(
+	const Gjk::Shape& A,
+	const Gjk::Shape& B,
+	const glm::vec3& Delta,
+	float Separation
+)
+{
+	ZoneScoped;
+
+	// close enough to call it an impact
+	static const float Tolerance = 0.005f;
+
+	if (A.Triangles)
+	{
+		// the first triangle it would reach, out of the ones anywhere near its path
+		glm::vec3 min;
+		glm::vec3 max;
+		Gjk::FindBounds(B, &min, &max);
+
+		SweptIntersection first = { .Position = glm::vec3(B.Transform[3]) + Delta, .Hit = {}, .Time = 1.f };
+
+		forEachTriangleIn(
+			A,
+			glm::min(min, min + Delta) - glm::vec3(Separation),
+			glm::max(max, max + Delta) + glm::vec3(Separation),
+			[&](const Gjk::Shape& Triangle) -> bool
+			{
+				SweptIntersection sweep = SweptGjk(Triangle, B, Delta, Separation);
+
+				if (sweep.Hit.Occurred && (!first.Hit.Occurred || sweep.Time < first.Time))
+					first = sweep;
+
+				return false;
+			}
+		);
+
+		return first;
+	}
+
+	SweptIntersection sweep = { .Position = glm::vec3(B.Transform[3]) + Delta, .Hit = {}, .Time = 1.f };
+
+	Gjk::Shape moved = B;
+	float t = 0.f;
+
+	// Mirtich's conservative advancement. B can't cover the gap between them in less time than it
+	// takes to close it at its full speed along the separating direction, so it's safe to move it that far
+	for (int i = 0; i < 32; i++)
+	{
+		moved.Transform[3] = B.Transform[3] + glm::vec4(Delta * t, 0.f);
+
+		Gjk::DistanceResult distance = Gjk::FindDistance(A, moved);
+
+		// if they started off overlapping, that's for the narrowphase to deal with
+		if (distance.Overlapping || distance.Distance < 1e-6f)
+		{
+			if (i == 0)
+				return sweep;
+
+			break;
+		}
+
+		glm::vec3 normal = (distance.PointB - distance.PointA) / distance.Distance;
+		sweep.Hit.Position = (distance.PointA + distance.PointB) / 2.f;
+		sweep.Hit.Normal = normal;
+
+		if (distance.Distance <= Separation + Tolerance)
+			break;
+
+		float approach = -glm::dot(Delta, normal);
+
+		if (approach <= 0.f)
+			return sweep;
+
+		t += (distance.Distance - Separation) / approach;
+
+		if (t >= 1.f)
+			return sweep;
+	}
+
+	sweep.Hit.Occurred = true;
+	sweep.Hit.Time = t;
+	sweep.Time = t;
+	sweep.Position = glm::vec3(B.Transform[3]) + Delta * t;
+
+	return sweep;
+}
+
 // https://winter.dev/articles/epa-algorithm
 
 static std::pair<std::vector<glm::vec4>, size_t> getFaceNormals(const std::vector<Gjk::SupportPoint>& polytope, const std::vector<size_t>& faces)
@@ -236,10 +363,9 @@ static void addIfUniqueEdge(
 		edges.emplace_back(faces[a], faces[b]);
 }
 
-static IntersectionLib::CollisionPoints epa(const Gjk::Simplex& Simp, const EcRigidBody* A, const EcRigidBody* B, const glm::vec3& Point = glm::vec3(0.f))
+static IntersectionLib::CollisionPoints epa(const Gjk::Simplex& Simp, const Gjk::Shape& A, const Gjk::Shape* B, const glm::vec3& Point = glm::vec3(0.f))
 {
 	ZoneScoped;
-	assert(A);
 
 	std::vector<Gjk::SupportPoint> polytope = { Simp.begin(), Simp.end() };
 	std::vector<size_t> faces = {
@@ -259,7 +385,7 @@ static IntersectionLib::CollisionPoints epa(const Gjk::Simplex& Simp, const EcRi
 		minNormal = glm::vec3(normals[minFace]);
 		minDistance = normals[minFace].w;
 
-		Gjk::SupportPoint support = B ?  Gjk::Support(A, B, minNormal) : Gjk::Support(A, Point, minNormal);
+		Gjk::SupportPoint support = B ?  Gjk::Support(A, *B, minNormal) : Gjk::Support(A, Point, minNormal);
 		float sDistance = glm::dot(minNormal, support.P);
 
 		if (std::abs(sDistance - minDistance) > 0.001f)
@@ -370,24 +496,83 @@ static IntersectionLib::CollisionPoints epa(const Gjk::Simplex& Simp, const EcRi
 	return points;
 }
 
-IntersectionLib::CollisionPoints IntersectionLib::Gjk(const EcRigidBody* A, const EcRigidBody* B)
+// `Mesh`'s triangles near `Other` one at a time, keeping whichever goes in the deepest.
+// `MeshIsA` keeps the normal pointing from A to B
+static IntersectionLib::CollisionPoints gjkTriangles(const Gjk::Shape& Mesh, const Gjk::Shape& Other, bool MeshIsA)
+{
+	glm::vec3 min;
+	glm::vec3 max;
+	Gjk::FindBounds(Other, &min, &max);
+
+	IntersectionLib::CollisionPoints deepest;
+
+	forEachTriangleIn(Mesh, min, max, [&](const Gjk::Shape& Triangle) -> bool
+	{
+		const Gjk::Shape& a = MeshIsA ? Triangle : Other;
+		const Gjk::Shape& b = MeshIsA ? Other : Triangle;
+
+		Gjk::Result result = Gjk::FindIntersection(a, b);
+
+		if (result.HasIntersection)
+		{
+			IntersectionLib::CollisionPoints points = epa(result.Simp, a, &b);
+
+			if (!deepest.HasCollision || points.PenetrationDepth > deepest.PenetrationDepth)
+				deepest = points;
+		}
+
+		return false;
+	});
+
+	return deepest;
+}
+
+IntersectionLib::CollisionPoints IntersectionLib::Gjk(const Gjk::Shape& A, const Gjk::Shape& B)
 {
 	ZoneScoped;
-	assert(A);
-	assert(B);
+	assert(A.Body);
+	assert(B.Body);
+
+	if (A.Triangles)
+		return gjkTriangles(A, B, true);
+	if (B.Triangles)
+		return gjkTriangles(B, A, false);
 
 	Gjk::Result result = Gjk::FindIntersection(A, B);
 
 	if (!result.HasIntersection)
 		return CollisionPoints{ .HasCollision = false };
 	else
-		return epa(result.Simp, A, B);
+		return epa(result.Simp, A, &B);
+}
+
+bool IntersectionLib::Overlaps(const Gjk::Shape& A, const Gjk::Shape& B)
+{
+	ZoneScoped;
+
+	glm::vec3 min;
+	glm::vec3 max;
+
+	if (A.Triangles)
+	{
+		Gjk::FindBounds(B, &min, &max);
+
+		return forEachTriangleIn(A, min, max, [&B](const Gjk::Shape& Triangle)
+		{
+			return Gjk::FindIntersection(Triangle, B).HasIntersection;
+		});
+	}
+
+	if (B.Triangles)
+		return Overlaps(B, A);
+
+	return Gjk::FindIntersection(A, B).HasIntersection;
 }
 
-IntersectionLib::CollisionPoints IntersectionLib::GjkRay(const EcRigidBody* A, const glm::vec3& Origin, const glm::vec3& Direction, float Distance, Gjk::RaycastResult* RayResult)
+IntersectionLib::CollisionPoints IntersectionLib::GjkRay(const Gjk::Shape& A, const glm::vec3& Origin, const glm::vec3& Direction, float Distance, Gjk::RaycastResult* RayResult)
 {
 	ZoneScoped;
-	assert(A);
+	assert(A.Body);
 	assert(RayResult);
 
 	*RayResult = Gjk::FindRayIntersection(A, Origin, Direction, Distance);
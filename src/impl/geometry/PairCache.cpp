@@ -0,0 +1,77 @@
+// PairCache.cpp, 17/10/2026
+#include <tracy/Tracy.hpp>
+#include <algorithm>
+#include <cassert>
+
+#include "geometry/PairCache.hpp"
+
+// packed so that sorting the keys sorts by `A`, then `B`
+static uint64_t packKey(uint32_t A, uint32_t B)
+{
+    return ((uint64_t)A << 32) | B;
+}
+
+void PairCache::BeginUpdate()
+{
+    m_Candidates.clear();
+}
+
+void PairCache::AddCandidate(uint32_t A, uint32_t B)
+{
+    assert(A != B);
+    m_Candidates.push_back(A < B ? packKey(A, B) : packKey(B, A));
+}
+
+void PairCache::EndUpdate()
+{
+    ZoneScopedC(tracy::Color::AntiqueWhite);
+
+    std::sort(m_Candidates.begin(), m_Candidates.end());
+    m_Candidates.erase(std::unique(m_Candidates.begin(), m_Candidates.end()), m_Candidates.end());
+
+    Added.clear();
+    Removed.clear();
+    m_Next.clear();
+    m_Next.reserve(m_Candidates.size());
+
+    // both are sorted, so a single merge pass tells apart the pairs which
+    // stayed, the ones which are new and the ones which went away
+    size_t prev = 0;
+
+    for (uint64_t key : m_Candidates)
+    {
+        while (prev < Pairs.size() && packKey(Pairs[prev].A, Pairs[prev].B) < key)
+        {
+            Removed.push_back(Pairs[prev]);
+            prev++;
+        }
+
+        if (prev < Pairs.size() && packKey(Pairs[prev].A, Pairs[prev].B) == key)
+        {
+            m_Next.push_back(Pairs[prev]);
+            prev++;
+        }
+        else
+        {
+            uint32_t a = (uint32_t)(key >> 32);
+            uint32_t b = (uint32_t)key;
+
+            m_Next.push_back({ .A = a, .B = b });
+            Added.push_back({ a, b });
+        }
+    }
+
+    for (; prev < Pairs.size(); prev++)
+        Removed.push_back(Pairs[prev]);
+
+    std::swap(Pairs, m_Next);
+}
+
+void PairCache::Clear()
+{
+    Pairs.clear();
+    Added.clear();
+    Removed.clear();
+    m_Candidates.clear();
+    m_Next.clear();
+}
@@ -1,5 +1,11 @@
+#include <unordered_map>
 #include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <glm/gtc/matrix_transform.hpp>
 #include <tracy/Tracy.hpp>
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
 #include <math.h>
 
 #define GLM_ENABLE_EXPERIMENTAL
@@ -7,19 +13,86 @@
 
 #include "geometry/Physics.hpp"
 #include "geometry/IntersectionLib.hpp"
+#include "geometry/DecomposeTRS.hpp"
 #include "component/Transform.hpp"
 #include "component/Workspace.hpp"
 #include "component/RigidBody.hpp"
+#include "ThreadManager.hpp"
 #include "Timing.hpp"
 #include "Stl.hpp"
 
-struct Collision
+// a pair's bodies and shapes, looked up before the narrowphase is dispatched
+struct NarrowphasePair
 {
-	GameObject* A;
-	GameObject* B;
-	IntersectionLib::CollisionPoints Points;
+	EcRigidBody* A = nullptr;
+	EcRigidBody* B = nullptr;
+	Gjk::Shape ShapeA;
+	Gjk::Shape ShapeB;
+	// as of the end of the last step
+	bool WasTouching = false;
+	// neither body is awake, so the pair is left as it was
+	bool Asleep = false;
 };
 
+// Contacts are solved with sequential impulses, after Erin Catto's "Iterative Dynamics with
+// Temporal Coherence". Bodies touching each other are grouped into islands, which are
+// solved independently of each other and fall asleep together
+struct SolverBody
+{
+	EcRigidBody* Body = nullptr;
+	glm::vec3 Position = {};
+	glm::vec3 LinearVelocity = {};
+	glm::vec3 AngularVelocity = {};
+	glm::mat3 InverseInertia = glm::mat3(0.f);
+	float InverseMass = 0.f;
+};
+
+struct SolverContact
+{
+	uint32_t Pair = 0;
+	// into the solver bodies, `NO_SOLVER_BODY` for static ones
+	uint32_t A = 0;
+	uint32_t B = 0;
+	glm::vec3 Normal = {}; // from A to B
+	glm::vec3 Tangents[2] = {};
+	// contact points, relative to each body
+	glm::vec3 RA = {};
+	glm::vec3 RB = {};
+	float NormalMass = 0.f;
+	float TangentMass[2] = {};
+	float Bias = 0.f;
+	float Friction = 0.f;
+	float NormalImpulse = 0.f;
+	float TangentImpulse[2] = {};
+};
+
+static const uint32_t NO_SOLVER_BODY = UINT32_MAX;
+
+// pairs per narrowphase task
+static const size_t NARROWPHASE_GRAIN = 32;
+// islands per solver task
+static const size_t ISLAND_GRAIN = 4;
+static const int SOLVER_ITERATIONS = 8;
+// fraction of the penetration pushed out per step, and how much is left alone so resting contacts don't jitter
+static const float BAUMGARTE = 0.2f;
+static const float PENETRATION_SLOP = 0.01f;
+// contacts approaching slower than this don't bounce, so that things can settle
+static const float RESTITUTION_THRESHOLD = 2.f;
+// `EcRigidBody::Friction` is on the scale of the damping it used to be, 50 is a coefficient of 0.5
+static const float FRICTION_SCALE = 0.01f;
+// how long every body in an island has to stay below its sleep thresholds before the island sleeps
+static const float TIME_TO_SLEEP = 0.5f;
+static const double MAX_STEP_LENGTH = 1.0 / 240.0;
+// fast bodies which need more than this should be `Continuous`
+static const size_t MAX_SUBSTEPS = 8;
+// `Continuous` bodies are only swept when they move further than this fraction of their smallest dimension in a step
+static const float CCD_MOTION_THRESHOLD = 0.25f;
+// how far short of what it would've hit a swept body is stopped
+static const float CCD_SEPARATION = PENETRATION_SLOP;
+// in fixed-tick mode, time beyond this many ticks in one frame is dropped, so that
+// ticks which take longer than they simulate can't snowball
+static const uint32_t MAX_TICKS_PER_FRAME = 8;
+
 static Physics* Instance;
 
 Physics::Physics()
@@ -40,247 +113,716 @@ Physics* Physics::Get()
 	return Instance;
 }
 
-static void applyGlobalForces(Physics::World& World, float, Physics* phys)
+void Physics::GatherBodies(Physics::World& World)
 {
 	ZoneScopedC(tracy::Color::AntiqueWhite);
 
-	for (ObjectHandle& object : World.Dynamics)
-	{
-		EcRigidBody* crb = object->FindComponent<EcRigidBody>();
-		assert(crb->Mass == crb->CollisionAabb.Size.x * crb->CollisionAabb.Size.y * crb->CollisionAabb.Size.z * crb->Density);
+	World.Dynamics.clear();
+	World.Statics.clear();
+
+	GameObjectManager::Get()->Query<EcRigidBody, EcTransform>(
+		{ .Workspace = World.Workspace },
+		[&World](GameObject& Object, EcRigidBody& Body, EcTransform&)
+		{
+			if (Body.PhysicsDynamics)
+				World.Dynamics.emplace_back(&Object);
+			else if (Body.PhysicsCollisions)
+				World.Statics.emplace_back(&Object);
+		}
+	);
+}
 
-		// 19/09/2024 https://www.youtube.com/watch?v=-_IspRG548E
-		glm::vec3 weight = phys->Gravity * crb->Mass;
+static void signalCollision(GameObject* Object, GameObject* Other, bool Began)
+{
+	EcRigidBody* crb = Object ? Object->FindComponent<EcRigidBody>() : nullptr;
 
-		const float AirDensity = 0.15f;
-		const float DragCoefficient = 0.01f;
-		float csarea = crb->CollisionAabb.Size.x * crb->CollisionAabb.Size.z;
+	if (!crb)
+		return;
 
-		glm::vec3 v = crb->LinearVelocity;
-		float speed = glm::length(v);
+	if (Began)
+		Reflection::SignalEvent(crb->OnCollisionBeganCallbacks, { GameObject::s_ToGenericValue(Other) }, "RigidBody.OnCollisionBegan");
+	else
+		Reflection::SignalEvent(crb->OnCollisionEndedCallbacks, { GameObject::s_ToGenericValue(Other) }, "RigidBody.OnCollisionEnded");
+}
 
-		glm::vec3 drag = speed > 0.f
-		    ? -glm::normalize(v) * 0.5f * AirDensity * speed * speed * DragCoefficient * csarea
-		    : glm::vec3(0.f);
+void Physics::FireCollisionEvents(Physics::World& World)
+{
+	ZoneScopedC(tracy::Color::AntiqueWhite);
 
-		crb->NetForce = weight + drag;
+	GameObjectManager* objectManager = GameObjectManager::Get();
+
+	// looked up again for each, as an earlier callback may have destroyed either of them
+	for (const World::CollisionEvent& event : World.CollisionEvents)
+	{
+		signalCollision(objectManager->FindById(event.A), objectManager->FindById(event.B), event.Began);
+		signalCollision(objectManager->FindById(event.B), objectManager->FindById(event.A), event.Began);
 	}
+
+	World.CollisionEvents.clear();
+}
+
+static void applyGlobalForces(Physics::World& World, float DeltaTime, Physics* phys)
+{
+	ZoneScopedC(tracy::Color::AntiqueWhite);
+
+	// only touches each body's own `NetForce` and velocity, so it's fine to split up
+	GameObjectManager::Get()->QueryParallel<EcRigidBody, EcTransform>(
+		"PhysicsGlobalForces",
+		{ .Workspace = World.Workspace },
+		256,
+		[phys, DeltaTime](GameObject&, EcRigidBody& Body, EcTransform&)
+		{
+			EcRigidBody* crb = &Body;
+			if (!crb->PhysicsDynamics || crb->Sleeping)
+				return;
+
+			assert(crb->Mass == crb->CollisionAabb.Size.x * crb->CollisionAabb.Size.y * crb->CollisionAabb.Size.z * crb->Density);
+
+			// 19/09/2024 https://www.youtube.com/watch?v=-_IspRG548E
+			glm::vec3 weight = phys->Gravity * crb->Mass;
+
+			const float AirDensity = 0.15f;
+			const float DragCoefficient = 0.01f;
+			float csarea = crb->CollisionAabb.Size.x * crb->CollisionAabb.Size.z;
+
+			glm::vec3 v = crb->LinearVelocity;
+			float speed = glm::length(v);
+
+			glm::vec3 drag = speed > 0.f
+			    ? -glm::normalize(v) * 0.5f * AirDensity * speed * speed * DragCoefficient * csarea
+			    : glm::vec3(0.f);
+
+			crb->NetForce = weight + drag;
+
+			// before the contacts are solved, so that they can cancel it out
+			glm::vec3 acceleration = crb->NetForce / crb->Mass;
+			crb->LinearVelocity += acceleration * DeltaTime;
+			if (!isfinite(crb->LinearVelocity.x) || !isfinite(crb->LinearVelocity.y) || !isfinite(crb->LinearVelocity.z) || glm::length(crb->LinearVelocity) > 10000.f)
+				crb->LinearVelocity = glm::vec3(0.f);
+		}
+	);
 }
 
 static void moveDynamics(Physics::World& World, float DeltaTime)
 {
 	ZoneScopedC(tracy::Color::AntiqueWhite);
 
-	for (ObjectHandle& object : World.Dynamics)
-	{
-		EcRigidBody* crb = object->FindComponent<EcRigidBody>();
-		EcTransform* ct = object->FindComponent<EcTransform>();
+	// serial, `::RecomputeAabb` updates the Workspace's spatial hash
+	GameObjectManager::Get()->Query<EcRigidBody, EcTransform>(
+		{ .Workspace = World.Workspace },
+		[DeltaTime](GameObject&, EcRigidBody& Body, EcTransform& Transform)
+		{
+			EcRigidBody* crb = &Body;
+			EcTransform* ct = &Transform;
 
-		glm::vec3 acceleration = crb->NetForce / crb->Mass;
-		crb->LinearVelocity += acceleration * DeltaTime;
-		if (!isfinite(crb->LinearVelocity.x) || !isfinite(crb->LinearVelocity.y) || !isfinite(crb->LinearVelocity.z) || glm::length(crb->LinearVelocity) > 10000.f)
-			crb->LinearVelocity = glm::vec3(0.f);
+			if (!crb->PhysicsDynamics || crb->Sleeping)
+				return;
 
-		glm::mat4 curTrans = ct->Transform;
-		curTrans[3] += glm::vec4(crb->LinearVelocity * DeltaTime, 0.f);
+			glm::mat4 curTrans = ct->Transform;
+			// less than all of it if `sweepContinuous` already moved it part of the way
+			curTrans[3] += glm::vec4(crb->LinearVelocity * DeltaTime * crb->RemainingStep, 0.f);
+			crb->RemainingStep = 1.f;
 
-		if (!isfinite(curTrans[3].x) || !isfinite(curTrans[3].y) || !isfinite(curTrans[3].z))
-			curTrans[3] = glm::vec4(0.f, 0.f, 0.f, 1.f);
+			if (!isfinite(curTrans[3].x) || !isfinite(curTrans[3].y) || !isfinite(curTrans[3].z))
+				curTrans[3] = glm::vec4(0.f, 0.f, 0.f, 1.f);
 
-		const glm::vec3& w = crb->AngularVelocity;
+			const glm::vec3& w = crb->AngularVelocity;
 
-		glm::mat3 skew = glm::mat3(
-			0,   -w.z, w.y,
-			w.z,  0,  -w.x,
-			-w.y, w.x, 0
-		);
+			glm::mat3 skew = glm::mat3(
+				0,   -w.z, w.y,
+				w.z,  0,  -w.x,
+				-w.y, w.x, 0
+			);
 
-		glm::mat3 rot = glm::mat3(curTrans);
-		rot += skew * rot * DeltaTime;
-		rot = glm::orthonormalize(rot);
+			glm::mat3 rot = glm::mat3(curTrans);
+			// `orthonormalize` would otherwise shrink it down to a unit size
+			glm::vec3 scale = glm::vec3(glm::length(rot[0]), glm::length(rot[1]), glm::length(rot[2]));
 
-		glm::vec3 pos = glm::vec3(curTrans[3]);
+			rot += skew * rot * DeltaTime;
+			rot = glm::orthonormalize(rot);
+			rot[0] *= scale.x;
+			rot[1] *= scale.y;
+			rot[2] *= scale.z;
 
-		curTrans = glm::mat4(rot);
-		curTrans[3] = glm::vec4(pos, 1.f);
+			glm::vec3 pos = glm::vec3(curTrans[3]);
 
-		ct->SetWorldTransform(curTrans);
-		crb->RecomputeAabb();
-	}
+			curTrans = glm::mat4(rot);
+			curTrans[3] = glm::vec4(pos, 1.f);
+
+			ct->SetWorldTransform(curTrans);
+			crb->RecomputeAabb();
+		}
+	);
 }
 
-static int roundNToGrid(float x)
+static SolverBody makeSolverBody(EcRigidBody* Body, const glm::mat4& Transform)
 {
-	return int(glm::round(x / SPATIAL_HASH_GRID_SIZE) * SPATIAL_HASH_GRID_SIZE);
+	SolverBody sb = {
+		.Body = Body,
+		.Position = glm::vec3(Transform[3]),
+		.LinearVelocity = Body->LinearVelocity,
+		.AngularVelocity = Body->AngularVelocity,
+		.InverseMass = Body->Mass > 0.f ? 1.f / Body->Mass : 0.f
+	};
+
+	glm::vec3 size = {};
+	DecomposeTRS(Transform, nullptr, nullptr, &size);
+
+	if (!Body->PhysicsRotations || sb.InverseMass == 0.f || size.x <= 0.f || size.y <= 0.f || size.z <= 0.f)
+		return sb;
+
+	// a solid box, rotated into world space
+	glm::vec3 sq = size * size;
+	glm::vec3 inertia = Body->Mass / 12.f * glm::vec3(sq.y + sq.z, sq.x + sq.z, sq.x + sq.y);
+
+	glm::mat3 rotation = glm::mat3(glm::vec3(Transform[0]) / size.x, glm::vec3(Transform[1]) / size.y, glm::vec3(Transform[2]) / size.z);
+	glm::mat3 inverseLocal = glm::mat3(0.f);
+	inverseLocal[0][0] = 1.f / inertia.x;
+	inverseLocal[1][1] = 1.f / inertia.y;
+	inverseLocal[2][2] = 1.f / inertia.z;
+
+	sb.InverseInertia = rotation * inverseLocal * glm::transpose(rotation);
+
+	return sb;
 }
 
-static glm::ivec3 roundToGrid(const glm::vec3& v)
+// `nullptr` for a static body
+static glm::vec3 velocityAt(const SolverBody* Body, const glm::vec3& R)
 {
-	return glm::ivec3(roundNToGrid(v.x), roundNToGrid(v.y), roundNToGrid(v.z));
+	return Body ? Body->LinearVelocity + glm::cross(Body->AngularVelocity, R) : glm::vec3(0.f);
 }
 
-typedef std::unordered_map<glm::ivec3, std::vector<uint32_t>>::iterator VisitIterator;
-
-static void visitHashAabb(EcWorkspace* cw, const glm::vec3& min, const glm::vec3& max, const std::function<bool(VisitIterator)> Visit)
+static void applyImpulse(SolverBody* Body, const glm::vec3& R, const glm::vec3& Impulse)
 {
-	if (abs(min.x) + abs(min.y) + abs(min.z) > 1e6)
+	if (!Body)
 		return;
 
-	for (float x = min.x; x <= max.x; x += SPATIAL_HASH_GRID_SIZE)
-		for (float y = min.y; y <= max.y; y += SPATIAL_HASH_GRID_SIZE)
-			for (float z = min.z; z <= max.z; z += SPATIAL_HASH_GRID_SIZE)
+	Body->LinearVelocity += Impulse * Body->InverseMass;
+	Body->AngularVelocity += Body->InverseInertia * glm::cross(R, Impulse);
+}
+
+// inverse of the mass an impulse along `Direction` at the contact point pushes against
+static float effectiveMass(const SolverBody* A, const SolverBody* B, const glm::vec3& RA, const glm::vec3& RB, const glm::vec3& Direction)
+{
+	float k = 0.f;
+
+	if (A)
+	{
+		glm::vec3 rn = glm::cross(RA, Direction);
+		k += A->InverseMass + glm::dot(rn, A->InverseInertia * rn);
+	}
+
+	if (B)
+	{
+		glm::vec3 rn = glm::cross(RB, Direction);
+		k += B->InverseMass + glm::dot(rn, B->InverseInertia * rn);
+	}
+
+	return k > 0.f ? 1.f / k : 0.f;
+}
+
+static void solveIsland(
+	hx::frame_vector<SolverBody, MEMCAT(Physics)>& Bodies,
+	hx::frame_vector<SolverContact, MEMCAT(Physics)>& Contacts,
+	const uint32_t* IslandBodies,
+	size_t NumBodies,
+	const uint32_t* IslandContacts,
+	size_t NumContacts,
+	PairCache& Pairs,
+	float DeltaTime
+)
+{
+	auto bodyOf = [&Bodies](uint32_t Index) -> SolverBody*
+	{
+		return Index != NO_SOLVER_BODY ? &Bodies[Index] : nullptr;
+	};
+
+	// warm start, with what the contacts needed last step
+	for (size_t i = 0; i < NumContacts; i++)
+	{
+		const SolverContact& c = Contacts[IslandContacts[i]];
+		glm::vec3 impulse = c.Normal * c.NormalImpulse + c.Tangents[0] * c.TangentImpulse[0] + c.Tangents[1] * c.TangentImpulse[1];
+
+		applyImpulse(bodyOf(c.A), c.RA, -impulse);
+		applyImpulse(bodyOf(c.B), c.RB, impulse);
+	}
+
+	for (int iteration = 0; iteration < SOLVER_ITERATIONS; iteration++)
+		for (size_t i = 0; i < NumContacts; i++)
+		{
+			SolverContact& c = Contacts[IslandContacts[i]];
+			SolverBody* a = bodyOf(c.A);
+			SolverBody* b = bodyOf(c.B);
+
+			// friction first, it's limited by the normal impulse, which then gets the final say
+			for (int t = 0; t < 2; t++)
 			{
-				glm::ivec3 point = { x, y, z };
-				assert(roundToGrid(point) == point);
+				glm::vec3 dv = velocityAt(b, c.RB) - velocityAt(a, c.RA);
+				float lambda = -glm::dot(dv, c.Tangents[t]) * c.TangentMass[t];
+				float maxFriction = c.Friction * c.NormalImpulse;
 
-				const auto& it = cw->SpatialHash.find(point);
-				if (it == cw->SpatialHash.end())
-					continue;
+				float previous = c.TangentImpulse[t];
+				c.TangentImpulse[t] = std::clamp(previous + lambda, -maxFriction, maxFriction);
 
-				if (Visit(it)) // stop condition
-					return;
+				glm::vec3 impulse = c.Tangents[t] * (c.TangentImpulse[t] - previous);
+				applyImpulse(a, c.RA, -impulse);
+				applyImpulse(b, c.RB, impulse);
 			}
-}
 
-#include "Engine.hpp"
+			glm::vec3 dv = velocityAt(b, c.RB) - velocityAt(a, c.RA);
+			float lambda = c.NormalMass * (-glm::dot(dv, c.Normal) + c.Bias);
+
+			// the total can only ever push the bodies apart
+			float previous = c.NormalImpulse;
+			c.NormalImpulse = std::max(previous + lambda, 0.f);
+
+			glm::vec3 impulse = c.Normal * (c.NormalImpulse - previous);
+			applyImpulse(a, c.RA, -impulse);
+			applyImpulse(b, c.RB, impulse);
+		}
+
+	for (size_t i = 0; i < NumContacts; i++)
+	{
+		const SolverContact& c = Contacts[IslandContacts[i]];
+		PairCache::Pair& pair = Pairs.Pairs[c.Pair];
+
+		pair.NormalImpulse = c.NormalImpulse;
+		pair.TangentImpulse = c.Tangents[0] * c.TangentImpulse[0] + c.Tangents[1] * c.TangentImpulse[1];
+	}
+
+	float minSleepTimer = FLT_MAX;
+
+	for (size_t i = 0; i < NumBodies; i++)
+	{
+		const SolverBody& sb = Bodies[IslandBodies[i]];
+		EcRigidBody* crb = sb.Body;
+
+		crb->LinearVelocity = sb.LinearVelocity;
+		crb->AngularVelocity = sb.AngularVelocity;
+
+		bool slow = glm::length(crb->LinearVelocity) < crb->LinearSleepThreshold
+			&& glm::length(crb->AngularVelocity) < crb->AngularSleepThreshold;
+
+		crb->SleepTimer = slow ? crb->SleepTimer + DeltaTime : 0.f;
+		minSleepTimer = std::min(minSleepTimer, crb->SleepTimer);
+	}
+
+	if (minSleepTimer < TIME_TO_SLEEP)
+		return;
+
+	for (size_t i = 0; i < NumBodies; i++)
+	{
+		EcRigidBody* crb = Bodies[IslandBodies[i]].Body;
+
+		crb->Sleeping = true;
+		crb->LinearVelocity = glm::vec3(0.f);
+		crb->AngularVelocity = glm::vec3(0.f);
+	}
+}
 
 static void resolveCollisions(Physics::World& World, float DeltaTime, Physics* phys)
 {
 	ZoneScopedC(tracy::Color::AntiqueWhite);
 
-	hx::vector<Collision, MEMCAT(Physics)> collisions;
+	EcWorkspace* workspace = GameObjectManager::Get()->FindById(World.Workspace)->FindComponent<EcWorkspace>();
 
-	EcWorkspace* workspace = GameObjectManager::Get()->FindById(World.Dynamics[0]->OwningWorkspace)->FindComponent<EcWorkspace>();
+	PairCache& pairs = World.Pairs;
+	pairs.BeginUpdate();
 
-	for (size_t aid = 0; aid < World.Dynamics.size(); aid++)
+	// a pair is found once for every cell it shares, and from both sides if both are dynamic,
+	// the cache boils that down to one entry. Sleeping bodies don't look for pairs, any with
+	// an awake body are found from its side
+	for (const ObjectHandle& a : World.Dynamics)
 	{
-		ObjectHandle& a = World.Dynamics[aid];;
 		EcRigidBody* arb = a->FindComponent<EcRigidBody>();
 
-		if (!arb->PhysicsCollisions)
+		if (!arb->PhysicsCollisions || arb->Sleeping)
 			continue;
 
-		arb->CurTransform = a->FindComponent<EcTransform>();
 		const glm::vec3& aPos = arb->CollisionAabb.Position;
 		const glm::vec3& aSize = arb->CollisionAabb.Size;
 
 		glm::vec3 min = aPos - aSize / 2.f;
 		glm::vec3 max = aPos + aSize / 2.f;
-		min = roundToGrid(min);
-		max = roundToGrid(max);
+		uint32_t aid = a->ObjectId;
 
-		visitHashAabb(workspace, min, max, [&](VisitIterator it) -> bool
+		workspace->VisitBroadphase(min, max, [&pairs, aid](uint32_t oid) -> bool
 		{
-			for (uint32_t oid : it->second)
-			{
-				if (oid == a->ObjectId)
-					continue;
+			if (oid != aid)
+				pairs.AddCandidate(aid, oid);
 
-				GameObject* b = GameObjectManager::Get()->FindById(oid);
-				EcRigidBody* brb = b ? b->FindComponent<EcRigidBody>() : nullptr;
+			return false; // process all collisions
+		});
+	}
 
-				if (!brb || !brb->PhysicsCollisions)
-					continue;
+	// pairs with a sleeping body which no awake one found are kept as they are, so that falling
+	// asleep on something doesn't look like coming apart from it
+	for (const PairCache::Pair& pair : pairs.Pairs)
+	{
+		if (pair.TouchingSteps == 0)
+			continue;
 
-				brb->CurTransform = b->FindComponent<EcTransform>();
+		GameObject* a = GameObjectManager::Get()->FindById(pair.A);
+		GameObject* b = GameObjectManager::Get()->FindById(pair.B);
+		EcRigidBody* arb = a ? a->FindComponent<EcRigidBody>() : nullptr;
+		EcRigidBody* brb = b ? b->FindComponent<EcRigidBody>() : nullptr;
 
-				IntersectionLib::CollisionPoints collisionPoints = IntersectionLib::Gjk(arb, brb);
+		if (arb && brb && arb->PhysicsCollisions && brb->PhysicsCollisions && (arb->Sleeping || brb->Sleeping))
+			pairs.AddCandidate(pair.A, pair.B);
+	}
 
-				if (collisionPoints.HasCollision)
-				{
-					collisions.emplace_back(a.Dereference(), b, collisionPoints);
+	pairs.EndUpdate();
 
-					if (brb->PhysicsDynamics)
-					{
-						IntersectionLib::CollisionPoints points2 = {
-							.A = collisionPoints.B,
-							.B = collisionPoints.A,
-							.Normal = -collisionPoints.Normal,
-							.PenetrationDepth = collisionPoints.PenetrationDepth,
-							.HasCollision = collisionPoints.HasCollision,
-						};
-						collisions.emplace_back(b, a.Dereference(), points2);
-					}
-				}
+	const size_t numPairs = pairs.Pairs.size();
+	hx::frame_vector<NarrowphasePair, MEMCAT(Physics)> narrowphase(numPairs);
 
-				brb->CurTransform = nullptr;
-			}
+	// everything the narrowphase needs is looked up here, on the main thread. The workers then
+	// only read their own pairs' shapes and write their own pairs' contacts
+	for (size_t i = 0; i < numPairs; i++)
+	{
+		const PairCache::Pair& pair = pairs.Pairs[i];
+		NarrowphasePair& np = narrowphase[i];
+		np.WasTouching = pair.TouchingSteps > 0;
 
-			return false; // process all collisions
-		});
+		GameObject* a = GameObjectManager::Get()->FindById(pair.A);
+		GameObject* b = GameObjectManager::Get()->FindById(pair.B);
+		EcRigidBody* arb = a ? a->FindComponent<EcRigidBody>() : nullptr;
+		EcRigidBody* brb = b ? b->FindComponent<EcRigidBody>() : nullptr;
 
-		arb->CurTransform = nullptr;
+		if (!arb || !brb || !arb->PhysicsCollisions || !brb->PhysicsCollisions)
+			continue;
+
+		np.A = arb;
+		np.B = brb;
+		np.ShapeA = Gjk::MakeShape(arb);
+		np.ShapeB = Gjk::MakeShape(brb);
+		np.Asleep = (arb->Sleeping || !arb->PhysicsDynamics) && (brb->Sleeping || !brb->PhysicsDynamics);
 	}
 
-	for (const Collision& collision : collisions)
+	// one narrowphase test per pair
+	ThreadManager::Get()->ParallelFor("PhysicsNarrowphase", 0, numPairs, NARROWPHASE_GRAIN, [&pairs, &narrowphase](size_t Begin, size_t End)
 	{
-		const IntersectionLib::CollisionPoints& points = collision.Points;
+		for (size_t i = Begin; i < End; i++)
+		{
+			PairCache::Pair& pair = pairs.Pairs[i];
+			const NarrowphasePair& np = narrowphase[i];
 
-		EcRigidBody* arb = collision.A->FindComponent<EcRigidBody>();
-		EcRigidBody* brb = collision.B->FindComponent<EcRigidBody>();
-		EcTransform* at = collision.A->FindComponent<EcTransform>();
+			if (np.Asleep)
+				continue;
+
+			pair.Contact = np.A ? IntersectionLib::Gjk(np.ShapeA, np.ShapeB) : IntersectionLib::CollisionPoints{};
+			pair.TouchingSteps = pair.Contact.HasCollision ? pair.TouchingSteps + 1 : 0;
+		}
+	});
+
+	// a sleeping body touched by an awake one wakes up, and joins its island below
+	for (size_t i = 0; i < numPairs; i++)
+	{
+		const PairCache::Pair& pair = pairs.Pairs[i];
+		const NarrowphasePair& np = narrowphase[i];
+
+		if (np.Asleep)
+			continue;
 
-		glm::vec3 vRel = arb->LinearVelocity - (brb->PhysicsDynamics ? brb->LinearVelocity : glm::vec3(0.f));
-		float vn = glm::dot(vRel, points.Normal);
+		if (pair.Contact.HasCollision != np.WasTouching)
+			World.CollisionEvents.push_back({ .A = pair.A, .B = pair.B, .Began = pair.Contact.HasCollision });
 
-		//if (arb->PhysicsDynamics && !brb->PhysicsDynamics)
+		if (pair.Contact.HasCollision)
 		{
-			glm::mat4 trans = at->Transform;
+			if (np.A->Sleeping)
+				np.A->Wake();
+			if (np.B->Sleeping)
+				np.B->Wake();
+		}
+	}
 
-			if (vn > 0.f)
-			{
-			    float j = -(1.f + arb->Restitution) * vn;
-			    j /= (1.f / arb->Mass);
+	// and ones which went away while they were still touching, e.g. because one was moved off or destroyed
+	for (const PairCache::Pair& pair : pairs.Removed)
+		if (pair.TouchingSteps > 0)
+			World.CollisionEvents.push_back({ .A = pair.A, .B = pair.B, .Began = false });
 
-			    arb->LinearVelocity += (j / arb->Mass) * points.Normal;
+	hx::frame_vector<SolverBody, MEMCAT(Physics)> bodies;
+	bodies.reserve(World.Dynamics.size());
+	std::unordered_map<const EcRigidBody*, uint32_t> bodyIndices;
 
-				if (arb->PhysicsRotations)
-				{
-					glm::vec3 r = points.A - arb->CollisionAabb.Position; // lever arm
-					arb->AngularVelocity += glm::cross(r, points.Normal) * points.PenetrationDepth * 100.f;
-				}
-			}
+	for (const ObjectHandle& d : World.Dynamics)
+	{
+		EcRigidBody* crb = d->FindComponent<EcRigidBody>();
 
-			// position correction to prevent sinking
-			if (points.PenetrationDepth < 0.1f)
-			{
-				trans[3] += glm::vec4(points.Normal * -points.PenetrationDepth * 2.f, 0.f);
-				arb->LinearVelocity += points.Normal * -points.PenetrationDepth * 64.f;
-			}
+		if (crb->Sleeping)
+			continue;
 
-			arb->NetForce *= glm::vec3(1.f) - points.Normal;
-			arb->NetForce -= arb->LinearVelocity * (glm::vec3(1.f) - points.Normal) * arb->Friction;
+		bodyIndices[crb] = (uint32_t)bodies.size();
+		bodies.push_back(makeSolverBody(crb, d->FindComponent<EcTransform>()->Transform));
+	}
+
+	auto solverBodyOf = [&bodyIndices](const EcRigidBody* Body) -> uint32_t
+	{
+		auto it = bodyIndices.find(Body);
+		return it != bodyIndices.end() ? it->second : NO_SOLVER_BODY;
+	};
 
-			arb->AngularVelocity -= arb->AngularVelocity * arb->Friction * 0.1f * DeltaTime;
+	// gathered in pair order, so that the result doesn't depend on how the narrowphase was split up
+	hx::frame_vector<SolverContact, MEMCAT(Physics)> contacts;
+
+	for (size_t i = 0; i < numPairs; i++)
+	{
+		const PairCache::Pair& pair = pairs.Pairs[i];
+		const NarrowphasePair& np = narrowphase[i];
+		const IntersectionLib::CollisionPoints& points = pair.Contact;
 
-			at->SetWorldTransform(trans);
+		if (!points.HasCollision || glm::length(points.Normal) < 1e-6f)
+			continue;
+
+		SolverContact c = { .Pair = (uint32_t)i, .A = solverBodyOf(np.A), .B = solverBodyOf(np.B) };
+
+		if (c.A == NO_SOLVER_BODY && c.B == NO_SOLVER_BODY)
+			continue;
 
-			if (phys->DebugContactPoints)
+		const SolverBody* a = c.A != NO_SOLVER_BODY ? &bodies[c.A] : nullptr;
+		const SolverBody* b = c.B != NO_SOLVER_BODY ? &bodies[c.B] : nullptr;
+
+		c.Normal = glm::normalize(points.Normal);
+		c.RA = a ? points.A - a->Position : glm::vec3(0.f);
+		c.RB = b ? points.B - b->Position : glm::vec3(0.f);
+
+		glm::vec3 axis = std::abs(c.Normal.x) < 0.57f ? glm::vec3(1.f, 0.f, 0.f) : glm::vec3(0.f, 1.f, 0.f);
+		c.Tangents[0] = glm::normalize(glm::cross(c.Normal, axis));
+		c.Tangents[1] = glm::cross(c.Normal, c.Tangents[0]);
+
+		c.NormalMass = effectiveMass(a, b, c.RA, c.RB, c.Normal);
+		c.TangentMass[0] = effectiveMass(a, b, c.RA, c.RB, c.Tangents[0]);
+		c.TangentMass[1] = effectiveMass(a, b, c.RA, c.RB, c.Tangents[1]);
+
+		c.Friction = std::sqrt(std::max(np.A->Friction, 0.f) * std::max(np.B->Friction, 0.f)) * FRICTION_SCALE;
+
+		float approach = glm::dot(velocityAt(b, c.RB) - velocityAt(a, c.RA), c.Normal);
+		float restitution = std::max(np.A->Restitution, np.B->Restitution);
+
+		c.Bias = BAUMGARTE / DeltaTime * std::max(points.PenetrationDepth - PENETRATION_SLOP, 0.f);
+		if (approach < -RESTITUTION_THRESHOLD)
+			c.Bias = std::max(c.Bias, -restitution * approach);
+
+		// the impulses from the last step are a good guess at what's needed in this one
+		if (pair.TouchingSteps > 1)
+		{
+			c.NormalImpulse = pair.NormalImpulse;
+			c.TangentImpulse[0] = glm::dot(pair.TangentImpulse, c.Tangents[0]);
+			c.TangentImpulse[1] = glm::dot(pair.TangentImpulse, c.Tangents[1]);
+		}
+
+		contacts.push_back(c);
+
+		// may be on the tick worker, so the Engine draws these later
+		if (phys->DebugContactPoints)
+			World.DebugContacts.push_back(points.B);
+	}
+
+	// union-find over the bodies. Static bodies don't join islands together, they're never moved
+	// by the solver, so islands on either side of one can still be solved independently
+	hx::frame_vector<uint32_t, MEMCAT(Physics)> parents(bodies.size());
+	for (uint32_t i = 0; i < parents.size(); i++)
+		parents[i] = i;
+
+	auto findRoot = [&parents](uint32_t Index) -> uint32_t
+	{
+		while (parents[Index] != Index)
+		{
+			parents[Index] = parents[parents[Index]];
+			Index = parents[Index];
+		}
+
+		return Index;
+	};
+
+	for (const SolverContact& c : contacts)
+		if (c.A != NO_SOLVER_BODY && c.B != NO_SOLVER_BODY)
+		{
+			uint32_t ra = findRoot(c.A);
+			uint32_t rb = findRoot(c.B);
+
+			// lowest index as the root, so that the islands come out in the same order every time
+			if (ra != rb)
+				parents[std::max(ra, rb)] = std::min(ra, rb);
+		}
+
+	hx::frame_vector<uint32_t, MEMCAT(Physics)> islandOf(bodies.size());
+	hx::frame_vector<uint32_t, MEMCAT(Physics)> rootIsland(bodies.size(), NO_SOLVER_BODY);
+	uint32_t numIslands = 0;
+
+	for (uint32_t i = 0; i < bodies.size(); i++)
+	{
+		uint32_t root = findRoot(i);
+
+		if (rootIsland[root] == NO_SOLVER_BODY)
+			rootIsland[root] = numIslands++;
+
+		islandOf[i] = rootIsland[root];
+	}
+
+	// bodies and contacts bucketed by island, keeping their order within each
+	hx::frame_vector<uint32_t, MEMCAT(Physics)> bodyStart(numIslands + 1, 0);
+	hx::frame_vector<uint32_t, MEMCAT(Physics)> contactStart(numIslands + 1, 0);
+	hx::frame_vector<uint32_t, MEMCAT(Physics)> islandBodies(bodies.size());
+	hx::frame_vector<uint32_t, MEMCAT(Physics)> islandContacts(contacts.size());
+
+	auto contactIsland = [&islandOf](const SolverContact& c) -> uint32_t
+	{
+		return islandOf[c.A != NO_SOLVER_BODY ? c.A : c.B];
+	};
+
+	for (uint32_t i = 0; i < bodies.size(); i++)
+		bodyStart[islandOf[i] + 1]++;
+	for (const SolverContact& c : contacts)
+		contactStart[contactIsland(c) + 1]++;
+
+	for (uint32_t i = 0; i < numIslands; i++)
+	{
+		bodyStart[i + 1] += bodyStart[i];
+		contactStart[i + 1] += contactStart[i];
+	}
+
+	{
+		hx::frame_vector<uint32_t, MEMCAT(Physics)> bodyCursor(bodyStart.begin(), bodyStart.end() - 1);
+		hx::frame_vector<uint32_t, MEMCAT(Physics)> contactCursor(contactStart.begin(), contactStart.end() - 1);
+
+		for (uint32_t i = 0; i < bodies.size(); i++)
+			islandBodies[bodyCursor[islandOf[i]]++] = i;
+		for (uint32_t i = 0; i < contacts.size(); i++)
+			islandContacts[contactCursor[contactIsland(contacts[i])]++] = i;
+	}
+
+	// islands don't share any bodies which the solver writes to, so they can go in parallel
+	ThreadManager::Get()->ParallelFor("PhysicsSolveIslands", 0, numIslands, ISLAND_GRAIN, [&](size_t Begin, size_t End)
+	{
+		for (size_t island = Begin; island < End; island++)
+			solveIsland(
+				bodies,
+				contacts,
+				islandBodies.data() + bodyStart[island],
+				bodyStart[island + 1] - bodyStart[island],
+				islandContacts.data() + contactStart[island],
+				contactStart[island + 1] - contactStart[island],
+				pairs,
+				DeltaTime
+			);
+	});
+}
+
+// Fast `Continuous` bodies are swept from where they are to where `moveDynamics` is about to put them. If
+// they'd hit something along the way, they're moved up to it and bounced off it here instead. Only the
+// translation is swept
+static void sweepContinuous(Physics::World& World, float DeltaTime)
+{
+	ZoneScopedC(tracy::Color::AntiqueWhite);
+
+	EcWorkspace* workspace = nullptr;
+	hx::frame_vector<uint32_t, MEMCAT(Physics)> candidates;
+
+	// serial, a hit changes the velocities of both bodies
+	for (const ObjectHandle& d : World.Dynamics)
+	{
+		EcRigidBody* crb = d->FindComponent<EcRigidBody>();
+
+		if (!crb->Continuous || crb->Sleeping || !crb->PhysicsCollisions)
+			continue;
+
+		const glm::vec3& position = crb->CollisionAabb.Position;
+		const glm::vec3& size = crb->CollisionAabb.Size;
+		glm::vec3 motion = crb->LinearVelocity * DeltaTime;
+
+		if (glm::length(motion) <= CCD_MOTION_THRESHOLD * std::min({ size.x, size.y, size.z }))
+			continue;
+
+		if (!workspace)
+			workspace = GameObjectManager::Get()->FindById(World.Workspace)->FindComponent<EcWorkspace>();
+
+		glm::vec3 min = position - size / 2.f;
+		glm::vec3 max = position + size / 2.f;
+		uint32_t id = d->ObjectId;
+
+		Gjk::Shape shape = Gjk::MakeShape(crb);
+		float timeOfImpact = 1.f;
+		EcRigidBody* hitBody = nullptr;
+		glm::vec3 hitNormal = {};
+
+		// the grid can give the same body once for every cell it shares with the sweep
+		candidates.clear();
+
+		workspace->VisitBroadphase(glm::min(min, min + motion), glm::max(max, max + motion), [&candidates, id](uint32_t oid) -> bool
+		{
+			if (oid != id)
+				candidates.push_back(oid);
+
+			return false;
+		});
+
+		std::sort(candidates.begin(), candidates.end());
+		candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+
+		for (uint32_t oid : candidates)
+		{
+			GameObject* other = GameObjectManager::Get()->FindById(oid);
+			EcRigidBody* orb = other ? other->FindComponent<EcRigidBody>() : nullptr;
+
+			if (!orb || !orb->PhysicsCollisions)
+				continue;
+
+			glm::vec3 otherMotion = (orb->PhysicsDynamics && !orb->Sleeping) ? orb->LinearVelocity * DeltaTime : glm::vec3(0.f);
+			glm::vec3 delta = motion - otherMotion;
+
+			// the boxes are much cheaper to sweep, and the shapes can't touch before they do
+			if (!IntersectionLib::AabbAabb(orb->CollisionAabb.Position, orb->CollisionAabb.Size, position, size).Occurred)
 			{
-				Engine::Get()->CurrentScene.RenderList.push_back(RenderItem{
-					.RenderMeshId = 0,
-					.Transform = glm::translate(glm::scale(glm::mat4(1.f), glm::vec3(0.2f)), points.B),
-					.MaterialId = MaterialManager::Get()->LoadFromPath("unlit"),
-					.TintColor = glm::vec3(1.f, 0.f, 0.f),
-					.Transparency = 0.1f,
-					.FaceCulling = FaceCullingMode::None
-				});
+				IntersectionLib::SweptIntersection boxSweep = IntersectionLib::SweptAabbAabb(
+					orb->CollisionAabb.Position, orb->CollisionAabb.Size,
+					position, size,
+					delta
+				);
+
+				if (!boxSweep.Hit.Occurred || boxSweep.Time >= timeOfImpact)
+					continue;
+			}
+
+			IntersectionLib::SweptIntersection sweep = IntersectionLib::SweptGjk(Gjk::MakeShape(orb), shape, delta, CCD_SEPARATION);
+
+			if (sweep.Hit.Occurred && sweep.Time < timeOfImpact)
+			{
+				timeOfImpact = sweep.Time;
+				hitBody = orb;
+				hitNormal = sweep.Hit.Normal;
 			}
 		}
-		/*
-		else // Not finished yet
-		{
-			// Transfer of velocity
-			//collision.A->LinearVelocity += collision.B->LinearVelocity / 2.f;
-			//collision.B->LinearVelocity += collision.A->LinearVelocity / 2.f;
-			//collision.A->LinearVelocity = collision.A->LinearVelocity / 2.f;
-			//collision.B->LinearVelocity = collision.B->LinearVelocity / 2.f;
 
-			//arb->LinearVelocity += reactionForce;
+		if (!hitBody)
+			continue;
+
+		EcTransform* ct = d->FindComponent<EcTransform>();
+		glm::mat4 transform = ct->Transform;
+		transform[3] += glm::vec4(motion * timeOfImpact, 0.f);
+
+		ct->SetWorldTransform(transform);
+		crb->RecomputeAabb();
+
+		// `moveDynamics` carries on for the rest of the step, with whatever velocity it has after the impact
+		crb->RemainingStep = 1.f - timeOfImpact;
+		bool otherMoves = hitBody->PhysicsDynamics;
+		if (otherMoves && hitBody->Sleeping)
+			hitBody->Wake();
+
+		glm::vec3 otherVelocity = otherMoves ? hitBody->LinearVelocity : glm::vec3(0.f);
+		float approach = glm::dot(crb->LinearVelocity - otherVelocity, hitNormal);
+
+		if (approach >= 0.f)
+			continue;
 
-			arb->RecomputeAabb();
-		}*/
-		assert(arb->PhysicsDynamics); // `A` should always be the dynamic one, unless it's D v D where both are dynamic
+		float restitution = approach < -RESTITUTION_THRESHOLD ? std::max(crb->Restitution, hitBody->Restitution) : 0.f;
+		float inverseMass = 1.f / crb->Mass;
+		float otherInverseMass = otherMoves ? 1.f / hitBody->Mass : 0.f;
+		float impulse = -(1.f + restitution) * approach / (inverseMass + otherInverseMass);
+
+		crb->LinearVelocity += hitNormal * impulse * inverseMass;
+		hitBody->LinearVelocity -= hitNormal * impulse * otherInverseMass;
 	}
 }
 
@@ -292,7 +834,27 @@ static void step(Physics::World& World, float DeltaTime, Physics* phys)
 
 	resolveCollisions(World, DeltaTime, phys);
 
+	sweepContinuous(World, DeltaTime);
+
 	moveDynamics(World, DeltaTime);
+
+	// anything attached to the bodies which moved
+	EcTransform::s_FlushDirty();
+}
+
+static void substep(Physics::World& World, double DeltaTime, Physics* phys)
+{
+	// e.g. a `Timescale` of 0
+	if (DeltaTime <= 0.0)
+		return;
+
+	// split evenly, a sliver of a step left over at the end would make the
+	// contact bias (which is divided by the step) blow up
+	size_t numSubsteps = std::clamp((size_t)std::ceil(DeltaTime / MAX_STEP_LENGTH), (size_t)1, MAX_SUBSTEPS);
+	double stepLength = std::min(DeltaTime / numSubsteps, MAX_STEP_LENGTH);
+
+	for (size_t i = 0; i < numSubsteps; i++)
+		step(World, stepLength, phys);
 }
 
 void Physics::Step(Physics::World& World, double DeltaTime)
@@ -300,27 +862,139 @@ void Physics::Step(Physics::World& World, double DeltaTime)
 	TIME_SCOPE_AS("Physics");
 	ZoneScopedC(tracy::Color::AntiqueWhite);
 
-	static double MaximumDeltaTime = 1.0 / 240.0;
+	substep(World, DeltaTime, this);
+}
 
-	if (DeltaTime <= MaximumDeltaTime)
-		step(World, DeltaTime, this);
-	else
+static void recordTickedBodies(const Physics::World& World, hx::vector<Physics::World::TickedBody, MEMCAT(Physics)>& Bodies)
+{
+	Bodies.clear();
+	Bodies.reserve(World.Dynamics.size());
+
+	for (const ObjectHandle& d : World.Dynamics)
 	{
-		double timeRemaining = DeltaTime;
+		const glm::mat4& transform = d->FindComponent<EcTransform>()->Transform;
+		Bodies.push_back({ .ObjectId = d->ObjectId, .Previous = transform, .Current = transform });
+	}
+}
 
-		static size_t MaxSubsteps = 16;
-		size_t numSubsteps = 0;
+void Physics::AdvanceTicks(Physics::World& World, double DeltaTime)
+{
+	assert(!m_TickingWorld);
 
-		while (timeRemaining > MaximumDeltaTime && numSubsteps < MaxSubsteps)
-		{
-			numSubsteps++;
+	World.PendingTicks = 0;
+	World.TickAlpha = 1.f;
 
-			double substep = MaximumDeltaTime;
-			timeRemaining -= substep;
+	if (FixedTickRate <= 0.0 || !Simulating || SimulatingForcePaused)
+		return;
 
-			step(World, substep, this);
-		}
+	double tickLength = 1.0 / FixedTickRate;
+	World.TickAccumulator += DeltaTime * Timescale;
+
+	// this frame's ticks haven't happened yet, so what's drawn lags a tick behind.
+	// Clamped, as we can't draw anything past the last tick
+	World.TickAlpha = (float)std::clamp(World.TickAccumulator / tickLength, 0.0, 1.0);
 
-		step(World, std::clamp(timeRemaining, 0.0, MaximumDeltaTime), this);
+	uint32_t numTicks = (uint32_t)(World.TickAccumulator / tickLength);
+	World.TickAccumulator -= numTicks * tickLength;
+
+	if (numTicks > MAX_TICKS_PER_FRAME)
+	{
+		numTicks = MAX_TICKS_PER_FRAME;
+		World.TickAccumulator = 0.0;
 	}
+
+	World.PendingTicks = numTicks;
+}
+
+void Physics::DispatchTicks(Physics::World& World)
+{
+	ZoneScopedC(tracy::Color::AntiqueWhite);
+	assert(!m_TickingWorld);
+
+	if (World.PendingTicks == 0)
+		return;
+
+	if (World.Dynamics.empty())
+	{
+		World.TickStates[World.FrontTickState].clear();
+		World.PendingTicks = 0;
+		return;
+	}
+
+	m_TickingWorld = &World;
+
+	double tickLength = 1.0 / FixedTickRate;
+	uint32_t numTicks = World.PendingTicks;
+	World.PendingTicks = 0;
+
+	ThreadManager::Get()->Dispatch(
+		"PhysicsTicks",
+		[this, &World, tickLength, numTicks]()
+		{
+			ZoneScopedC(tracy::Color::AntiqueWhite);
+
+			hx::vector<World::TickedBody, MEMCAT(Physics)>& back = World.TickStates[1 - World.FrontTickState];
+
+			for (uint32_t i = 0; i < numTicks; i++)
+			{
+				if (i == numTicks - 1)
+					recordTickedBodies(World, back);
+
+				substep(World, tickLength, this);
+			}
+
+			for (World::TickedBody& body : back)
+				body.Current = GameObjectManager::Get()->FindById(body.ObjectId)->FindComponent<EcTransform>()->Transform;
+
+			std::sort(back.begin(), back.end(), [](const World::TickedBody& A, const World::TickedBody& B)
+			{
+				return A.ObjectId < B.ObjectId;
+			});
+		},
+		true,
+		ThreadManager::TaskPriority::High,
+		&m_TickTasks
+	);
+}
+
+void Physics::FinishTicks()
+{
+	if (!m_TickingWorld)
+		return;
+
+	TIME_SCOPE_AS("PhysicsTickWait");
+	ZoneScopedC(tracy::Color::AntiqueWhite);
+
+	ThreadManager::Get()->Wait(m_TickTasks);
+
+	m_TickingWorld->FrontTickState ^= 1;
+	m_TickingWorld = nullptr;
+}
+
+bool Physics::GetInterpolatedTransform(const Physics::World& World, uint32_t ObjectId, const glm::mat4& Actual, glm::mat4* Transform)
+{
+	const hx::vector<World::TickedBody, MEMCAT(Physics)>& front = World.TickStates[World.FrontTickState];
+
+	auto it = std::lower_bound(front.begin(), front.end(), ObjectId, [](const World::TickedBody& Body, uint32_t Id)
+	{
+		return Body.ObjectId < Id;
+	});
+
+	// if it was moved since, e.g. by a Script, that's where it should be
+	if (it == front.end() || it->ObjectId != ObjectId || it->Current != Actual)
+		return false;
+
+	glm::vec3 prevTrans, curTrans, prevScale, curScale;
+	glm::quat prevRot, curRot;
+
+	if (!DecomposeTRS(it->Previous, &prevTrans, &prevRot, &prevScale) || !DecomposeTRS(it->Current, &curTrans, &curRot, &curScale))
+		return false;
+
+	float alpha = World.TickAlpha;
+
+	*Transform = glm::translate(glm::mat4(1.f), glm::mix(prevTrans, curTrans, alpha))
+		* glm::mat4_cast(glm::slerp(prevRot, curRot, alpha))
+		* glm::scale(glm::mat4(1.f), glm::mix(prevScale, curScale, alpha));
+
+	return true;
 }
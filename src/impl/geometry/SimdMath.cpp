@@ -0,0 +1,276 @@
+// SimdMath.cpp, 17/10/2026
+#include <cstring>
+#include <cassert>
+#include <cmath>
+#include <float.h>
+#include <glm/common.hpp>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PHX_SIMDMATH_SSE
+#include <emmintrin.h>
+#endif
+
+#include "geometry/SimdMath.hpp"
+
+#ifdef PHX_SIMDMATH_SSE
+
+// glm matrices are column-major and not necessarily 16-byte aligned
+static inline void loadColumns(const glm::mat4& M, __m128 Columns[4])
+{
+    const float* m = &M[0][0];
+
+    Columns[0] = _mm_loadu_ps(m);
+    Columns[1] = _mm_loadu_ps(m + 4);
+    Columns[2] = _mm_loadu_ps(m + 8);
+    Columns[3] = _mm_loadu_ps(m + 12);
+}
+
+// `Columns * (x, y, z, w)`
+static inline __m128 linearCombination(const __m128 Columns[4], __m128 V)
+{
+    __m128 r = _mm_mul_ps(Columns[0], _mm_shuffle_ps(V, V, _MM_SHUFFLE(0, 0, 0, 0)));
+    r = _mm_add_ps(r, _mm_mul_ps(Columns[1], _mm_shuffle_ps(V, V, _MM_SHUFFLE(1, 1, 1, 1))));
+    r = _mm_add_ps(r, _mm_mul_ps(Columns[2], _mm_shuffle_ps(V, V, _MM_SHUFFLE(2, 2, 2, 2))));
+    r = _mm_add_ps(r, _mm_mul_ps(Columns[3], _mm_shuffle_ps(V, V, _MM_SHUFFLE(3, 3, 3, 3))));
+
+    return r;
+}
+
+static inline void storeVec3(glm::vec3& Out, __m128 V)
+{
+    alignas(16) float f[4];
+    _mm_store_ps(f, V);
+    // not `_mm_storeu_ps`, that would write a 4th float past the end
+    memcpy(&Out, f, sizeof(glm::vec3));
+}
+
+void SimdMath::MultiplyMat4(const glm::mat4* A, const glm::mat4* B, glm::mat4* Out, size_t Count)
+{
+    for (size_t i = 0; i < Count; i++)
+    {
+        __m128 a[4];
+        __m128 b[4];
+        loadColumns(A[i], a);
+        loadColumns(B[i], b);
+
+        // column `c` of the result is `A * B[c]`
+        float* out = &Out[i][0][0];
+
+        for (int c = 0; c < 4; c++)
+            _mm_storeu_ps(out + c * 4, linearCombination(a, b[c]));
+    }
+}
+
+void SimdMath::TransformPoints(const glm::mat4& Matrix, const glm::vec3* Points, glm::vec3* Out, size_t Count)
+{
+    __m128 m[4];
+    loadColumns(Matrix, m);
+
+    for (size_t i = 0; i < Count; i++)
+    {
+        const glm::vec3& p = Points[i];
+        __m128 r = _mm_add_ps(m[3], _mm_mul_ps(m[0], _mm_set1_ps(p.x)));
+        r = _mm_add_ps(r, _mm_mul_ps(m[1], _mm_set1_ps(p.y)));
+        r = _mm_add_ps(r, _mm_mul_ps(m[2], _mm_set1_ps(p.z)));
+
+        storeVec3(Out[i], r);
+    }
+}
+
+void SimdMath::AabbsFromObbs(const glm::mat4* Matrices, glm::vec3* OutCenters, glm::vec3* OutHalfSizes, size_t Count)
+{
+    const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+
+    for (size_t i = 0; i < Count; i++)
+    {
+        __m128 m[4];
+        loadColumns(Matrices[i], m);
+
+        // the corners are `M[3] +- M[0] +- M[1] +- M[2]`, so the furthest any of them
+        // gets from the center along each axis is the sum of the absolute basis vectors
+        __m128 half = _mm_and_ps(m[0], absMask);
+        half = _mm_add_ps(half, _mm_and_ps(m[1], absMask));
+        half = _mm_add_ps(half, _mm_and_ps(m[2], absMask));
+
+        storeVec3(OutCenters[i], m[3]);
+        storeVec3(OutHalfSizes[i], half);
+    }
+}
+
+size_t SimdMath::MaxDot(const float* X, const float* Y, const float* Z, size_t Count, const glm::vec3& Direction)
+{
+    assert(Count > 0);
+
+    const __m128 dx = _mm_set1_ps(Direction.x);
+    const __m128 dy = _mm_set1_ps(Direction.y);
+    const __m128 dz = _mm_set1_ps(Direction.z);
+    const __m128i four = _mm_set1_epi32(4);
+
+    // each lane keeps the best of every 4th point
+    __m128 best = _mm_set1_ps(-FLT_MAX);
+    __m128i bestIndex = _mm_setzero_si128();
+    __m128i index = _mm_setr_epi32(0, 1, 2, 3);
+
+    size_t i = 0;
+
+    for (; i + 4 <= Count; i += 4)
+    {
+        __m128 d = _mm_mul_ps(_mm_loadu_ps(X + i), dx);
+        d = _mm_add_ps(d, _mm_mul_ps(_mm_loadu_ps(Y + i), dy));
+        d = _mm_add_ps(d, _mm_mul_ps(_mm_loadu_ps(Z + i), dz));
+
+        // strictly greater, so a lane holds onto the first of a tie
+        __m128 greater = _mm_cmpgt_ps(d, best);
+        __m128i greaterMask = _mm_castps_si128(greater);
+
+        best = _mm_or_ps(_mm_and_ps(greater, d), _mm_andnot_ps(greater, best));
+        bestIndex = _mm_or_si128(_mm_and_si128(greaterMask, index), _mm_andnot_si128(greaterMask, bestIndex));
+        index = _mm_add_epi32(index, four);
+    }
+
+    alignas(16) float lanes[4];
+    alignas(16) int32_t laneIndices[4];
+    _mm_store_ps(lanes, best);
+    _mm_store_si128((__m128i*)laneIndices, bestIndex);
+
+    float bestDot = -FLT_MAX;
+    size_t result = 0;
+
+    for (int l = 0; l < 4; l++)
+        if (lanes[l] > bestDot || (lanes[l] == bestDot && (size_t)laneIndices[l] < result))
+        {
+            bestDot = lanes[l];
+            result = (size_t)laneIndices[l];
+        }
+
+    for (; i < Count; i++)
+    {
+        float d = X[i] * Direction.x + Y[i] * Direction.y + Z[i] * Direction.z;
+
+        if (d > bestDot)
+        {
+            bestDot = d;
+            result = i;
+        }
+    }
+
+    return result;
+}
+
+int SimdMath::RayPacketAabb(const RayPacket& Packet, const glm::vec3& Min, const glm::vec3& Max)
+{
+    const __m128 ox = _mm_load_ps(Packet.OriginX);
+    const __m128 oy = _mm_load_ps(Packet.OriginY);
+    const __m128 oz = _mm_load_ps(Packet.OriginZ);
+
+    __m128 x1 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(Min.x), ox), _mm_load_ps(Packet.InvVectorX));
+    __m128 x2 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(Max.x), ox), _mm_load_ps(Packet.InvVectorX));
+    __m128 y1 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(Min.y), oy), _mm_load_ps(Packet.InvVectorY));
+    __m128 y2 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(Max.y), oy), _mm_load_ps(Packet.InvVectorY));
+    __m128 z1 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(Min.z), oz), _mm_load_ps(Packet.InvVectorZ));
+    __m128 z2 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(Max.z), oz), _mm_load_ps(Packet.InvVectorZ));
+
+    __m128 enter = _mm_max_ps(_mm_min_ps(x1, x2), _mm_min_ps(y1, y2));
+    enter = _mm_max_ps(enter, _mm_max_ps(_mm_min_ps(z1, z2), _mm_setzero_ps()));
+
+    __m128 exit = _mm_min_ps(_mm_max_ps(x1, x2), _mm_max_ps(y1, y2));
+    exit = _mm_min_ps(exit, _mm_min_ps(_mm_max_ps(z1, z2), _mm_load_ps(Packet.MaxT)));
+
+    return _mm_movemask_ps(_mm_cmple_ps(enter, exit));
+}
+
+#else
+
+void SimdMath::MultiplyMat4(const glm::mat4* A, const glm::mat4* B, glm::mat4* Out, size_t Count)
+{
+    for (size_t i = 0; i < Count; i++)
+        Out[i] = A[i] * B[i];
+}
+
+void SimdMath::TransformPoints(const glm::mat4& Matrix, const glm::vec3* Points, glm::vec3* Out, size_t Count)
+{
+    for (size_t i = 0; i < Count; i++)
+        Out[i] = glm::vec3(Matrix * glm::vec4(Points[i], 1.f));
+}
+
+void SimdMath::AabbsFromObbs(const glm::mat4* Matrices, glm::vec3* OutCenters, glm::vec3* OutHalfSizes, size_t Count)
+{
+    for (size_t i = 0; i < Count; i++)
+    {
+        const glm::mat4& m = Matrices[i];
+
+        OutCenters[i] = glm::vec3(m[3]);
+        OutHalfSizes[i] = glm::abs(glm::vec3(m[0])) + glm::abs(glm::vec3(m[1])) + glm::abs(glm::vec3(m[2]));
+    }
+}
+
+size_t SimdMath::MaxDot(const float* X, const float* Y, const float* Z, size_t Count, const glm::vec3& Direction)
+{
+    assert(Count > 0);
+
+    float bestDot = -FLT_MAX;
+    size_t result = 0;
+
+    for (size_t i = 0; i < Count; i++)
+    {
+        float d = X[i] * Direction.x + Y[i] * Direction.y + Z[i] * Direction.z;
+
+        if (d > bestDot)
+        {
+            bestDot = d;
+            result = i;
+        }
+    }
+
+    return result;
+}
+
+int SimdMath::RayPacketAabb(const RayPacket& Packet, const glm::vec3& Min, const glm::vec3& Max)
+{
+    int mask = 0;
+
+    for (int l = 0; l < RayPacket::Width; l++)
+    {
+        glm::vec3 origin = glm::vec3(Packet.OriginX[l], Packet.OriginY[l], Packet.OriginZ[l]);
+        glm::vec3 invVector = glm::vec3(Packet.InvVectorX[l], Packet.InvVectorY[l], Packet.InvVectorZ[l]);
+
+        glm::vec3 t1 = (Min - origin) * invVector;
+        glm::vec3 t2 = (Max - origin) * invVector;
+        glm::vec3 tNear = glm::min(t1, t2);
+        glm::vec3 tFar = glm::max(t1, t2);
+
+        float enter = glm::max(glm::max(tNear.x, tNear.y), glm::max(tNear.z, 0.f));
+        float exit = glm::min(glm::min(tFar.x, tFar.y), glm::min(tFar.z, Packet.MaxT[l]));
+
+        if (!(enter > exit))
+            mask |= 1 << l;
+    }
+
+    return mask;
+}
+
+#endif
+
+void SimdMath::RayPacket::SetLane(int Lane, const glm::vec3& Origin, const glm::vec3& Vector, float LaneMaxT)
+{
+    assert(Lane >= 0 && Lane < Width);
+
+    OriginX[Lane] = Origin.x;
+    OriginY[Lane] = Origin.y;
+    OriginZ[Lane] = Origin.z;
+    // same as `AabbTree::Raycast`, `0 * inf = NaN` would break the comparisons
+    InvVectorX[Lane] = Vector.x != 0.f ? 1.f / Vector.x : 1e30f;
+    InvVectorY[Lane] = Vector.y != 0.f ? 1.f / Vector.y : 1e30f;
+    InvVectorZ[Lane] = Vector.z != 0.f ? 1.f / Vector.z : 1e30f;
+    MaxT[Lane] = LaneMaxT;
+}
+
+void SimdMath::RayPacket::DisableLane(int Lane)
+{
+    assert(Lane >= 0 && Lane < Width);
+
+    OriginX[Lane] = OriginY[Lane] = OriginZ[Lane] = 0.f;
+    InvVectorX[Lane] = InvVectorY[Lane] = InvVectorZ[Lane] = 1.f;
+    // `exit` can't go below 0, which `enter` always is at least
+    MaxT[Lane] = -1.f;
+}
@@ -0,0 +1,257 @@
+// SpatialGrid.cpp, 17/10/2026
+#include <tracy/Tracy.hpp>
+#include <glm/common.hpp>
+#include <cassert>
+
+#include "geometry/SpatialGrid.hpp"
+
+// table is grown past this load factor
+static const size_t MAX_LOAD_NUMERATOR = 1;
+static const size_t MAX_LOAD_DENOMINATOR = 2;
+
+glm::ivec3 SpatialGrid::CellOf(const glm::vec3& Position)
+{
+    // leaves room for the `+ 1`s when iterating up to one
+    return glm::ivec3(glm::clamp(glm::round(Position / SPATIAL_HASH_GRID_SIZE), -1e9f, 1e9f));
+}
+
+// the old `hash(x) ^ hash(y) ^ hash(z)` sent every permutation and mirror of a cell to the same
+// bucket, e.g. (1, 0, -1) and (-1, 0, 1). Each axis gets its own odd multiplier instead, and the
+// result is put through MurmurHash3's finalizer so the low bits (which pick the slot) are well mixed
+uint64_t SpatialGrid::s_Hash(const glm::ivec3& Cell)
+{
+    uint64_t h = (uint64_t)(uint32_t)Cell.x * 0x9E3779B97F4A7C15ull;
+    h ^= (uint64_t)(uint32_t)Cell.y * 0xC2B2AE3D27D4EB4Full;
+    h ^= (uint64_t)(uint32_t)Cell.z * 0x165667B19E3779F9ull;
+
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCDull;
+    h ^= h >> 33;
+    h *= 0xC4CEB9FE1A85EC53ull;
+    h ^= h >> 33;
+
+    return h;
+}
+
+uint32_t SpatialGrid::m_FindCell(const glm::ivec3& Key) const
+{
+    if (m_Table.empty())
+        return EmptySlot;
+
+    size_t mask = m_Table.size() - 1;
+
+    for (size_t slot = s_Hash(Key) & mask; ; slot = (slot + 1) & mask)
+    {
+        const TableEntry& entry = m_Table[slot];
+
+        if (entry.Cell == EmptySlot)
+            return EmptySlot;
+        if (entry.Key == Key)
+            return entry.Cell;
+    }
+}
+
+uint32_t SpatialGrid::m_FindOrAddCell(const glm::ivec3& Key)
+{
+    if ((m_NumCells + 1) * MAX_LOAD_DENOMINATOR > m_Table.size() * MAX_LOAD_NUMERATOR)
+        m_Rehash(m_Table.empty() ? 64 : m_Table.size() * 2);
+
+    size_t mask = m_Table.size() - 1;
+    size_t slot = s_Hash(Key) & mask;
+
+    for (; m_Table[slot].Cell != EmptySlot; slot = (slot + 1) & mask)
+        if (m_Table[slot].Key == Key)
+            return m_Table[slot].Cell;
+
+    uint32_t cell = 0;
+
+    if (!m_FreeCells.empty())
+    {
+        cell = m_FreeCells.back();
+        m_FreeCells.pop_back();
+    }
+    else
+    {
+        cell = static_cast<uint32_t>(m_Cells.size());
+        m_Cells.emplace_back();
+    }
+
+    m_Cells[cell].Key = Key;
+    m_Table[slot] = TableEntry{ .Key = Key, .Cell = cell };
+    m_NumCells++;
+
+    return cell;
+}
+
+void SpatialGrid::m_Rehash(size_t NewCapacity)
+{
+    ZoneScoped;
+
+    hx::vector<TableEntry, MEMCAT(Physics)> old = std::move(m_Table);
+    m_Table.clear();
+    m_Table.resize(NewCapacity);
+
+    size_t mask = NewCapacity - 1;
+
+    for (const TableEntry& entry : old)
+    {
+        if (entry.Cell == EmptySlot)
+            continue;
+
+        size_t slot = s_Hash(entry.Key) & mask;
+        while (m_Table[slot].Cell != EmptySlot)
+            slot = (slot + 1) & mask;
+
+        m_Table[slot] = entry;
+    }
+}
+
+// backward-shift deletion, so that lookups never need tombstones
+void SpatialGrid::m_EraseTableSlot(size_t Slot)
+{
+    size_t mask = m_Table.size() - 1;
+    size_t hole = Slot;
+
+    for (size_t next = (hole + 1) & mask; m_Table[next].Cell != EmptySlot; next = (next + 1) & mask)
+    {
+        size_t ideal = s_Hash(m_Table[next].Key) & mask;
+
+        // an entry can only move back into the hole if that doesn't put it before its ideal slot
+        bool idealInRange = hole <= next ? (hole < ideal && ideal <= next) : (hole < ideal || ideal <= next);
+        if (idealInRange)
+            continue;
+
+        m_Table[hole] = m_Table[next];
+        hole = next;
+    }
+
+    m_Table[hole].Cell = EmptySlot;
+    m_NumCells--;
+}
+
+void SpatialGrid::m_RemoveFromCell(uint32_t Cell, uint32_t Slot)
+{
+    CellData& cell = m_Cells[Cell];
+    assert(Slot < cell.Size);
+
+    uint32_t last = cell.Size - 1;
+
+    // swap the last one into the gap, and tell its proxy where it went
+    if (Slot != last)
+    {
+        const Item& moved = cell.At(last);
+        cell.At(Slot) = moved;
+        m_Proxies[moved.Proxy].Cells[moved.Ref].Slot = Slot;
+    }
+
+    if (last >= InlineCapacity)
+        cell.Overflow.pop_back();
+
+    cell.Size = last;
+
+    if (cell.Size > 0)
+        return;
+
+    // empty, take it out of the table so that the grid doesn't hold onto every
+    // cell anything has ever passed through
+    size_t mask = m_Table.size() - 1;
+    size_t slot = s_Hash(cell.Key) & mask;
+
+    while (m_Table[slot].Cell != Cell)
+        slot = (slot + 1) & mask;
+
+    m_EraseTableSlot(slot);
+
+    cell.Overflow.clear();
+    m_FreeCells.push_back(Cell);
+}
+
+uint32_t SpatialGrid::CreateProxy(uint32_t ObjectId)
+{
+    uint32_t proxy = 0;
+
+    if (!m_FreeProxies.empty())
+    {
+        proxy = m_FreeProxies.back();
+        m_FreeProxies.pop_back();
+    }
+    else
+    {
+        proxy = static_cast<uint32_t>(m_Proxies.size());
+        m_Proxies.emplace_back();
+    }
+
+    m_Proxies[proxy].ObjectId = ObjectId;
+    return proxy;
+}
+
+void SpatialGrid::DestroyProxy(uint32_t Proxy)
+{
+    assert(Proxy < m_Proxies.size() && m_Proxies[Proxy].ObjectId != UINT32_MAX);
+
+    ClearCells(Proxy);
+    m_Proxies[Proxy].ObjectId = UINT32_MAX;
+    m_FreeProxies.push_back(Proxy);
+}
+
+bool SpatialGrid::OwnsProxy(uint32_t Proxy, uint32_t ObjectId) const
+{
+    return Proxy < m_Proxies.size() && m_Proxies[Proxy].ObjectId == ObjectId;
+}
+
+void SpatialGrid::ClearCells(uint32_t Proxy)
+{
+    ProxyData& proxy = m_Proxies[Proxy];
+
+    for (const CellRef& ref : proxy.Cells)
+        m_RemoveFromCell(ref.Cell, ref.Slot);
+
+    proxy.Cells.clear();
+}
+
+void SpatialGrid::SetCells(uint32_t Proxy, const glm::ivec3& CellMin, const glm::ivec3& CellMax)
+{
+    ZoneScoped;
+
+    ClearCells(Proxy);
+
+    ProxyData& proxy = m_Proxies[Proxy];
+
+    for (int x = CellMin.x; x <= CellMax.x; x++)
+        for (int y = CellMin.y; y <= CellMax.y; y++)
+            for (int z = CellMin.z; z <= CellMax.z; z++)
+            {
+                glm::ivec3 key = { x, y, z };
+                uint32_t cellIndex = m_FindOrAddCell(key);
+                CellData& cell = m_Cells[cellIndex];
+
+                Item item = {
+                    .ObjectId = proxy.ObjectId,
+                    .Proxy = Proxy,
+                    .Ref = static_cast<uint32_t>(proxy.Cells.size())
+                };
+
+                if (cell.Size < InlineCapacity)
+                    cell.Inline[cell.Size] = item;
+                else
+                    cell.Overflow.push_back(item);
+
+                proxy.Cells.push_back(CellRef{ .Cell = cellIndex, .Slot = cell.Size });
+                cell.Size++;
+            }
+}
+
+void SpatialGrid::Clear()
+{
+    m_Table = {};
+    m_NumCells = 0;
+    m_Cells = {};
+    m_FreeCells = {};
+    m_Proxies = {};
+    m_FreeProxies = {};
+}
+
+size_t SpatialGrid::GetNumCells() const
+{
+    return m_NumCells;
+}
@@ -0,0 +1,351 @@
+// TriangleBvh.cpp, 17/10/2026
+#include <tracy/Tracy.hpp>
+#include <glm/geometric.hpp>
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+#include "geometry/TriangleBvh.hpp"
+#include "asset/Mesh.hpp"
+
+// each axis of a node is split into this many buckets by triangle centroid, and the
+// splits between buckets are what the surface area heuristic picks from
+static const int SAH_BINS = 12;
+// cost of visiting an inner node, relative to testing a triangle
+static const float SAH_TRAVERSAL_COST = 1.f;
+// triangles with less area than this fraction of the mesh's size squared are left out
+static const float DEGENERATE_TOLERANCE = 1e-12f;
+
+static float surfaceArea(const glm::vec3& Min, const glm::vec3& Max)
+{
+    glm::vec3 d = glm::max(Max - Min, glm::vec3(0.f));
+    return 2.f * (d.x * d.y + d.y * d.z + d.z * d.x);
+}
+
+// where the segment enters the box, or `FLT_MAX` if it doesn't
+static float enterAabb(const glm::vec3& Origin, const glm::vec3& InvVector, const glm::vec3& Min, const glm::vec3& Max, float MaxT)
+{
+    glm::vec3 t1 = (Min - Origin) * InvVector;
+    glm::vec3 t2 = (Max - Origin) * InvVector;
+    glm::vec3 tNear = glm::min(t1, t2);
+    glm::vec3 tFar = glm::max(t1, t2);
+
+    float enter = glm::max(glm::max(tNear.x, tNear.y), glm::max(tNear.z, 0.f));
+    float exit = glm::min(glm::min(tFar.x, tFar.y), glm::min(tFar.z, MaxT));
+
+    return enter > exit ? FLT_MAX : enter;
+}
+
+TriangleBvh TriangleBvh::s_FromMesh(const Mesh& mesh)
+{
+    ZoneScoped;
+
+    TriangleBvh bvh;
+
+    if (mesh.Indices.size() < 3)
+        return bvh;
+
+    glm::vec3 meshMin = glm::vec3(FLT_MAX);
+    glm::vec3 meshMax = glm::vec3(-FLT_MAX);
+
+    for (uint32_t index : mesh.Indices)
+    {
+        meshMin = glm::min(meshMin, mesh.Vertices[index].Position);
+        meshMax = glm::max(meshMax, mesh.Vertices[index].Position);
+    }
+
+    float size = std::max(std::max(meshMax.x - meshMin.x, meshMax.y - meshMin.y), meshMax.z - meshMin.z);
+    float minArea = size * size * DEGENERATE_TOLERANCE;
+
+    struct BuildTriangle
+    {
+        glm::vec3 Min;
+        glm::vec3 Max;
+        glm::vec3 Centroid;
+        uint32_t First; // index into `mesh.Indices`
+    };
+
+    std::vector<BuildTriangle> tris;
+    tris.reserve(mesh.Indices.size() / 3);
+
+    for (size_t i = 0; i + 2 < mesh.Indices.size(); i += 3)
+    {
+        const glm::vec3& a = mesh.Vertices[mesh.Indices[i]].Position;
+        const glm::vec3& b = mesh.Vertices[mesh.Indices[i + 1]].Position;
+        const glm::vec3& c = mesh.Vertices[mesh.Indices[i + 2]].Position;
+
+        if (glm::length(glm::cross(b - a, c - a)) <= minArea)
+            continue;
+
+        tris.push_back({
+            .Min = glm::min(a, glm::min(b, c)),
+            .Max = glm::max(a, glm::max(b, c)),
+            .Centroid = (a + b + c) / 3.f,
+            .First = (uint32_t)i
+        });
+    }
+
+    if (tris.empty())
+        return bvh;
+
+    bvh.m_Nodes.reserve(tris.size() * 2 / MaxLeafTriangles + 1);
+
+    struct BuildTask
+    {
+        uint32_t Parent; // the node this is the second child of, `UINT32_MAX` otherwise
+        uint32_t Begin;
+        uint32_t End;
+        uint32_t Depth;
+    };
+
+    // first children are built straight after their parents, so that they
+    // end up next to them, by popping them off before the second ones
+    std::vector<BuildTask> tasks = { { UINT32_MAX, 0, (uint32_t)tris.size(), 0 } };
+
+    while (!tasks.empty())
+    {
+        BuildTask task = tasks.back();
+        tasks.pop_back();
+
+        uint32_t nodeIndex = (uint32_t)bvh.m_Nodes.size();
+        bvh.m_Nodes.emplace_back();
+
+        if (task.Parent != UINT32_MAX)
+            bvh.m_Nodes[task.Parent].Start = nodeIndex;
+
+        glm::vec3 min = glm::vec3(FLT_MAX);
+        glm::vec3 max = glm::vec3(-FLT_MAX);
+        glm::vec3 centroidMin = glm::vec3(FLT_MAX);
+        glm::vec3 centroidMax = glm::vec3(-FLT_MAX);
+
+        for (uint32_t i = task.Begin; i < task.End; i++)
+        {
+            min = glm::min(min, tris[i].Min);
+            max = glm::max(max, tris[i].Max);
+            centroidMin = glm::min(centroidMin, tris[i].Centroid);
+            centroidMax = glm::max(centroidMax, tris[i].Centroid);
+        }
+
+        bvh.m_Nodes[nodeIndex].Min = min;
+        bvh.m_Nodes[nodeIndex].Max = max;
+
+        uint32_t count = task.End - task.Begin;
+        uint32_t mid = task.Begin;
+
+        if (count > MaxLeafTriangles && task.Depth < MaxSahDepth)
+        {
+            int bestAxis = -1;
+            int bestSplit = 0;
+            float bestCost = (float)count;
+            float parentArea = surfaceArea(min, max);
+
+            for (int axis = 0; axis < 3; axis++)
+            {
+                float extent = centroidMax[axis] - centroidMin[axis];
+
+                if (extent <= 0.f)
+                    continue;
+
+                struct Bin
+                {
+                    glm::vec3 Min = glm::vec3(FLT_MAX);
+                    glm::vec3 Max = glm::vec3(-FLT_MAX);
+                    uint32_t Count = 0;
+                } bins[SAH_BINS];
+
+                float scale = SAH_BINS / extent;
+
+                for (uint32_t i = task.Begin; i < task.End; i++)
+                {
+                    int b = std::min((int)((tris[i].Centroid[axis] - centroidMin[axis]) * scale), SAH_BINS - 1);
+                    bins[b].Min = glm::min(bins[b].Min, tris[i].Min);
+                    bins[b].Max = glm::max(bins[b].Max, tris[i].Max);
+                    bins[b].Count++;
+                }
+
+                // sweep from the right first, then from the left, costing each split on the way
+                float rightCost[SAH_BINS] = {};
+                Bin right;
+
+                for (int b = SAH_BINS - 1; b > 0; b--)
+                {
+                    right.Min = glm::min(right.Min, bins[b].Min);
+                    right.Max = glm::max(right.Max, bins[b].Max);
+                    right.Count += bins[b].Count;
+                    rightCost[b] = right.Count > 0 ? surfaceArea(right.Min, right.Max) * right.Count : 0.f;
+                }
+
+                Bin left;
+
+                for (int b = 0; b < SAH_BINS - 1; b++)
+                {
+                    left.Min = glm::min(left.Min, bins[b].Min);
+                    left.Max = glm::max(left.Max, bins[b].Max);
+                    left.Count += bins[b].Count;
+
+                    if (left.Count == 0 || left.Count == count)
+                        continue;
+
+                    float cost = SAH_TRAVERSAL_COST + (surfaceArea(left.Min, left.Max) * left.Count + rightCost[b + 1]) / parentArea;
+
+                    if (cost < bestCost)
+                    {
+                        bestCost = cost;
+                        bestAxis = axis;
+                        bestSplit = b;
+                    }
+                }
+            }
+
+            if (bestAxis >= 0)
+            {
+                float scale = SAH_BINS / (centroidMax[bestAxis] - centroidMin[bestAxis]);
+
+                auto split = std::partition(tris.begin() + task.Begin, tris.begin() + task.End, [&](const BuildTriangle& T)
+                {
+                    return std::min((int)((T.Centroid[bestAxis] - centroidMin[bestAxis]) * scale), SAH_BINS - 1) <= bestSplit;
+                });
+                mid = (uint32_t)(split - tris.begin());
+            }
+        }
+        else if (count > MaxLeafTriangles)
+        {
+            // too deep for the heuristic to be trusted to terminate, halve it along its longest axis
+            glm::vec3 extent = centroidMax - centroidMin;
+            int axis = extent.x > extent.y ? (extent.x > extent.z ? 0 : 2) : (extent.y > extent.z ? 1 : 2);
+            mid = task.Begin + count / 2;
+
+            std::nth_element(tris.begin() + task.Begin, tris.begin() + mid, tris.begin() + task.End, [axis](const BuildTriangle& A, const BuildTriangle& B)
+            {
+                return A.Centroid[axis] < B.Centroid[axis];
+            });
+        }
+
+        if (mid == task.Begin || mid == task.End)
+        {
+            // a leaf, its triangles go on the end of `m_Corners` in order
+            bvh.m_Nodes[nodeIndex].Start = (uint32_t)bvh.m_Corners.size() / 3;
+            bvh.m_Nodes[nodeIndex].Count = count;
+
+            for (uint32_t i = task.Begin; i < task.End; i++)
+                for (int c = 0; c < 3; c++)
+                    bvh.m_Corners.push_back(mesh.Vertices[mesh.Indices[tris[i].First + c]].Position);
+        }
+        else
+        {
+            tasks.push_back({ nodeIndex, mid, task.End, task.Depth + 1 });
+            tasks.push_back({ UINT32_MAX, task.Begin, mid, task.Depth + 1 });
+        }
+    }
+
+    return bvh;
+}
+
+TriangleBvh::RaycastResult TriangleBvh::Raycast(const glm::vec3& Origin, const glm::vec3& Vector) const
+{
+    RaycastResult result;
+
+    if (m_Nodes.empty())
+        return result;
+
+    // not `1 / 0 = inf`, that would make `0 * inf = NaN` when the ray starts on a slab plane
+    const glm::vec3 invVector = glm::vec3(
+        Vector.x != 0.f ? 1.f / Vector.x : 1e30f,
+        Vector.y != 0.f ? 1.f / Vector.y : 1e30f,
+        Vector.z != 0.f ? 1.f / Vector.z : 1e30f
+    );
+
+    float closest = 1.f;
+
+    // nodes with where the ray enters them, the nearer child is always on top
+    struct Entry
+    {
+        uint32_t Node;
+        float Enter;
+    };
+
+    Entry stack[MaxStackDepth];
+    size_t top = 0;
+
+    if (float enter = enterAabb(Origin, invVector, m_Nodes[0].Min, m_Nodes[0].Max, closest); enter != FLT_MAX)
+        stack[top++] = { 0, enter };
+
+    while (top > 0)
+    {
+        Entry entry = stack[--top];
+
+        // something closer was found since it was pushed
+        if (entry.Enter > closest)
+            continue;
+
+        const Node& node = m_Nodes[entry.Node];
+
+        if (node.Count > 0)
+        {
+            // Möller-Trumbore
+            for (uint32_t tri = node.Start; tri < node.Start + node.Count; tri++)
+            {
+                const glm::vec3* corners = GetTriangle(tri);
+                glm::vec3 e1 = corners[1] - corners[0];
+                glm::vec3 e2 = corners[2] - corners[0];
+
+                glm::vec3 p = glm::cross(Vector, e2);
+                float det = glm::dot(e1, p);
+
+                // parallel to the triangle
+                if (std::abs(det) < 1e-12f)
+                    continue;
+
+                float invDet = 1.f / det;
+                glm::vec3 s = Origin - corners[0];
+                float u = glm::dot(s, p) * invDet;
+
+                if (u < 0.f || u > 1.f)
+                    continue;
+
+                glm::vec3 q = glm::cross(s, e1);
+                float v = glm::dot(Vector, q) * invDet;
+
+                if (v < 0.f || u + v > 1.f)
+                    continue;
+
+                float t = glm::dot(e2, q) * invDet;
+
+                if (t > 0.f && t <= closest)
+                {
+                    closest = t;
+
+                    result.Occurred = true;
+                    result.Time = t;
+                    result.Triangle = tri;
+                    result.Normal = glm::cross(e1, e2);
+
+                    if (glm::dot(result.Normal, Vector) > 0.f)
+                        result.Normal = -result.Normal;
+                }
+            }
+        }
+        else
+        {
+            uint32_t first = entry.Node + 1;
+            uint32_t second = node.Start;
+            float firstEnter = enterAabb(Origin, invVector, m_Nodes[first].Min, m_Nodes[first].Max, closest);
+            float secondEnter = enterAabb(Origin, invVector, m_Nodes[second].Min, m_Nodes[second].Max, closest);
+
+            if (firstEnter > secondEnter)
+            {
+                std::swap(first, second);
+                std::swap(firstEnter, secondEnter);
+            }
+
+            assert(top + 2 <= MaxStackDepth);
+
+            if (secondEnter != FLT_MAX)
+                stack[top++] = { second, secondEnter };
+            if (firstEnter != FLT_MAX)
+                stack[top++] = { first, firstEnter };
+        }
+    }
+
+    return result;
+}
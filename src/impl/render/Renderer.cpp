@@ -296,8 +296,17 @@ void Renderer::DrawScene(
 	MeshProvider* meshProvider = MeshProvider::Get();
 	MaterialManager* mtlManager = MaterialManager::Get();
 
+	using InstanceDrawInfoList = hx::frame_vector<InstanceDrawInfo, MEMCAT(Rendering)>;
+	using InstancingListEntry = std::pair<const uint64_t, std::pair<size_t, InstanceDrawInfoList>>;
+
 	// map< clump hash, pair< base RenderItem, vector< array buffer data >>>
-	std::map<uint64_t, std::pair<size_t, std::vector<InstanceDrawInfo>>> instancingList;
+	// all of it lives in the frame arena
+	std::map<
+		uint64_t,
+		std::pair<size_t, InstanceDrawInfoList>,
+		std::less<uint64_t>,
+		Memory::FrameAllocator<InstancingListEntry, MEMCAT(Rendering)>
+	> instancingList;
 	{
 		ZoneScopedNC("Prepare", tracy::Color::AliceBlue);
 
@@ -402,11 +411,11 @@ void Renderer::DrawScene(
 			auto it = instancingList.find(hash);
 			if (it == instancingList.end())
 			{
-				instancingList[hash] = std::pair(renderItemIndex, std::vector<InstanceDrawInfo>());
+				instancingList[hash] = std::pair(renderItemIndex, InstanceDrawInfoList());
 				instancingList[hash].second.reserve(8);
 			}
 
-			std::vector<InstanceDrawInfo>& drawInfos = instancingList[hash].second;
+			InstanceDrawInfoList& drawInfos = instancingList[hash].second;
 
 			// Set buffer data
 			drawInfos.emplace_back(
@@ -430,7 +439,7 @@ void Renderer::DrawScene(
 		const RenderItem& renderData = Scene.RenderList[iter.second.first];
 		const Mesh& mesh = meshProvider->GetMeshResource(renderData.RenderMeshId);
 
-		const std::vector<InstanceDrawInfo>& drawInfos = iter.second.second;
+		const InstanceDrawInfoList& drawInfos = iter.second.second;
 		MeshProvider::GpuMesh& gpuMesh = meshProvider->GetGpuMesh(mesh.GpuId);
 
 		{
@@ -1144,8 +1144,9 @@ void ScriptEngine::L::PushGenericValue(lua_State* L, const Reflection::GenericVa
     }
     case Reflection::ValueType::Buffer:
     {
-        void* p = lua_newbuffer(L, gv.Size);
-        memcpy(p, gv.Val.Str, gv.Size);
+        std::string_view bytes = gv.AsBufferView();
+        void* p = lua_newbuffer(L, bytes.size());
+        memcpy(p, bytes.data(), bytes.size());
 
         break;
     }
@@ -96,7 +96,7 @@ int luhxopen_Enum(lua_State* L)
 
     lua_setfield(L, -2, "FaceCulling");
 
-    lua_createtable(L, 0, 4);
+    lua_createtable(L, 0, 5);
 
     lua_pushinteger(L, 0);
     lua_setfield(L, -2, "Cube");
@@ -110,8 +110,21 @@ int luhxopen_Enum(lua_State* L)
     lua_pushinteger(L, 3);
     lua_setfield(L, -2, "MeshComponent");
 
+    lua_pushinteger(L, 4);
+    lua_setfield(L, -2, "MeshTriangles");
+
     lua_setfield(L, -2, "CollisionType");
 
+    lua_createtable(L, 0, 2);
+
+    lua_pushinteger(L, 0);
+    lua_setfield(L, -2, "Grid");
+
+    lua_pushinteger(L, 1);
+    lua_setfield(L, -2, "Tree");
+
+    lua_setfield(L, -2, "Broadphase");
+
     lua_createtable(L, 0, 4);
 
     lua_pushinteger(L, 0);
@@ -189,6 +189,13 @@ static void cleanupConnection(lua_State* L, EventConnectionData* ec)
     ec->ConnectionId = UINT32_MAX;
 }
 
+// the component the signal is of may have been removed, and its slot given to another
+static void checkSignalAlive(lua_State* L, const EventSignalData* ev)
+{
+    if (!ev->Reflector.Referred())
+        luaL_error(L, "Cannot use the '%s' Event Signal, what it belonged to no longer exists", ev->EventName);
+}
+
 static int sig_namecall(lua_State* L)
 {
     if (strcmp(lua_namecallatom(L, nullptr), "Connect") == 0)
@@ -197,6 +204,7 @@ static int sig_namecall(lua_State* L)
 
         EventSignalData* ev = (EventSignalData*)luaL_checkudatatagged(L, 1, UserdataTag::EventSignal);
         const Reflection::EventDescriptor* rev = ev->Event;
+        checkSignalAlive(L, ev);
         int signalRef = lua_ref(L, 1);
 
         // TRUST ME, ALL THESE L's MAKE SENSE OK
@@ -282,6 +290,7 @@ static int sig_namecall(lua_State* L)
     {
         EventSignalData* ev = (EventSignalData*)luaL_checkudatatagged(L, 1, UserdataTag::EventSignal);
         const Reflection::EventDescriptor* rev = ev->Event;
+        checkSignalAlive(L, ev);
 
         ReflectorRef reflector = ev->Reflector;
         bool* resume = new bool;